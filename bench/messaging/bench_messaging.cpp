@@ -0,0 +1,362 @@
+// bench_messaging.cpp
+// messaging 성능 측정 (한 host, 한 process)
+//   throughput : pub/sub 처리량 - payload 크기 x 구독자 수
+//   latency    : end-to-end latency 분포 - payload 앞 8 byte 에 송신 시각 (steady_clock ns)
+//   rpc        : request / reply RTT 분포와 처리량 - 동시 요청 수
+//   codec      : message_helper serialize / deserialize 비용 (Binary / JSON), MessageView 로 field 하나 읽는 비용
+//
+// usage: bench_messaging [all|throughput|latency|rpc|codec] [inproc|tcp|direct|shm] [scale]
+//   tcp    : loopback (같은 process 라도 inproc 으로 대체하지 않음)
+//   direct : 같은 process 구독자를 publish thread 에서 바로 호출 (LocalTransport::Direct)
+//   shm    : shared memory ring (request / reply 는 tcp)
+//   scale  : 메시지 / 반복 수 배율 (기본 1.0, 빠른 확인은 0.1)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include <fmt/core.h>
+
+#include "zmq_message_bus.hpp"
+#include "message_helper.hpp"
+#include "message_view.hpp"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count();
+}
+
+// ------------------------------------------------------
+// transport 별 publisher / subscriber bus 설정
+// ------------------------------------------------------
+struct Transport {
+    std::string name;
+    int next_port = 5700;
+    int next_id = 0;
+
+    // 시나리오마다 새 endpoint (이전 socket 의 linger / shm 정리와 겹치지 않게)
+    std::string nextEndpoint() {
+        int id = next_id++;
+        if (name == "inproc") return fmt::format("inproc://bench.{}", id);
+        if (name == "shm")    return fmt::format("shm://bench.{}.{}", ::getpid(), id);
+        return fmt::format("tcp://127.0.0.1:{}", next_port++);
+    }
+
+    std::string rpcEndpoint() {
+        if (name == "inproc") return fmt::format("inproc://bench.rpc.{}", next_id++);
+        return fmt::format("tcp://127.0.0.1:{}", next_port++);
+    }
+
+    ZmqMessageBusDescriptor publisher(const std::string& endpoint) const {
+        ZmqMessageBusDescriptor d;
+        d.pub_endpoint  = endpoint;
+        d.sub_endpoints = {};
+        d.local_transport = name == "direct" ? LocalTransport::Direct
+                          : name == "inproc" ? LocalTransport::Inproc
+                          : LocalTransport::None;
+        return d;
+    }
+
+    ZmqMessageBusDescriptor subscriber(const std::string& endpoint, int index) const {
+        ZmqMessageBusDescriptor d;
+        d.pub_endpoint  = fmt::format("inproc://bench.sub.{}.{}", next_id, index);   // 사용하지 않음
+        d.sub_endpoints = {endpoint};
+        d.local_transport = LocalTransport::None;
+        return d;
+    }
+};
+
+struct Percentiles {
+    double p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;       // us
+};
+
+Percentiles percentiles(std::vector<int64_t>& ns) {
+    Percentiles p;
+    if (ns.empty()) return p;
+    std::sort(ns.begin(), ns.end());
+    auto at = [&](double q) { return ns[std::min(ns.size() - 1, static_cast<size_t>(q * ns.size()))] / 1000.0; };
+    p.p50  = at(0.50);
+    p.p90  = at(0.90);
+    p.p99  = at(0.99);
+    p.p999 = at(0.999);
+    p.max  = ns.back() / 1000.0;
+    return p;
+}
+
+// 구독자가 topic filter 를 받을 때까지 (slow joiner) warmup 메시지를 보냄
+bool warmup(ZmqMessageBus& pub, const std::string& topic, const std::vector<std::atomic<size_t>>& counts) {
+    auto deadline = clock_type::now() + std::chrono::seconds(3);
+    while (clock_type::now() < deadline) {
+        pub.publish(topic, std::string(16, '\0'));        // latency 측정에서 송신 시각 0 = warmup
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        if (std::all_of(counts.begin(), counts.end(), [](auto& c) { return c.load() > 0; })) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            return true;
+        }
+    }
+    return false;
+}
+
+// shm ring 은 공간이 없으면 ResourceBusy - 구독자가 따라올 때까지 재시도
+size_t publishRetry(ZmqMessageBus& bus, const std::string& topic, const std::string& payload) {
+    size_t retries = 0;
+    while (!bus.publish(topic, payload)) {
+        retries++;
+        std::this_thread::yield();
+    }
+    return retries;
+}
+
+// ------------------------------------------------------
+// throughput
+// ------------------------------------------------------
+void benchThroughput(Transport& t, double scale) {
+    fmt::print("\n[throughput] transport={}\n", t.name);
+    fmt::print("{:>8} {:>5} {:>12} {:>10} {:>10} {:>9}\n", "size", "subs", "msg/s/sub", "MB/s/sub", "delivered", "retries");
+
+    const std::string topic = "bench.tp";
+    for (size_t size : {64ul, 256ul, 1024ul, 4096ul, 16384ul, 65536ul}) {
+        for (size_t subs : {1ul, 2ul, 4ul}) {
+            size_t count = std::max<size_t>(100, static_cast<size_t>(scale * std::min<size_t>(200000, (256u << 20) / size / subs)));
+            std::string endpoint = t.nextEndpoint();
+
+            auto pd = t.publisher(endpoint);
+            pd.pub_hwm = 0;                 // 처리량 측정 - HWM drop 없이 (메모리는 count 로 제한)
+            ZmqMessageBus pub(pd);
+
+            std::vector<std::atomic<size_t>> counts(subs);
+            std::atomic<int64_t> last_ns{0};
+            std::vector<std::unique_ptr<ZmqMessageBus>> buses;
+            std::vector<std::unique_ptr<MessageSubscription>> handles;
+            for (size_t i = 0; i < subs; ++i) {
+                auto sd = t.subscriber(endpoint, static_cast<int>(i));
+                sd.sub_hwm = 0;
+                buses.push_back(std::make_unique<ZmqMessageBus>(sd));
+                handles.push_back(buses.back()->subscribeRaw(topic, [&, i](const RawMessage&) {
+                    counts[i]++;
+                    last_ns.store(nowNs(), std::memory_order_relaxed);
+                }));
+            }
+            if (!warmup(pub, topic, counts)) {
+                fmt::print("{:>8} {:>5} subscriber not connected\n", size, subs);
+                continue;
+            }
+            for (auto& c : counts) c = 0;
+
+            std::string payload(size, 'x');
+            size_t retries = 0;
+            int64_t t0 = nowNs();
+            for (size_t i = 0; i < count; ++i) retries += publishRetry(pub, topic, payload);
+
+            // 전달 완료 대기 (진행이 없으면 중단)
+            size_t last = 0;
+            for (int idle = 0; idle < 20;) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                size_t now = 0;
+                for (auto& c : counts) now += c.load();
+                if (now >= count * subs) break;
+                idle = now == last ? idle + 1 : 0;
+                last = now;
+            }
+            size_t delivered = 0;
+            for (auto& c : counts) delivered += c.load();
+            double sec = std::max<int64_t>(1, last_ns.load() - t0) / 1e9;
+            double rate = delivered / static_cast<double>(subs) / sec;
+            fmt::print("{:>8} {:>5} {:>12.0f} {:>10.1f} {:>9.1f}% {:>9}\n", size, subs, rate,
+                       rate * size / (1024.0 * 1024.0), 100.0 * delivered / (count * subs), retries);
+        }
+    }
+}
+
+// ------------------------------------------------------
+// latency - 일정 속도로 보내 queueing 이 아닌 전달 경로 지연을 측정
+// ------------------------------------------------------
+void benchLatency(Transport& t, double scale) {
+    const size_t rate = 20000;
+    fmt::print("\n[latency] transport={} rate={} msg/s (us)\n", t.name, rate);
+    fmt::print("{:>8} {:>8} {:>9} {:>9} {:>9} {:>9} {:>9}\n", "size", "samples", "p50", "p90", "p99", "p99.9", "max");
+
+    const std::string topic = "bench.lat";
+    for (size_t size : {64ul, 1024ul, 16384ul}) {
+        size_t count = std::max<size_t>(1000, static_cast<size_t>(scale * 40000));
+        std::string endpoint = t.nextEndpoint();
+        ZmqMessageBus pub(t.publisher(endpoint));
+        ZmqMessageBus sub(t.subscriber(endpoint, 0));
+
+        std::vector<int64_t> samples(count + 1024);
+        std::atomic<size_t> n{0};
+        std::vector<std::atomic<size_t>> counts(1);
+        auto handle = sub.subscribeRaw(topic, [&](const RawMessage& m) {
+            counts[0]++;
+            int64_t sent = 0;
+            if (m.payload.size() < sizeof(sent)) return;
+            std::memcpy(&sent, m.payload.data(), sizeof(sent));
+            if (!sent) return;                                          // warmup
+            size_t i = n.fetch_add(1, std::memory_order_relaxed);
+            if (i < samples.size()) samples[i] = nowNs() - sent;
+        });
+        if (!warmup(pub, topic, counts)) {
+            fmt::print("{:>8} subscriber not connected\n", size);
+            continue;
+        }
+
+        std::string payload(std::max(size, sizeof(int64_t)), 'x');
+        auto interval = std::chrono::nanoseconds(1000000000 / rate);
+        auto due = clock_type::now();
+        for (size_t i = 0; i < count; ++i) {
+            while (clock_type::now() < due) std::this_thread::yield();  // sleep 오차 배제, 구독 thread 에는 CPU 양보
+            due += interval;
+            int64_t ts = nowNs();
+            std::memcpy(payload.data(), &ts, sizeof(ts));
+            publishRetry(pub, topic, payload);
+        }
+        for (int k = 0; k < 100 && n.load() < count; ++k) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        samples.resize(std::min(n.load(), samples.size()));
+        auto p = percentiles(samples);
+        fmt::print("{:>8} {:>8} {:>9.1f} {:>9.1f} {:>9.1f} {:>9.1f} {:>9.1f}\n",
+                   size, samples.size(), p.p50, p.p90, p.p99, p.p999, p.max);
+    }
+}
+
+// ------------------------------------------------------
+// request / reply - client thread 마다 동기 요청 반복
+// ------------------------------------------------------
+void benchRpc(Transport& t, double scale) {
+    std::string endpoint = t.rpcEndpoint();
+    fmt::print("\n[rpc] endpoint={} payload=64 (us)\n", endpoint);
+    fmt::print("{:>6} {:>10} {:>9} {:>9} {:>9} {:>9} {:>9} {:>7}\n", "conc", "req/s", "p50", "p90", "p99", "p99.9", "max", "failed");
+
+    ZmqMessageBusDescriptor sd;
+    sd.pub_endpoint  = "inproc://bench.rpc.server";
+    sd.sub_endpoints = {};
+    sd.local_transport = LocalTransport::None;
+    ZmqMessageBus server(sd);
+    server.reply(endpoint, [](const std::string& req) { return req; });
+
+    for (size_t conc : {1ul, 4ul, 16ul, 64ul}) {
+        ZmqMessageBusDescriptor cd = sd;
+        cd.pub_endpoint = "inproc://bench.rpc.client";
+        ZmqMessageBus client(cd);
+        (void)client.request(endpoint, std::string("warmup"), 3000);
+
+        size_t per_thread = std::max<size_t>(100, static_cast<size_t>(scale * 40000 / conc));
+        std::vector<std::vector<int64_t>> rtts(conc);
+        std::atomic<size_t> failed{0};
+        std::vector<std::thread> threads;
+
+        int64_t t0 = nowNs();
+        for (size_t c = 0; c < conc; ++c) {
+            threads.emplace_back([&, c] {
+                std::string payload(64, 'r');
+                rtts[c].reserve(per_thread);
+                for (size_t i = 0; i < per_thread; ++i) {
+                    int64_t s = nowNs();
+                    auto r = client.request(endpoint, payload, 3000);
+                    if (!r) {
+                        failed++;
+                        continue;
+                    }
+                    rtts[c].push_back(nowNs() - s);
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+        double sec = (nowNs() - t0) / 1e9;
+
+        std::vector<int64_t> all;
+        for (auto& v : rtts) all.insert(all.end(), v.begin(), v.end());
+        auto p = percentiles(all);
+        fmt::print("{:>6} {:>10.0f} {:>9.1f} {:>9.1f} {:>9.1f} {:>9.1f} {:>9.1f} {:>7}\n",
+                   conc, all.size() / sec, p.p50, p.p90, p.p99, p.p999, p.max, failed.load());
+    }
+}
+
+// ------------------------------------------------------
+// codec - message_helper serialize / deserialize
+// ------------------------------------------------------
+message::Message makeMessage(size_t text_size) {
+    message::Message m;
+    m.topic = "bench.codec";
+    m.set("id", int64_t{123456});
+    m.set("ts", nowNs());
+    m.set("x", 1.25);
+    m.set("y", -3.5);
+    m.set("z", 1e9);
+    m.set("ok", true);
+    m.set("state", "running");
+    m.set("op", int64_t{7});
+    if (text_size) m.set("text", std::string(text_size, 't'));
+    return m;
+}
+
+template<typename Fn>
+double nsPerOp(size_t iterations, Fn&& fn) {
+    int64_t t0 = nowNs();
+    for (size_t i = 0; i < iterations; ++i) fn();
+    return static_cast<double>(nowNs() - t0) / iterations;
+}
+
+void benchCodec(double scale) {
+    fmt::print("\n[codec] message_helper (ns/op)\n");
+    fmt::print("{:>8} {:>7} {:>8} {:>11} {:>13} {:>13} {:>10}\n", "fields", "codec", "bytes", "serialize", "deserialize",
+               "deser(view)", "lazy(1)");
+
+    volatile size_t sink = 0;
+    for (size_t text : {0ul, 4096ul}) {
+        message::Message msg = makeMessage(text);
+        size_t iterations = std::max<size_t>(1000, static_cast<size_t>(scale * (text ? 50000 : 500000)));
+
+        for (auto codec : {message::Codec::Binary, message::Codec::Json}) {
+            std::string payload = message::serialize(msg, codec);
+            auto owner = std::make_shared<const std::string>(payload);
+            RawMessage raw{msg.topic, *owner, owner};
+
+            double ser = nsPerOp(iterations, [&] { sink = sink + message::serialize(msg, codec).size(); });
+            double de  = nsPerOp(iterations, [&] { sink = sink + message::deserialize(msg.topic, payload).size(); });
+            double view = nsPerOp(iterations, [&] { sink = sink + message::deserialize(raw).size(); });
+            // MessageView 로 field 하나만 읽음 (subscribeView)
+            double lazy = nsPerOp(iterations, [&] {
+                message::MessageView v(raw);
+                sink = sink + v.getOr<int64_t>("op", 0);
+            });
+            fmt::print("{:>8} {:>7} {:>8} {:>11.0f} {:>13.0f} {:>13.0f} {:>10.0f}\n", msg.size(),
+                       codec == message::Codec::Binary ? "binary" : "json", payload.size(), ser, de, view, lazy);
+        }
+    }
+    (void)sink;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string mode = argc > 1 ? argv[1] : "all";
+    Transport transport;
+    transport.name = argc > 2 ? argv[2] : "inproc";
+    double scale = argc > 3 ? std::stod(argv[3]) : 1.0;
+
+    if (transport.name != "inproc" && transport.name != "tcp" && transport.name != "direct" && transport.name != "shm") {
+        fmt::print("unknown transport: {} (inproc|tcp|direct|shm)\n", transport.name);
+        return 2;
+    }
+    bool all = mode == "all";
+    if (!all && mode != "throughput" && mode != "latency" && mode != "rpc" && mode != "codec") {
+        fmt::print("usage: bench_messaging [all|throughput|latency|rpc|codec] [inproc|tcp|direct|shm] [scale]\n");
+        return 2;
+    }
+
+    if (all || mode == "throughput") benchThroughput(transport, scale);
+    if (all || mode == "latency")    benchLatency(transport, scale);
+    if (all || mode == "rpc")        benchRpc(transport, scale);
+    if (all || mode == "codec")      benchCodec(scale);
+    return 0;
+}
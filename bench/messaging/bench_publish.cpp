@@ -0,0 +1,100 @@
+// bench_publish.cpp
+// publish 경로 처리량 비교 : 복사 (const std::string&) vs 소유권 이전 (std::string&&)
+//
+// usage: bench_publish [inproc|tcp] [messages_per_size]
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include "zmq_message_bus.hpp"
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct RunResult {
+    double seconds = 0.0;
+    size_t delivered = 0;
+};
+
+// 매 메시지마다 새 buffer 를 만드는 producer (센서 frame 과 같은 패턴)
+std::string makeFrame(size_t size, size_t seq) {
+    std::string frame(size, '\0');
+    std::memcpy(frame.data(), &seq, std::min(size, sizeof(seq)));
+    return frame;
+}
+
+RunResult run(ZmqMessageBus& bus, const std::string& topic, size_t size, size_t count,
+              bool zero_copy, std::atomic<size_t>& received) {
+    received.store(0);
+    auto t0 = clock_type::now();
+    for (size_t i = 0; i < count; ++i) {
+        std::string frame = makeFrame(size, i);
+        if (zero_copy) bus.publish(topic, std::move(frame));
+        else           bus.publish(topic, static_cast<const std::string&>(frame));
+    }
+    RunResult r;
+    r.seconds = std::chrono::duration<double>(clock_type::now() - t0).count();
+
+    // 전달 완료 대기 (PUB 는 HWM 초과 시 버리므로 일정 시간 내 수신분만 집계)
+    auto deadline = clock_type::now() + std::chrono::seconds(2);
+    size_t last = 0;
+    while (clock_type::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        size_t now = received.load();
+        if (now >= count || (now == last && now > 0)) break;
+        last = now;
+    }
+    r.delivered = received.load();
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string transport = argc > 1 ? argv[1] : "inproc";
+    size_t per_size = argc > 2 ? std::stoul(argv[2]) : 20000;
+
+    ZmqMessageBusDescriptor desc;
+    if (transport == "tcp") {
+        desc.pub_endpoint  = "tcp://127.0.0.1:5590";
+        desc.sub_endpoints = {"tcp://127.0.0.1:5590"};
+    } else {
+        desc.pub_endpoint  = "inproc://bench.publish";
+        desc.sub_endpoints = {"inproc://bench.publish"};
+    }
+    ZmqMessageBus bus(desc);
+
+    const std::string topic = "bench.frame";
+    std::atomic<size_t> received{0};
+    auto sub = bus.subscribeRaw(topic, [&](const RawMessage&) { received++; });
+    if (!sub) {
+        fmt::print("subscribe failed\n");
+        return 1;
+    }
+
+    // slow joiner : 구독 filter 가 publisher 에 전달될 때까지 대기
+    bus.publish("bench.warmup", std::string("x"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    fmt::print("transport={} messages/size={}\n", transport, per_size);
+    fmt::print("{:>10} {:>10} {:>12} {:>10} {:>10}\n", "size", "mode", "msg/s", "MB/s", "delivered");
+
+    for (size_t size : {256ul, 4096ul, 16384ul, 65536ul, 1048576ul}) {
+        size_t count = size >= 1048576 ? per_size / 20 : per_size;
+        for (bool zero_copy : {false, true}) {
+            auto r = run(bus, topic, size, count, zero_copy, received);
+            double rate = count / r.seconds;
+            fmt::print("{:>10} {:>10} {:>12.0f} {:>10.1f} {:>9.1f}%\n",
+                       size, zero_copy ? "move" : "copy", rate,
+                       rate * size / (1024.0 * 1024.0), 100.0 * r.delivered / count);
+        }
+    }
+    return 0;
+}
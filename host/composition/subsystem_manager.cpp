@@ -6,6 +6,7 @@
 
 #include "subsystem_manager.hpp"
 #include "system_manifest.hpp"
+#include "zmq_context.hpp"
 
 namespace composition {
 
@@ -32,7 +33,7 @@ bool SubsystemManager::load(const manifest::SystemManifest& manifest) {
         const std::string so_path = fmt::format("lib{}.so", info.name);
 
         // TODO: param 정의후 manifest에서 정보 넣어서 만들어야함
-        SubsystemParams params = {0, info.config.c_str(), 0, "system_manifest.yaml"};
+        SubsystemParams params = {(uint32_t)sizeof(SubsystemParams), 0, info.config.c_str(), 0, "system_manifest.yaml", &ZmqContext::instance()};
 
         auto loaded = SubsystemLoader::load(so_path, params);
         if (!loaded) {
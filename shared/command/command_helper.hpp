@@ -1,6 +1,7 @@
 #pragma once
+#include <stdexcept>
 #include <string>
-#include <any>
+#include <variant>
 #include "command_def.hpp"
 
 #include "message.hpp"
@@ -15,14 +16,14 @@ public:
         for (auto& [key, typeSpec] : info.arg_types) {
 
             // argument 존재 여부 체크
-            auto it = args.values.find(key);
-            if (it == args.values.end()) {
+            const message::Value* value = args.find(key);
+            if (!value) {
                 error = "Missing required argument: " + key;
                 return false;
             }
 
             // 타입 검사
-            if (!validateType(it->second, typeSpec)) {
+            if (!validateType(*value, typeSpec)) {
                 error = "Type mismatch for argument: " + key;
                 return false;
             }
@@ -30,30 +31,36 @@ public:
         return true;
     }
 
+    // 없으면 std::out_of_range, 타입이 다르면 std::bad_variant_access
     template<typename T>
     static T get(const message::Message& args, const std::string& key) {
-        return std::any_cast<T>(args.values.at(key));
+        const message::Value* value = args.find(key);
+        if (!value) throw std::out_of_range("Missing argument: " + key);
+        auto v = message::Message::as<T>(*value);
+        if (!v) throw std::bad_variant_access();
+        return *v;
     }
 
     template<typename T>
     static T getOr(const message::Message& args, const std::string& key, const T& defaultValue) {
-        auto it = args.values.find(key);
-        if (it == args.values.end()) return defaultValue;
-        return std::any_cast<T>(it->second);
+        const message::Value* value = args.find(key);
+        if (!value) return defaultValue;
+        auto v = message::Message::as<T>(*value);
+        if (!v) throw std::bad_variant_access();
+        return *v;
     }
 
 private:
-    static bool validateType(const std::any& value, message::ArgType t) {
+    static bool validateType(const message::Value& value, message::ArgType t) {
         switch (t) {
             case message::ArgType::String:
-                return value.type() == typeid(std::string);
+                return message::typeOf(value) == message::ValueType::String;
             case message::ArgType::Int:
-                return value.type() == typeid(int);
+                return message::typeOf(value) == message::ValueType::Int;
             case message::ArgType::Float:
-                return value.type() == typeid(float) ||
-                       value.type() == typeid(double);
+                return message::typeOf(value) == message::ValueType::Double;
             case message::ArgType::Bool:
-                return value.type() == typeid(bool);
+                return message::typeOf(value) == message::ValueType::Bool;
             default:
                 return true;
         }
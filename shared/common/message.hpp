@@ -1,16 +1,34 @@
 #pragma once
 
-#include <unordered_map>
-#include <any>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
 
+// NOTE
+// message::Message m;
+// m.topic = "cmd.SampleCommand";
+// m.set("sample", "hello");                 // 문자열은 message arena 에 복사
+// m.set("op", 3);                           // 정수는 int64 로 저장
+//
+// static const auto k_op = message::key("op");   // 자주 쓰는 key 는 미리 intern
+// int op = m.getOr<int>(k_op, 0);
+// auto s = m.get<std::string_view>("sample");    // 복사 없이 참조 (m 이 살아있는 동안)
 
 namespace message {
-    
-struct Message {
-    std::string topic;
-    std::unordered_map<std::string, std::any> values;
-};
 
 enum class ArgType {
     String,
@@ -20,6 +38,312 @@ enum class ArgType {
     Unknown
 };
 
+// ------------------------------------------------------
+// Key - process 전역 intern 된 field 이름
+//  name 은 process 종료까지 유효, id 비교만으로 동일 key 판별
+// ------------------------------------------------------
+struct Key {
+    uint32_t id = 0;
+    std::string_view name;
+};
+
+class KeyTable {
+public:
+    static KeyTable& instance() {
+        static KeyTable table;
+        return table;
+    }
+
+    Key intern(std::string_view name) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = ids_.find(name);
+            if (it != ids_.end()) return {it->second, it->first};
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) return {it->second, it->first};
+
+        auto& stored = names_.emplace_back(name);
+        uint32_t id = static_cast<uint32_t>(names_.size());
+        ids_.emplace(std::string_view(stored), id);
+        return {id, stored};
+    }
+
+private:
+    KeyTable() = default;
+
+    std::shared_mutex mutex_;
+    std::deque<std::string> names_;                         // 주소 고정
+    std::unordered_map<std::string_view, uint32_t> ids_;
+};
+
+inline Key key(std::string_view name) {
+    return KeyTable::instance().intern(name);
+}
+
+
+// ------------------------------------------------------
+// Value - 닫힌 타입 집합
+//  String / Bytes 는 message arena 또는 retain() 한 수신 버퍼를 가리킴
+// ------------------------------------------------------
+struct Bytes {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+enum class ValueType {
+    Null,
+    Int,
+    Double,
+    Bool,
+    String,
+    Bytes,
+};
+
+using Value = std::variant<std::monostate, int64_t, double, bool, std::string_view, Bytes>;
+
+inline ValueType typeOf(const Value& v) noexcept {
+    return static_cast<ValueType>(v.index());
+}
+
+struct Field {
+    Key key;
+    Value value;
+
+    std::string_view name() const noexcept { return key.name; }
+    ValueType type() const noexcept { return typeOf(value); }
+};
+
+namespace detail {
 
+template<typename> inline constexpr bool always_false = false;
+
+// message 당 한 번 할당 - field 배열과 문자열 / bytes 를 같은 arena 에 둠
+struct MessageStorage {
+    static constexpr size_t INLINE_SIZE = 512;
+
+    MessageStorage() : resource(buffer.data(), buffer.size()), fields(&resource) {
+        fields.reserve(8);
+    }
+
+    std::array<std::byte, INLINE_SIZE> buffer;
+    std::pmr::monotonic_buffer_resource resource;
+    std::pmr::vector<Field> fields;
+};
+
+} // namespace detail
+
+
+// ------------------------------------------------------
+// Message - key / value flat vector + per-message arena
+// ------------------------------------------------------
+class Message {
+public:
+    std::string topic;
+
+    Message() = default;
+    ~Message() = default;
+
+    Message(Message&&) noexcept            = default;
+    Message& operator=(Message&&) noexcept = default;
+
+    // 복사는 문자열 / bytes 를 새 arena 로 복사 (원본 수신 버퍼에 의존하지 않음)
+    Message(const Message& other) : topic(other.topic) {
+        copyFieldsFrom(other);
+    }
+
+    Message& operator=(const Message& other) {
+        if (this != &other) {
+            Message tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    // -------------------------
+    // 쓰기
+    // -------------------------
+    template<typename T>
+    void set(Key k, const T& value) {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool>) {
+            put(k, Value{value});
+        } else if constexpr (std::is_integral_v<U>) {
+            put(k, Value{static_cast<int64_t>(value)});
+        } else if constexpr (std::is_floating_point_v<U>) {
+            put(k, Value{static_cast<double>(value)});
+        } else if constexpr (std::is_same_v<U, Bytes>) {
+            put(k, Value{copyBytes(value.data, value.size)});
+        } else if constexpr (std::is_same_v<U, std::vector<uint8_t>>) {
+            put(k, Value{copyBytes(value.data(), value.size())});
+        } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+            put(k, Value{copyString(std::string_view(value))});
+        } else {
+            static_assert(detail::always_false<U>, "unsupported message value type");
+        }
+    }
+
+    template<typename T>
+    void set(std::string_view name, const T& value) { set(key(name), value); }
+
+    // 복사 없이 참조만 저장 - data 는 retain() 한 owner 또는 호출자가 수명 보장
+    void setView(Key k, std::string_view value) { put(k, Value{value}); }
+    void setView(Key k, Bytes value) { put(k, Value{value}); }
+
+    // 수신 버퍼 등 view 가 가리키는 메모리를 message 수명 동안 유지
+    void retain(std::shared_ptr<const void> owner) { owner_ = std::move(owner); }
+
+    bool erase(std::string_view name) {
+        if (!storage_) return false;
+        auto& fields = storage_->fields;
+        for (auto it = fields.begin(); it != fields.end(); ++it) {
+            if (it->key.name == name) {
+                fields.erase(it);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void clear() {
+        storage_.reset();
+        owner_.reset();
+    }
+
+    void reserve(size_t n) { storage().fields.reserve(n); }
+
+    // -------------------------
+    // 읽기
+    // -------------------------
+    const Value* find(Key k) const noexcept {
+        if (!storage_) return nullptr;
+        for (auto& f : storage_->fields) {
+            if (f.key.id == k.id) return &f.value;
+        }
+        return nullptr;
+    }
+
+    // 이름 비교로 찾음 (intern 조회 없음)
+    const Value* find(std::string_view name) const noexcept {
+        if (!storage_) return nullptr;
+        for (auto& f : storage_->fields) {
+            if (f.key.name == name) return &f.value;
+        }
+        return nullptr;
+    }
+
+    template<typename K>
+    bool contains(const K& k) const noexcept { return find(k) != nullptr; }
+
+    // 없거나 타입이 맞지 않으면 nullopt
+    template<typename T, typename K>
+    std::optional<T> get(const K& k) const {
+        const Value* v = find(k);
+        if (!v) return std::nullopt;
+        return as<T>(*v);
+    }
+
+    template<typename T, typename K>
+    T getOr(const K& k, const T& default_value) const {
+        auto v = get<T>(k);
+        return v ? *v : default_value;
+    }
+
+    // Value -> T 변환 규칙 (정수 <-> 정수, 정수 -> 실수 허용)
+    //  T 의 범위를 벗어나는 값은 잘라내지 않고 타입 불일치와 같이 nullopt
+    template<typename T>
+    static std::optional<T> as(const Value& v) {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool>) {
+            if (auto p = std::get_if<bool>(&v)) return *p;
+        } else if constexpr (std::is_integral_v<U>) {
+            if (auto p = std::get_if<int64_t>(&v)) {
+                if (!fitsInteger<U>(*p)) return std::nullopt;
+                return static_cast<U>(*p);
+            }
+        } else if constexpr (std::is_floating_point_v<U>) {
+            if (auto p = std::get_if<double>(&v)) {
+                if (std::numeric_limits<U>::max() < std::numeric_limits<double>::max() &&
+                    (*p > std::numeric_limits<U>::max() || *p < std::numeric_limits<U>::lowest())) {
+                    return std::nullopt;
+                }
+                return static_cast<U>(*p);
+            }
+            if (auto p = std::get_if<int64_t>(&v)) return static_cast<U>(*p);
+        } else if constexpr (std::is_same_v<U, std::string_view>) {
+            if (auto p = std::get_if<std::string_view>(&v)) return *p;
+        } else if constexpr (std::is_same_v<U, std::string>) {
+            if (auto p = std::get_if<std::string_view>(&v)) return std::string(*p);
+        } else if constexpr (std::is_same_v<U, Bytes>) {
+            if (auto p = std::get_if<Bytes>(&v)) return *p;
+        } else if constexpr (std::is_same_v<U, std::vector<uint8_t>>) {
+            if (auto p = std::get_if<Bytes>(&v)) return std::vector<uint8_t>(p->data, p->data + p->size);
+        } else {
+            static_assert(detail::always_false<U>, "unsupported message value type");
+        }
+        return std::nullopt;
+    }
+
+    size_t size() const noexcept { return storage_ ? storage_->fields.size() : 0; }
+    bool empty() const noexcept { return size() == 0; }
+
+    const Field* begin() const noexcept { return storage_ ? storage_->fields.data() : nullptr; }
+    const Field* end() const noexcept { return storage_ ? storage_->fields.data() + storage_->fields.size() : nullptr; }
+
+private:
+    template<typename U>
+    static constexpr bool fitsInteger(int64_t x) noexcept {
+        if constexpr (std::is_signed_v<U>) {
+            return x >= static_cast<int64_t>(std::numeric_limits<U>::min()) &&
+                   x <= static_cast<int64_t>(std::numeric_limits<U>::max());
+        } else {
+            return x >= 0 && static_cast<uint64_t>(x) <= std::numeric_limits<U>::max();
+        }
+    }
+
+    detail::MessageStorage& storage() {
+        if (!storage_) storage_ = std::make_unique<detail::MessageStorage>();
+        return *storage_;
+    }
+
+    void put(Key k, Value v) {
+        auto& fields = storage().fields;
+        for (auto& f : fields) {
+            if (f.key.id == k.id) {
+                f.value = v;
+                return;
+            }
+        }
+        fields.push_back({k, v});
+    }
+
+    std::string_view copyString(std::string_view s) {
+        if (s.empty()) return {};
+        auto* p = static_cast<char*>(storage().resource.allocate(s.size(), 1));
+        std::memcpy(p, s.data(), s.size());
+        return {p, s.size()};
+    }
+
+    Bytes copyBytes(const uint8_t* data, size_t size) {
+        if (!size) return {};
+        auto* p = static_cast<uint8_t*>(storage().resource.allocate(size, 1));
+        std::memcpy(p, data, size);
+        return {p, size};
+    }
+
+    void copyFieldsFrom(const Message& other) {
+        if (other.empty()) return;
+        reserve(other.size());
+        for (auto& f : other) {
+            if (auto s = std::get_if<std::string_view>(&f.value))  put(f.key, Value{copyString(*s)});
+            else if (auto b = std::get_if<Bytes>(&f.value))        put(f.key, Value{copyBytes(b->data, b->size)});
+            else                                                    put(f.key, f.value);
+        }
+    }
+
+    std::unique_ptr<detail::MessageStorage> storage_;
+    std::shared_ptr<const void> owner_;
+};
 
 }
@@ -7,7 +7,7 @@ extern "C"
 {
 #endif
 
-#define SUBSYS_ABI_VERSION 1
+#define SUBSYS_ABI_VERSION 2
 
     enum
     {
@@ -38,12 +38,17 @@ extern "C"
 
     typedef struct SubsystemParams
     {
+        uint32_t size;              // sizeof(SubsystemParams) - host 가 채움
         ConfigType config_type;
         const char *config_path; 
         ManifestType manifest_type;
         const char *manifest_path; 
+        void *bus_context;          // host 의 ZmqContext (같은 process bus 공유, NULL 가능)
     } SubsystemParams;
 
+    // v2 에서 맨 앞에 size 가 추가되어 모든 field 위치가 v1 과 다름 (뒤쪽 field 만 없는 것이 아님)
+    // loader 가 abi_version 일치를 확인하므로 host 와 subsystem 모두 v2 로 build 해야 함
+
     typedef struct SubsystemDescriptor
     {
         uint32_t abi_version;          
@@ -4,6 +4,8 @@
 #include <string>
 #include <unordered_map>
 #include <functional>
+#include <string_view>
+#include <type_traits>
 
 #include "result.h"
 #include "helpper.hpp"
@@ -13,14 +15,15 @@
 namespace service {
 
     
+// handler 인자 타입으로 등록 방식 결정
+//   Result<void> cmdX(const message::Message& args)   - Message 그대로 전달
+//   Result<void> cmdX(const msg::X& args)             - 생성된 typed struct 로 변환 후 전달
 #define REGISTER_COMMAND(name)                                   \
     do {                                                        \
         static_assert(#name[0]=='c' && #name[1]=='m' && #name[2]=='d', \
                       "Command handler must start with 'cmd'"); \
-        commands_[ std::string(#name).substr(3) ] =             \
-            [this](const message::Message& args){           \
-                return this->name(args);                        \
-            };                                                  \
+        registerHandler(std::string(#name).substr(3), this,     \
+                        &std::decay_t<decltype(*this)>::name);  \
     } while(0)
 
 
@@ -29,6 +32,7 @@ class SystemService {
 public:
     virtual ~SystemService() {
         commands_.clear();
+        raw_commands_.clear();
     };
 
     Result<void> invokeMethod(const std::string& name, const message::Message& args) {
@@ -38,10 +42,41 @@ public:
         }
         return Fail();
     }
+
+    // typed codec 으로 인코딩된 payload 를 Message 변환 없이 바로 전달 (typed handler 만)
+    Result<void> invokeRaw(const std::string& name, std::string_view payload) {
+        auto it = raw_commands_.find(name);
+        if (it != raw_commands_.end()) {
+            return it->second(payload);
+        }
+        return Error(ResultCode::NotSupported, "no typed handler: " + name);
+    }
+
 protected:
     virtual void registerCommand() = 0;
 
+    template<typename S, typename Arg>
+    void registerHandler(const std::string& command, S* self, Result<void> (S::*fn)(const Arg&)) {
+        if constexpr (std::is_same_v<Arg, message::Message>) {
+            commands_[command] = [self, fn](const message::Message& args) {
+                return (self->*fn)(args);
+            };
+        } else {
+            commands_[command] = [self, fn](const message::Message& args) -> Result<void> {
+                auto v = Arg::fromMessage(args);
+                if (!v) return Error(v.code(), v.error());
+                return (self->*fn)(v.value());
+            };
+            raw_commands_[command] = [self, fn](std::string_view payload) -> Result<void> {
+                auto v = Arg::decode(payload);
+                if (!v) return Error(v.code(), v.error());
+                return (self->*fn)(v.value());
+            };
+        }
+    }
+
     std::unordered_map<std::string, std::function<Result<void>(const message::Message& args)>> commands_;
+    std::unordered_map<std::string, std::function<Result<void>(std::string_view payload)>> raw_commands_;
     
 }; // class SystemService
 
@@ -0,0 +1,377 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "message.hpp"
+#include "topic_registry.hpp"
+
+// NOTE
+// bus 의 topic 별 계수 - 송수신 메시지 / byte, decode / callback 시간, drop, end-to-end latency, seq gap
+//
+// ZmqMessageBusDescriptor d;
+// d.metrics             = true;                // topic 별 계수
+// d.metrics_stamp       = true;                // 송신 시각 + seq frame - 구독 쪽 bus 가 latency / gap 기록
+// d.metrics_interval_ms = 1000;                // 주기적으로 sys.metrics.bus 에 topic 별 Message publish
+//
+// for (auto& t : bus.metricsSnapshot()) LOGI("{} p99={}us lost={}", t.topic, t.latency_p99_ns / 1000, t.lost);
+// bus.subscribe("sys.metrics.bus", [](const message::Message& m) { m.getOr<int64_t>("received", 0); ... });
+//
+// STAMP frame (payload 뒤, lvc SEQ frame 이 있으면 그 뒤) - 21 byte
+//   [0] MAGIC 0xB6  [1..4] source (publisher bus 식별)  [5..12] seq (topic 별)  [13..20] send_ns (system_clock)
+//
+// - 계수는 relaxed atomic (lock 없음), topic 별 계수는 처음 기록할 때 생성
+// - latency 는 system_clock 차이 - 다른 host 사이는 시각 동기화 (NTP / PTP) 정확도만큼 오차
+// - gap 은 한 topic 의 publisher 가 하나라고 가정 (source 가 바뀌면 그 seq 부터 다시 시작)
+// - batch 로 보낸 메시지 / shm / Direct 경로에는 STAMP 가 붙지 않음 (수신 계수만)
+
+namespace metrics {
+
+inline constexpr uint8_t STAMP_MAGIC      = 0xB6;
+inline constexpr size_t  STAMP_FRAME_SIZE = 21;
+
+struct Stamp {
+    uint32_t source = 0;
+    uint64_t seq = 0;                   // 0 = STAMP 없음
+    int64_t send_ns = 0;
+};
+
+inline int64_t nowNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+inline void encodeStamp(const Stamp& s, char (&out)[STAMP_FRAME_SIZE]) noexcept {
+    out[0] = static_cast<char>(STAMP_MAGIC);
+    for (int i = 0; i < 4; ++i) out[1 + i] = static_cast<char>((s.source >> (8 * i)) & 0xFF);
+    for (int i = 0; i < 8; ++i) out[5 + i] = static_cast<char>((s.seq >> (8 * i)) & 0xFF);
+    auto ns = static_cast<uint64_t>(s.send_ns);
+    for (int i = 0; i < 8; ++i) out[13 + i] = static_cast<char>((ns >> (8 * i)) & 0xFF);
+}
+
+// return: false (STAMP frame 아님)
+inline bool decodeStamp(std::string_view frame, Stamp& out) noexcept {
+    if (frame.size() != STAMP_FRAME_SIZE || static_cast<uint8_t>(frame[0]) != STAMP_MAGIC) return false;
+    auto byte = [&](int i) { return static_cast<uint64_t>(static_cast<uint8_t>(frame[i])); };
+    out = Stamp{};
+    for (int i = 0; i < 4; ++i) out.source |= static_cast<uint32_t>(byte(1 + i) << (8 * i));
+    for (int i = 0; i < 8; ++i) out.seq |= byte(5 + i) << (8 * i);
+    uint64_t ns = 0;
+    for (int i = 0; i < 8; ++i) ns |= byte(13 + i) << (8 * i);
+    out.send_ns = static_cast<int64_t>(ns);
+    return true;
+}
+
+// ------------------------------------------------------
+// LatencyHistogram - 2 의 거듭제곱 구간을 4 개로 나눈 bucket (상대 오차 25% 이내)
+//  0 ~ 2^41 ns (약 36 분), 넘는 값은 마지막 bucket
+// ------------------------------------------------------
+class LatencyHistogram {
+public:
+    static constexpr size_t SUB_BITS = 2;
+    static constexpr size_t SUB      = size_t(1) << SUB_BITS;
+    static constexpr size_t MAX_MSB  = 40;
+    static constexpr size_t BUCKETS  = SUB + (MAX_MSB - SUB_BITS + 1) * SUB;
+
+    void record(uint64_t ns) noexcept {
+        buckets_[indexOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t max = max_.load(std::memory_order_relaxed);
+        while (ns > max && !max_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) { }
+    }
+
+    uint64_t count() const noexcept { return count_.load(std::memory_order_relaxed); }
+    uint64_t sum() const noexcept { return sum_.load(std::memory_order_relaxed); }
+    uint64_t max() const noexcept { return max_.load(std::memory_order_relaxed); }
+
+    // q (0 ~ 1) 에 해당하는 bucket 의 상한 (max 를 넘지 않음), 기록이 없으면 0
+    uint64_t percentile(double q) const noexcept {
+        uint64_t total = count();
+        if (!total) return 0;
+        auto rank = static_cast<uint64_t>(q * static_cast<double>(total));
+        rank = std::clamp<uint64_t>(rank, 1, total);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) return std::min(upperOf(i), max());
+        }
+        return max();
+    }
+
+private:
+    static size_t indexOf(uint64_t v) noexcept {
+        if (v < SUB) return static_cast<size_t>(v);
+        size_t msb = 63 - static_cast<size_t>(__builtin_clzll(v));
+        if (msb > MAX_MSB) return BUCKETS - 1;
+        size_t sub = static_cast<size_t>(v >> (msb - SUB_BITS)) & (SUB - 1);
+        return SUB + (msb - SUB_BITS) * SUB + sub;
+    }
+
+    static uint64_t upperOf(size_t index) noexcept {
+        if (index < SUB) return index;
+        size_t msb = (index - SUB) / SUB + SUB_BITS;
+        uint64_t sub = (index - SUB) % SUB;
+        uint64_t step = uint64_t(1) << (msb - SUB_BITS);
+        return ((SUB + sub) << (msb - SUB_BITS)) + step - 1;
+    }
+
+    std::atomic<uint64_t> buckets_[BUCKETS] = {};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+} // namespace metrics
+
+
+// topic 하나의 계수 - BusMetrics::find(id)
+struct TopicMetrics {
+    // publisher
+    std::atomic<uint64_t> published{0};         // stamp seq 로도 사용
+    std::atomic<uint64_t> published_bytes{0};
+
+    // subscriber (poll loop 여러 개가 같은 topic 을 받으면 loop 마다 셈)
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> received_bytes{0};
+    std::atomic<uint64_t> rx_dropped{0};        // callback 실행 대기 상한 초과로 버림
+    std::atomic<uint64_t> decodes{0};           // Message callback 용 decode
+    std::atomic<uint64_t> decode_ns{0};
+    std::atomic<uint64_t> callbacks{0};
+    std::atomic<uint64_t> callback_ns{0};
+
+    // STAMP 가 붙은 메시지
+    std::atomic<uint64_t> stamped{0};
+    std::atomic<uint64_t> gaps{0};              // seq 가 건너뛴 횟수
+    std::atomic<uint64_t> lost{0};              // 건너뛴 seq 합계
+    metrics::LatencyHistogram latency;          // 송신 ~ 수신 (ns)
+
+    std::atomic<uint32_t> source{0};            // 마지막으로 받은 publisher
+    std::atomic<uint64_t> last_seq{0};
+};
+
+struct TopicMetricsSnapshot {
+    std::string topic;
+    uint64_t published = 0;
+    uint64_t published_bytes = 0;
+    uint64_t received = 0;
+    uint64_t received_bytes = 0;
+    uint64_t rx_dropped = 0;
+    uint64_t decodes = 0;
+    uint64_t decode_ns = 0;
+    uint64_t callbacks = 0;
+    uint64_t callback_ns = 0;
+    uint64_t stamped = 0;
+    uint64_t gaps = 0;
+    uint64_t lost = 0;
+    uint64_t latency_mean_ns = 0;
+    uint64_t latency_p50_ns = 0;
+    uint64_t latency_p90_ns = 0;
+    uint64_t latency_p99_ns = 0;
+    uint64_t latency_max_ns = 0;
+
+    // 계수가 바뀌었는지 비교 (주기 publish 에서 변화 없는 topic 생략)
+    uint64_t activity() const noexcept { return published + received + rx_dropped; }
+};
+
+
+// ------------------------------------------------------
+// BusMetrics - TopicId 로 index 하는 TopicMetrics table
+//  table 은 2 단계 atomic pointer 배열 (TopicRegistry 와 같은 chunk 크기) - 조회 / 생성에 lock 없음
+//  bus 가 소유하고 구독자 (ZmqSubscriberDescriptor::metrics) 는 pointer 만 사용
+// ------------------------------------------------------
+class BusMetrics {
+public:
+    BusMetrics() : source_(makeSource()) { }
+
+    ~BusMetrics() {
+        for (auto& c : chunks_) {
+            auto* chunk = c.load(std::memory_order_acquire);
+            if (!chunk) continue;
+            for (size_t i = 0; i < CHUNK_SIZE; ++i) delete chunk[i].load(std::memory_order_acquire);
+            delete[] chunk;
+        }
+    }
+
+    BusMetrics(const BusMetrics&)            = delete;
+    BusMetrics& operator=(const BusMetrics&) = delete;
+
+    uint32_t source() const noexcept { return source_; }
+
+    // 없으면 생성, NO_TOPIC 은 nullptr
+    TopicMetrics* at(TopicId id) {
+        if (id == NO_TOPIC) return nullptr;
+        auto& slot = chunkOf(id)[id & (CHUNK_SIZE - 1)];
+        auto* m = slot.load(std::memory_order_acquire);
+        if (m) return m;
+        auto* created = new TopicMetrics();
+        if (slot.compare_exchange_strong(m, created, std::memory_order_acq_rel)) return created;
+        delete created;
+        return m;
+    }
+
+    // 기록된 적이 없으면 nullptr
+    const TopicMetrics* find(TopicId id) const noexcept {
+        if (id == NO_TOPIC) return nullptr;
+        auto* chunk = chunks_[id >> CHUNK_BITS].load(std::memory_order_acquire);
+        return chunk ? chunk[id & (CHUNK_SIZE - 1)].load(std::memory_order_acquire) : nullptr;
+    }
+
+    // publisher 전송 lock 안에서 호출 - stamp 요청 시 seq / 송신 시각 반환 (아니면 seq = 0)
+    metrics::Stamp onPublish(TopicId id, size_t bytes, bool stamp) {
+        auto* m = at(id);
+        if (!m) return {};
+        uint64_t seq = m->published.fetch_add(1, std::memory_order_relaxed) + 1;
+        m->published_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        if (!stamp) return {};
+        return {source_, seq, metrics::nowNs()};
+    }
+
+    void onReceive(TopicId id, size_t bytes, const metrics::Stamp* stamp = nullptr) {
+        auto* m = at(id);
+        if (!m) return;
+        m->received.fetch_add(1, std::memory_order_relaxed);
+        m->received_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        if (stamp && stamp->seq) track(*m, *stamp);
+    }
+
+    void onQueueDrop(TopicId id) {
+        if (auto* m = at(id)) m->rx_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void onDecode(TopicId id, uint64_t ns) {
+        if (auto* m = at(id)) {
+            m->decodes.fetch_add(1, std::memory_order_relaxed);
+            m->decode_ns.fetch_add(ns, std::memory_order_relaxed);
+        }
+    }
+
+    void onCallback(TopicId id, uint64_t ns) {
+        if (auto* m = at(id)) {
+            m->callbacks.fetch_add(1, std::memory_order_relaxed);
+            m->callback_ns.fetch_add(ns, std::memory_order_relaxed);
+        }
+    }
+
+    // 기록된 모든 topic (TopicId 순)
+    std::vector<TopicMetricsSnapshot> snapshot() const {
+        std::vector<TopicMetricsSnapshot> out;
+        size_t last = TopicRegistry::instance().size();
+        for (size_t c = 0; c <= (last >> CHUNK_BITS) && c < MAX_CHUNKS; ++c) {
+            auto* chunk = chunks_[c].load(std::memory_order_acquire);
+            if (!chunk) continue;
+            for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+                auto* m = chunk[i].load(std::memory_order_acquire);
+                if (m) out.push_back(snapshotOf(static_cast<TopicId>((c << CHUNK_BITS) | i), *m));
+            }
+        }
+        return out;
+    }
+
+private:
+    static constexpr size_t CHUNK_BITS = TopicRegistry::CHUNK_BITS;
+    static constexpr size_t CHUNK_SIZE = TopicRegistry::CHUNK_SIZE;
+    static constexpr size_t MAX_CHUNKS = TopicRegistry::MAX_CHUNKS;
+
+    using Chunk = std::atomic<TopicMetrics*>;
+
+    static uint32_t makeSource() {
+        uint32_t s = std::random_device{}();
+        return s ? s : 1;
+    }
+
+    Chunk* chunkOf(TopicId id) {
+        auto& c = chunks_[id >> CHUNK_BITS];
+        auto* chunk = c.load(std::memory_order_acquire);
+        if (chunk) return chunk;
+        auto* created = new Chunk[CHUNK_SIZE]();
+        if (c.compare_exchange_strong(chunk, created, std::memory_order_acq_rel)) return created;
+        delete[] created;
+        return chunk;
+    }
+
+    // latency 기록 + seq gap 검사 (늦게 도착한 / 중복 seq 는 gap 아님)
+    static void track(TopicMetrics& m, const metrics::Stamp& s) {
+        m.stamped.fetch_add(1, std::memory_order_relaxed);
+        int64_t latency = metrics::nowNs() - s.send_ns;
+        m.latency.record(latency > 0 ? static_cast<uint64_t>(latency) : 0);
+
+        if (m.source.load(std::memory_order_relaxed) != s.source) {
+            m.source.store(s.source, std::memory_order_relaxed);
+            m.last_seq.store(s.seq, std::memory_order_relaxed);
+            return;
+        }
+        uint64_t prev = m.last_seq.load(std::memory_order_relaxed);
+        while (s.seq > prev && !m.last_seq.compare_exchange_weak(prev, s.seq, std::memory_order_relaxed)) { }
+        if (prev && s.seq > prev + 1) {
+            m.gaps.fetch_add(1, std::memory_order_relaxed);
+            m.lost.fetch_add(s.seq - prev - 1, std::memory_order_relaxed);
+        }
+    }
+
+    static TopicMetricsSnapshot snapshotOf(TopicId id, const TopicMetrics& m) {
+        auto get = [](const std::atomic<uint64_t>& v) { return v.load(std::memory_order_relaxed); };
+        TopicMetricsSnapshot s;
+        s.topic           = std::string(topicName(id));
+        s.published       = get(m.published);
+        s.published_bytes = get(m.published_bytes);
+        s.received        = get(m.received);
+        s.received_bytes  = get(m.received_bytes);
+        s.rx_dropped      = get(m.rx_dropped);
+        s.decodes         = get(m.decodes);
+        s.decode_ns       = get(m.decode_ns);
+        s.callbacks       = get(m.callbacks);
+        s.callback_ns     = get(m.callback_ns);
+        s.stamped         = get(m.stamped);
+        s.gaps            = get(m.gaps);
+        s.lost            = get(m.lost);
+
+        uint64_t count = m.latency.count();
+        s.latency_mean_ns = count ? m.latency.sum() / count : 0;
+        s.latency_p50_ns  = m.latency.percentile(0.50);
+        s.latency_p90_ns  = m.latency.percentile(0.90);
+        s.latency_p99_ns  = m.latency.percentile(0.99);
+        s.latency_max_ns  = m.latency.max();
+        return s;
+    }
+
+    const uint32_t source_;
+    std::atomic<Chunk*> chunks_[MAX_CHUNKS] = {};
+};
+
+
+namespace metrics {
+
+// sys.metrics.bus 로 publish 하는 형태 - topic 하나당 Message 하나 (누적 값)
+inline message::Message toMessage(const TopicMetricsSnapshot& s, std::string_view bus, std::string_view metrics_topic) {
+    message::Message m;
+    m.topic = metrics_topic;
+    m.reserve(19);
+    m.set("bus", bus);
+    m.set("topic", s.topic);
+    m.set("published", s.published);
+    m.set("published_bytes", s.published_bytes);
+    m.set("received", s.received);
+    m.set("received_bytes", s.received_bytes);
+    m.set("rx_dropped", s.rx_dropped);
+    m.set("decodes", s.decodes);
+    m.set("decode_ns", s.decode_ns);
+    m.set("callbacks", s.callbacks);
+    m.set("callback_ns", s.callback_ns);
+    m.set("stamped", s.stamped);
+    m.set("gaps", s.gaps);
+    m.set("lost", s.lost);
+    m.set("latency_mean_ns", s.latency_mean_ns);
+    m.set("latency_p50_ns", s.latency_p50_ns);
+    m.set("latency_p90_ns", s.latency_p90_ns);
+    m.set("latency_p99_ns", s.latency_p99_ns);
+    m.set("latency_max_ns", s.latency_max_ns);
+    return m;
+}
+
+} // namespace metrics
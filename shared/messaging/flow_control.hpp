@@ -0,0 +1,568 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <unistd.h>
+
+#include "result.h"
+#include "raw_message.hpp"
+#include "wire_format.hpp"
+#include "topic_router.hpp"
+#include "topic_registry.hpp"
+
+// NOTE
+// lossless topic - publisher 는 topic 별 seq 와 최근 window 개 메시지를 보관하고
+// 구독자의 ACK 로 credit 을 계산, NACK 에는 window 에서 재전송
+//
+// publisher (ZmqMessageBus 가 사용)
+//   SendWindow window({{"cmd.result.#"}, 1024});
+//   TopicId id = internTopic(topic);
+//   window.acquire(id);                          // credit 이 생길 때까지 대기 (block_ms)
+//   SendWindow::Reservation credit(window, id);  // append 전에 반환하면 credit 반납
+//   uint64_t seq = window.append(id, payload);   // 전송 lock 안에서, 0 = lossless 아님
+//   credit.commit();
+//   reply handler = [&](const std::string& req) { return window.handle(req); };
+//
+// subscriber
+//   auto rx = std::make_shared<ReliableReceiver>(desc, callback, request, stats);
+//   live 구독 callback 에서 rx->live(raw), 주기적으로 rx->tick()
+//
+// control 요청 (request / reply, varint 인코딩)
+//   ACK  : [1] peer topic seq               -> [head]
+//   NACK : [2] topic from to                -> [first][head] { seq len payload } * N
+//   first = window 에 남아 있는 가장 오래된 seq (from 보다 크면 그 사이는 복구 불가)
+//
+// 보장 범위 - 구독자의 첫 ACK 가 도착한 이후부터 (그 전에 window 를 넘어 보낸 메시지는 복구 불가)
+
+namespace flow {
+
+enum class ControlType : uint8_t {
+    Ack  = 1,
+    Nack = 2,
+};
+
+inline void putString(std::string& out, std::string_view s) {
+    wire::putVarint(out, s.size());
+    out.append(s.data(), s.size());
+}
+
+inline bool getString(const uint8_t*& p, const uint8_t* end, std::string_view& out) noexcept {
+    uint64_t len;
+    if (!wire::getVarint(p, end, len) || len > static_cast<uint64_t>(end - p)) return false;
+    out = std::string_view(reinterpret_cast<const char*>(p), len);
+    p += len;
+    return true;
+}
+
+inline std::string encodeAck(std::string_view peer, std::string_view topic, uint64_t seq) {
+    std::string out(1, static_cast<char>(ControlType::Ack));
+    putString(out, peer);
+    putString(out, topic);
+    wire::putVarint(out, seq);
+    return out;
+}
+
+inline std::string encodeNack(std::string_view topic, uint64_t from, uint64_t to) {
+    std::string out(1, static_cast<char>(ControlType::Nack));
+    putString(out, topic);
+    wire::putVarint(out, from);
+    wire::putVarint(out, to);
+    return out;
+}
+
+} // namespace flow
+
+
+struct SendWindowDescriptor {
+    std::vector<std::string> topics;    // lossless topic pattern (topic_router.hpp 문법)
+    size_t window = 1024;               // topic 당 ACK 되지 않은 메시지 상한 = 재전송 가능 범위
+    int block_ms = 1000;                // credit 대기 상한, 넘으면 ResourceBusy
+    int peer_timeout_ms = 3000;         // 이 시간 동안 ACK 가 없는 구독자는 credit 계산에서 제외
+};
+
+struct SendWindowStats {
+    std::atomic<size_t> appended{0};
+    std::atomic<size_t> acks{0};
+    std::atomic<size_t> nacks{0};
+    std::atomic<size_t> retransmitted{0};       // NACK 로 다시 보낸 메시지
+    std::atomic<size_t> unrecoverable{0};       // window 를 벗어나 다시 보내지 못한 메시지
+    std::atomic<size_t> credit_waits{0};        // credit 부족으로 대기한 publish
+    std::atomic<size_t> credit_timeouts{0};     // block_ms 안에 credit 을 얻지 못한 publish
+    std::atomic<size_t> peers{0};               // flow control 중인 (topic, 구독자) 수
+    std::atomic<size_t> evicted{0};             // peer_timeout_ms 로 제외된 구독자
+};
+
+
+// ------------------------------------------------------
+// SendWindow - lossless topic 의 publisher 쪽 상태
+//  - credit = window - (head + 예약 - 가장 느린 구독자의 ACK), 구독자가 없으면 제한 없음
+//  - 재전송은 NACK 응답으로 요청한 구독자에게만 (PUB socket 으로 다시 뿌리지 않음)
+//  - acquire 는 전송 lock 밖, append 는 전송 lock 안에서 호출
+//  - stream 은 TopicId 로 index (intern 되지 않은 topic 은 lossless 로 처리하지 않음)
+// ------------------------------------------------------
+class SendWindow {
+public:
+    explicit SendWindow(SendWindowDescriptor desc = {}) : desc_(std::move(desc)) {
+        for (auto& pattern : desc_.topics) {
+            if (topic::validate(pattern)) router_.add(pattern, 0);
+        }
+        if (!desc_.window) desc_.window = 1;
+    }
+
+    bool enabled() const noexcept { return !desc_.topics.empty(); }
+
+    // lossless topic 이면 credit 을 하나 예약 (append 에서 사용)
+    // return: ResourceBusy (block_ms 안에 credit 없음)
+    Result<void> acquire(TopicId id) {
+        if (!enabled()) return OK();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        Stream* s = find(id);
+        if (!s) return OK();
+
+        auto deadline = Clock::now() + std::chrono::milliseconds(desc_.block_ms);
+        bool waited = false;
+        for (;;) {
+            expire(*s, Clock::now());
+            if (outstanding(*s) < desc_.window) {
+                s->reserved++;
+                return OK();
+            }
+            if (!waited) {
+                waited = true;
+                stats_.credit_waits++;
+            }
+            if (cv_.wait_until(lock, deadline) == std::cv_status::timeout && Clock::now() >= deadline) {
+                expire(*s, Clock::now());
+                if (outstanding(*s) < desc_.window) {
+                    s->reserved++;
+                    return OK();
+                }
+                stats_.credit_timeouts++;
+                return Error(ResultCode::ResourceBusy, "no credit for lossless topic " + std::string(topicName(id)));
+            }
+        }
+    }
+
+    // acquire 한 credit 을 append 없이 반납 (전송 전 실패)
+    void release(TopicId id) {
+        if (!enabled()) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Stream* s = find(id);
+            if (!s || !s->reserved) return;
+            s->reserved--;
+        }
+        cv_.notify_all();
+    }
+
+    // acquire 성공 후 생성 - commit (append 완료) 없이 scope 를 벗어나면 release
+    class Reservation {
+    public:
+        Reservation(SendWindow& window, TopicId id) : window_(window), id_(id) { }
+        ~Reservation() { if (!committed_) window_.release(id_); }
+
+        Reservation(const Reservation&)            = delete;
+        Reservation& operator=(const Reservation&) = delete;
+
+        void commit() noexcept { committed_ = true; }
+
+    private:
+        SendWindow& window_;
+        TopicId id_;
+        bool committed_ = false;
+    };
+
+    // return: 이번 메시지의 seq, lossless topic 이 아니면 0
+    uint64_t append(TopicId id, std::string_view payload) {
+        if (!enabled()) return 0;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stream* s = find(id);
+        if (!s) return 0;
+
+        if (s->reserved) s->reserved--;
+        uint64_t seq = ++s->head;
+        s->ring.push_back({seq, std::make_shared<const std::string>(payload)});
+        while (s->ring.size() > desc_.window) s->ring.pop_front();
+        stats_.appended++;
+        return seq;
+    }
+
+    // control 요청 처리 (reply server handler) - 잘못된 요청 / lossless 아닌 topic 은 empty
+    // 요청의 topic 은 intern 하지 않고 조회만 (publish 한 적 없는 topic 은 stream 도 없음)
+    std::string handle(const std::string& request) {
+        auto* p   = reinterpret_cast<const uint8_t*>(request.data());
+        auto* end = p + request.size();
+        if (p == end) return {};
+        auto type = static_cast<flow::ControlType>(*p++);
+
+        std::string_view peer, topic;
+        uint64_t a = 0, b = 0;
+        if (type == flow::ControlType::Ack) {
+            if (!flow::getString(p, end, peer) || !flow::getString(p, end, topic) || !wire::getVarint(p, end, a)) return {};
+            return ack(peer, TopicRegistry::instance().find(topic), a);
+        }
+        if (type == flow::ControlType::Nack) {
+            if (!flow::getString(p, end, topic) || !wire::getVarint(p, end, a) || !wire::getVarint(p, end, b)) return {};
+            return nack(TopicRegistry::instance().find(topic), a, b);
+        }
+        return {};
+    }
+
+    const SendWindowStats& stats() const noexcept { return stats_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Peer {
+        uint64_t acked = 0;
+        Clock::time_point last_seen;
+    };
+
+    struct Stream {
+        uint64_t head = 0;                  // 마지막으로 부여한 seq
+        size_t reserved = 0;                // acquire 후 아직 append 되지 않은 수
+        std::deque<std::pair<uint64_t, std::shared_ptr<const std::string>>> ring;
+        std::unordered_map<std::string, Peer> peers;
+    };
+
+    // mutex_ 보유 상태에서 호출 - lossless 가 아닌 topic 은 nullptr (결과 기억)
+    Stream* find(TopicId id) {
+        if (id == NO_TOPIC) return nullptr;
+        auto& slot = streams_.get(id);
+        if (!slot.resolved) {
+            slot.resolved = true;
+            if (router_.match(topicName(id), [](const int&) { }) > 0) slot.stream = std::make_unique<Stream>();
+        }
+        return slot.stream.get();
+    }
+
+    size_t outstanding(const Stream& s) const {
+        if (s.peers.empty()) return 0;
+        uint64_t slowest = UINT64_MAX;
+        for (auto& [id, peer] : s.peers) slowest = std::min(slowest, peer.acked);
+        uint64_t sent = s.head + s.reserved;
+        return sent > slowest ? static_cast<size_t>(sent - slowest) : 0;
+    }
+
+    void expire(Stream& s, Clock::time_point now) {
+        auto limit = std::chrono::milliseconds(desc_.peer_timeout_ms);
+        for (auto it = s.peers.begin(); it != s.peers.end();) {
+            if (now - it->second.last_seen > limit) {
+                it = s.peers.erase(it);
+                stats_.peers--;
+                stats_.evicted++;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    std::string ack(std::string_view peer, TopicId id, uint64_t seq) {
+        std::string out;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Stream* s = find(id);
+            if (!s) return {};
+
+            auto [it, inserted] = s->peers.try_emplace(std::string(peer));
+            if (inserted) {
+                // 처음 ACK 하는 구독자는 그 시점부터 계산 - window 에서 이미 빠진 구간으로 credit 을 막지 않음
+                uint64_t oldest = s->ring.empty() ? s->head : s->ring.front().first - 1;
+                it->second.acked = seq ? std::clamp(seq, oldest, s->head) : s->head;
+                stats_.peers++;
+            } else {
+                it->second.acked = std::max(it->second.acked, std::min(seq, s->head));
+            }
+            it->second.last_seen = Clock::now();
+            wire::putVarint(out, s->head);
+        }
+        stats_.acks++;
+        cv_.notify_all();
+        return out;
+    }
+
+    std::string nack(TopicId id, uint64_t from, uint64_t to) {
+        std::string out;
+        std::vector<std::pair<uint64_t, std::shared_ptr<const std::string>>> items;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Stream* s = find(id);
+            if (!s) return {};
+
+            to = std::min(to, s->head);
+            uint64_t first = s->ring.empty() ? s->head + 1 : s->ring.front().first;
+            if (from < first) stats_.unrecoverable += std::min(to + 1, first) - from;
+            for (auto& entry : s->ring) {
+                if (entry.first < from) continue;
+                if (entry.first > to) break;
+                items.push_back(entry);
+            }
+            wire::putVarint(out, first);
+            wire::putVarint(out, s->head);
+        }
+        for (auto& [seq, payload] : items) {
+            wire::putVarint(out, seq);
+            flow::putString(out, *payload);
+        }
+        stats_.nacks++;
+        stats_.retransmitted += items.size();
+        return out;
+    }
+
+    SendWindowDescriptor desc_;
+    TopicRouter<int> router_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    struct Slot {
+        bool resolved = false;          // lossless 여부를 확인함
+        std::unique_ptr<Stream> stream; // nullptr = lossless 아님
+    };
+
+    TopicSlots<Slot> streams_;
+    SendWindowStats stats_;
+};
+
+
+struct ReliableReceiverDescriptor {
+    std::string peer_id;                // publisher 가 구독자를 구분 (비어 있으면 pid 기반으로 생성)
+    size_t ack_every = 64;              // 이 수만큼 전달할 때마다 ACK (tick 에서도 전송)
+    size_t reorder_max = 4096;          // gap 복구를 기다리며 보관할 topic 당 최대 메시지 수
+    int nack_retry_ms = 200;            // 응답이 없는 NACK 재전송 간격
+};
+
+struct ReliableStats {
+    std::atomic<size_t> delivered{0};
+    std::atomic<size_t> duplicates{0};      // 이미 전달한 seq (재전송과 live 가 겹침)
+    std::atomic<size_t> gaps{0};            // seq 가 건너뛴 횟수
+    std::atomic<size_t> recovered{0};       // 재전송으로 채운 메시지
+    std::atomic<size_t> lost{0};            // 복구하지 못하고 건너뛴 메시지
+    std::atomic<size_t> acks{0};
+    std::atomic<size_t> nacks{0};
+};
+
+
+// ------------------------------------------------------
+// ReliableReceiver - lossless topic 의 구독자 쪽 상태
+//  - topic 별 seq 순서대로 전달, 빠진 구간은 NACK 로 요청하고 그동안 뒤 메시지는 보관
+//  - tick 마다 ACK (publisher credit + 생존 신호), ACK 응답의 head 로 끝부분 유실도 감지
+//  - 전달 순서를 위해 callback 은 내부 lock 안에서 호출 - 짧게 유지
+//  - 한 topic 의 publisher 는 하나라고 가정 (seq 는 publisher 별)
+// ------------------------------------------------------
+class ReliableReceiver : public std::enable_shared_from_this<ReliableReceiver> {
+public:
+    using Callback = std::function<void(const RawMessage&)>;
+    using Reply    = std::function<void(Result<std::string>)>;
+    using Request  = std::function<Result<void>(std::string, Reply)>;     // control endpoint 로 비동기 요청
+
+    ReliableReceiver(ReliableReceiverDescriptor desc, Callback callback, Request request, ReliableStats& stats)
+        : desc_(std::move(desc)), callback_(std::move(callback)), request_(std::move(request)), stats_(stats) {
+        if (desc_.peer_id.empty()) {
+            static std::atomic<uint64_t> next{1};
+            desc_.peer_id = std::to_string(::getpid()) + "-" + std::to_string(next.fetch_add(1));
+        }
+        if (!desc_.ack_every) desc_.ack_every = 1;
+    }
+
+    // live 구독 callback 에서 호출
+    void live(const RawMessage& raw) {
+        std::vector<Op> ops;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!raw.seq) {
+                deliver(raw);
+                return;
+            }
+            // seq 가 붙은 topic 은 stream 상태를 보관하므로 intern (publisher 의 lossless topic 으로 한정)
+            TopicId topic = raw.topic_id ? raw.topic_id : internTopic(raw.topic);
+            if (topic == NO_TOPIC) {
+                deliver(raw);
+                return;
+            }
+            auto& s = streams_[topic];
+            bool first = s.expected == 0;
+            accept(s, retain(raw, topic));
+            if (first || s.since_ack >= desc_.ack_every) ops.push_back(ackOf(topic, s));
+            if (needNack(s)) ops.push_back(nackOf(topic, s, s.held.begin()->first - 1));
+        }
+        send(ops);
+    }
+
+    // 주기적으로 호출 - ACK, 응답 없는 NACK 재전송, 끝부분 유실 감지
+    void tick() {
+        std::vector<Op> ops;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto now = Clock::now();
+            for (auto& [topic, s] : streams_) {
+                if (!s.expected) continue;
+                ops.push_back(ackOf(topic, s));
+
+                if (s.nack_inflight && now - s.nack_at > std::chrono::milliseconds(desc_.nack_retry_ms)) {
+                    s.nack_inflight = false;
+                }
+                if (needNack(s)) {
+                    ops.push_back(nackOf(topic, s, s.held.begin()->first - 1));
+                } else if (!s.nack_inflight && s.held.empty() && s.head >= s.expected && s.head == s.tick_head) {
+                    // 지난 tick 에도 head 가 앞서 있었음 - live 로 오지 않은 끝부분
+                    ops.push_back(nackOf(topic, s, s.head));
+                }
+                s.tick_head = s.head;
+            }
+        }
+        send(ops);
+    }
+
+    const std::string& peerId() const noexcept { return desc_.peer_id; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stream {
+        uint64_t expected = 0;              // 다음에 전달할 seq (0 = 아직 받은 것 없음)
+        uint64_t head = 0;                  // publisher 가 알려준 마지막 seq
+        uint64_t tick_head = 0;
+        std::map<uint64_t, RawMessage> held;    // expected 보다 먼저 도착한 메시지
+        size_t since_ack = 0;
+        bool nack_inflight = false;
+        Clock::time_point nack_at;
+    };
+
+    struct Op {
+        TopicId topic;
+        bool nack;
+        std::string request;
+    };
+
+    // mutex_ 보유 상태에서 호출
+    void deliver(const RawMessage& raw) {
+        callback_(raw);
+        stats_.delivered++;
+    }
+
+    void accept(Stream& s, RawMessage raw, bool recovered = false) {
+        if (!s.expected) s.expected = raw.seq;          // 처음 받은 메시지부터 전달 (이전 이력은 요청하지 않음)
+        if (raw.seq < s.expected || s.held.count(raw.seq)) {
+            stats_.duplicates++;
+            return;
+        }
+        if (raw.seq > s.expected) {
+            if (s.held.empty()) stats_.gaps++;
+            s.held.emplace(raw.seq, std::move(raw));
+            if (s.held.size() > desc_.reorder_max) skipTo(s, s.held.begin()->first);
+            return;
+        }
+        if (recovered) stats_.recovered++;
+        deliver(raw);
+        s.expected++;
+        s.since_ack++;
+        drain(s);
+    }
+
+    void drain(Stream& s) {
+        while (!s.held.empty() && s.held.begin()->first <= s.expected) {
+            auto node = s.held.extract(s.held.begin());
+            if (node.key() == s.expected) {
+                deliver(node.mapped());
+                s.expected++;
+                s.since_ack++;
+            }
+        }
+    }
+
+    // 복구 포기 - seq 까지 건너뜀
+    void skipTo(Stream& s, uint64_t seq) {
+        if (seq <= s.expected) return;
+        stats_.lost += seq - s.expected;
+        s.expected = seq;
+        drain(s);
+    }
+
+    bool needNack(const Stream& s) const {
+        return !s.nack_inflight && !s.held.empty();
+    }
+
+    Op ackOf(TopicId topic, Stream& s) {
+        s.since_ack = 0;
+        return {topic, false, flow::encodeAck(desc_.peer_id, topicName(topic), s.expected - 1)};
+    }
+
+    Op nackOf(TopicId topic, Stream& s, uint64_t to) {
+        s.nack_inflight = true;
+        s.nack_at = Clock::now();
+        return {topic, true, flow::encodeNack(topicName(topic), s.expected, to)};
+    }
+
+    // lock 밖에서 전송 - 응답은 request client thread 에서 처리
+    void send(std::vector<Op>& ops) {
+        std::weak_ptr<ReliableReceiver> self = weak_from_this();
+        for (auto& op : ops) {
+            (op.nack ? stats_.nacks : stats_.acks)++;
+            auto r = request_(std::move(op.request), [self, topic = op.topic, nack = op.nack](Result<std::string> reply) {
+                if (auto rx = self.lock()) rx->onReply(topic, nack, std::move(reply));
+            });
+            if (!r && op.nack) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                streams_[op.topic].nack_inflight = false;
+            }
+        }
+    }
+
+    void onReply(TopicId topic, bool is_nack, Result<std::string> reply) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& s = streams_[topic];
+        if (is_nack) s.nack_inflight = false;
+        if (!reply || reply.value().empty()) return;       // 실패는 다음 tick 에서 다시 요청
+
+        // 재전송 메시지는 응답 버퍼를 그대로 가리킴 (topic 은 registry 의 이름)
+        auto held = std::make_shared<const std::string>(std::move(reply.value()));
+        auto* p   = reinterpret_cast<const uint8_t*>(held->data());
+        auto* end = p + held->size();
+
+        uint64_t first = 0, head = 0;
+        if (is_nack && !wire::getVarint(p, end, first)) return;
+        if (!wire::getVarint(p, end, head)) return;
+        s.head = std::max(s.head, head);
+        if (!is_nack || !s.expected) return;
+
+        // window 를 벗어난 구간은 복구 불가
+        if (first > s.expected) skipTo(s, first);
+        while (p < end) {
+            uint64_t seq;
+            std::string_view payload;
+            if (!wire::getVarint(p, end, seq) || !flow::getString(p, end, payload)) break;
+            accept(s, RawMessage{topicName(topic), payload, held, seq, topic}, true);
+        }
+    }
+
+    // owner 가 없는 메시지는 payload 를 복사해서 보관, topic 은 registry 의 이름
+    RawMessage retain(const RawMessage& raw, TopicId topic) {
+        if (raw.owner) {
+            RawMessage held = raw;
+            held.topic_id = topic;
+            return held;
+        }
+        auto copy = std::make_shared<const std::string>(raw.payloadString());
+        return RawMessage{topicName(topic), *copy, copy, raw.seq, topic};
+    }
+
+    ReliableReceiverDescriptor desc_;
+    Callback callback_;
+    Request request_;
+    ReliableStats& stats_;
+
+    std::mutex mutex_;
+    std::unordered_map<TopicId, Stream> streams_;
+};
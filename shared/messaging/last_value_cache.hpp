@@ -0,0 +1,320 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "result.h"
+#include "raw_message.hpp"
+#include "wire_format.hpp"
+#include "topic_router.hpp"
+#include "topic_registry.hpp"
+
+// NOTE
+// publisher 쪽 - cache 대상 topic 은 마지막 값과 topic 별 seq 를 보관
+//   LastValueCache cache({{"state.#"}});
+//   uint64_t seq = cache.update(internTopic("state.motor"), payload);   // 0 = cache 대상 아님
+//   std::string blob = cache.snapshot("state.#");            // snapshot 요청 응답
+//
+// cache topic 의 live 메시지 = 3 frame  [topic][payload][SEQ frame]
+//   SEQ frame : [0] SEQ_MAGIC 0xB4  [1..8] seq (little endian)
+// snapshot 응답 : [0] SNAPSHOT_MAGIC 0xB5  [1] VERSION 1
+//                 { varint topic len + topic, varint seq, varint payload len + payload } * N
+//
+// subscriber 쪽 - snapshot 과 live 를 seq 로 이어 붙임
+//   SnapshotStitcher stitcher(callback);     // live 구독 callback 에서 stitcher.live(raw)
+//   stitcher.deliverSnapshot(blob);          // snapshot 전달 + 그 사이 받은 live 정리 (blob: shared_ptr<const string>)
+
+namespace lvc {
+
+inline constexpr uint8_t SEQ_MAGIC      = 0xB4;
+inline constexpr uint8_t SNAPSHOT_MAGIC = 0xB5;
+inline constexpr uint8_t VERSION        = 1;
+inline constexpr size_t  SEQ_FRAME_SIZE = 9;
+
+inline void encodeSeq(uint64_t seq, char (&out)[SEQ_FRAME_SIZE]) noexcept {
+    out[0] = static_cast<char>(SEQ_MAGIC);
+    for (int i = 0; i < 8; ++i) out[1 + i] = static_cast<char>((seq >> (8 * i)) & 0xFF);
+}
+
+// return: 0 (SEQ frame 아님)
+inline uint64_t decodeSeq(std::string_view frame) noexcept {
+    if (frame.size() != SEQ_FRAME_SIZE || static_cast<uint8_t>(frame[0]) != SEQ_MAGIC) return 0;
+    uint64_t seq = 0;
+    for (int i = 0; i < 8; ++i) seq |= static_cast<uint64_t>(static_cast<uint8_t>(frame[1 + i])) << (8 * i);
+    return seq;
+}
+
+// fn(std::string_view topic, uint64_t seq, std::string_view payload), return: false (형식 오류)
+template<typename Fn>
+bool forEachSnapshot(std::string_view blob, Fn&& fn) {
+    if (blob.size() < 2 || static_cast<uint8_t>(blob[0]) != SNAPSHOT_MAGIC || static_cast<uint8_t>(blob[1]) != VERSION) {
+        return false;
+    }
+    auto* p   = reinterpret_cast<const uint8_t*>(blob.data()) + 2;
+    auto* end = reinterpret_cast<const uint8_t*>(blob.data()) + blob.size();
+    while (p < end) {
+        uint64_t topic_len, seq, payload_len;
+        if (!wire::getVarint(p, end, topic_len) || topic_len > static_cast<uint64_t>(end - p)) return false;
+        std::string_view topic(reinterpret_cast<const char*>(p), topic_len);
+        p += topic_len;
+        if (!wire::getVarint(p, end, seq)) return false;
+        if (!wire::getVarint(p, end, payload_len) || payload_len > static_cast<uint64_t>(end - p)) return false;
+        fn(topic, seq, std::string_view(reinterpret_cast<const char*>(p), payload_len));
+        p += payload_len;
+    }
+    return true;
+}
+
+} // namespace lvc
+
+
+struct LastValueCacheDescriptor {
+    std::vector<std::string> topics;    // cache 대상 topic pattern (topic_router.hpp 문법)
+    size_t max_topics = 65536;          // 넘으면 새 topic 은 cache 하지 않음 (seq 도 붙지 않음)
+};
+
+struct LastValueCacheStats {
+    std::atomic<size_t> updates{0};
+    std::atomic<size_t> topics{0};          // 현재 cache 된 topic 수
+    std::atomic<size_t> overflow{0};        // max_topics 초과로 cache 하지 못한 publish
+    std::atomic<size_t> snapshots{0};       // snapshot 요청 수
+    std::atomic<size_t> snapshot_entries{0};
+};
+
+
+// ------------------------------------------------------
+// LastValueCache - topic 별 마지막 payload + 단조 증가 seq
+//  - seq 는 topic 별 1 부터 증가, 같은 topic 의 publish 순서와 일치해야 하므로
+//    update 는 실제 전송과 같은 lock 안에서 호출 (ZmqMessageBus::pub_mutex_)
+//  - snapshot 은 payload 를 shared_ptr 로 잡고 lock 밖에서 encode
+//  - entry 는 TopicId 로 index (intern 되지 않은 topic 은 cache 하지 않음)
+// ------------------------------------------------------
+class LastValueCache {
+public:
+    explicit LastValueCache(LastValueCacheDescriptor desc = {}) : desc_(std::move(desc)) {
+        for (auto& pattern : desc_.topics) {
+            if (topic::validate(pattern)) router_.add(pattern, 0);
+        }
+    }
+
+    bool enabled() const noexcept { return !desc_.topics.empty(); }
+
+    // seq: 이미 부여된 seq (lossless topic 등) 가 있으면 그대로 사용
+    // return: 이번 publish 의 seq, cache 대상이 아니면 seq 그대로
+    uint64_t update(TopicId id, std::string_view payload, uint64_t seq = 0) {
+        if (!enabled() || id == NO_TOPIC) return seq;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& e = entries_.get(id);
+        if (!e.resolved) {
+            bool cached = router_.match(topicName(id), [](const int&) { }) > 0;
+            if (cached && stats_.topics.load(std::memory_order_relaxed) >= desc_.max_topics) {
+                stats_.overflow++;
+                return seq;
+            }
+            e.resolved = true;
+            e.cached   = cached;
+            if (cached) stats_.topics++;
+        }
+        if (!e.cached) return seq;
+
+        e.payload = std::make_shared<const std::string>(payload);
+        e.seq = seq ? seq : e.seq + 1;
+        stats_.updates++;
+        return e.seq;
+    }
+
+    // pattern 에 일치하는 모든 topic 의 마지막 값 (빈 pattern = 전부)
+    // return: InvalidArgument (잘못된 pattern)
+    Result<std::string> snapshot(std::string_view pattern) const {
+        if (!pattern.empty()) {
+            if (auto v = topic::validate(pattern); !v) return Result<std::string>::Error(v.code(), v.error());
+        }
+        TopicRouter<int> filter;
+        if (!pattern.empty()) filter.add(pattern, 0);
+
+        struct Item {
+            std::string_view topic;
+            uint64_t seq;
+            std::shared_ptr<const std::string> payload;
+        };
+        std::vector<Item> items;
+        {
+            // topic 이름은 registry 가 보관하므로 lock 밖에서도 유효
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_.forEach([&](TopicId id, const Entry& e) {
+                if (!e.payload) return;
+                std::string_view topic = topicName(id);
+                if (!pattern.empty() && !filter.match(topic, [](const int&) { })) return;
+                items.push_back({topic, e.seq, e.payload});
+            });
+        }
+
+        std::string out;
+        out.push_back(static_cast<char>(lvc::SNAPSHOT_MAGIC));
+        out.push_back(static_cast<char>(lvc::VERSION));
+        for (auto& item : items) {
+            wire::putVarint(out, item.topic.size());
+            out.append(item.topic.data(), item.topic.size());
+            wire::putVarint(out, item.seq);
+            wire::putVarint(out, item.payload->size());
+            out.append(*item.payload);
+        }
+        stats_.snapshots++;
+        stats_.snapshot_entries += items.size();
+        return Result<std::string>::OK(std::move(out));
+    }
+
+    const LastValueCacheStats& stats() const noexcept { return stats_; }
+
+private:
+    struct Entry {
+        bool resolved = false;              // pattern 매칭 결과를 기억함
+        bool cached = false;
+        uint64_t seq = 0;
+        std::shared_ptr<const std::string> payload;
+    };
+
+    LastValueCacheDescriptor desc_;
+    TopicRouter<int> router_;
+    mutable std::mutex mutex_;
+    TopicSlots<Entry> entries_;                 // cached == false 는 pattern 매칭 결과만 기억
+    mutable LastValueCacheStats stats_;
+};
+
+
+struct SnapshotStats {
+    std::atomic<size_t> snapshot{0};        // snapshot 으로 전달한 값
+    std::atomic<size_t> buffered{0};        // snapshot 을 기다리는 동안 보관한 live 메시지
+    std::atomic<size_t> duplicates{0};      // snapshot 보다 오래된 live 메시지 (버림)
+    std::atomic<size_t> gaps{0};            // snapshot 과 첫 live 사이에 빠진 seq 가 있는 topic
+};
+
+
+// ------------------------------------------------------
+// SnapshotStitcher - late joiner 가 snapshot 이후 live 를 중복 / 역순 없이 받도록 연결
+//  1) live 구독을 먼저 걸고 live() 로 전달 - snapshot 전에는 보관만 함
+//  2) snapshot 을 받아 deliverSnapshot() - topic 별 seq 기록 후 값 전달
+//  3) 보관한 live 를 전달 (seq <= snapshot seq 는 버림), 이후에는 바로 전달
+//  seq 가 없는 메시지 (0) 는 비교 없이 전달
+// ------------------------------------------------------
+class SnapshotStitcher {
+public:
+    using Callback = std::function<void(const RawMessage&)>;
+
+    explicit SnapshotStitcher(Callback callback) : callback_(std::move(callback)) { }
+
+    // live 구독 callback 에서 호출
+    void live(const RawMessage& raw) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!ready_) {
+                pending_.push_back(retain(raw));
+                stats_.buffered++;
+                return;
+            }
+            if (!accept(raw)) return;
+        }
+        callback_(raw);
+    }
+
+    // snapshot 요청이 실패해도 호출 (blob 이 비어 있으면 보관한 live 만 전달)
+    //  전달하는 RawMessage 는 blob 을 owner 로 가짐 (callback 밖에서 보관 가능)
+    // return: false (형식 오류 - 그때까지 읽은 값은 전달됨)
+    bool deliverSnapshot(std::shared_ptr<const std::string> blob) {
+        bool ok = true;
+        if (blob && !blob->empty()) {
+            std::vector<RawMessage> values;
+            ok = lvc::forEachSnapshot(*blob, [&](std::string_view topic, uint64_t seq, std::string_view payload) {
+                TopicId id = internTopic(topic);
+                // intern 된 이름은 process 수명 동안 유효
+                values.push_back(RawMessage{id != NO_TOPIC ? topicName(id) : topic, payload, blob, seq, id});
+            });
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (auto& v : values) {
+                    if (v.topic_id != NO_TOPIC) last_[v.topic_id] = Seq{v.seq, true};
+                }
+            }
+            for (auto& v : values) {
+                stats_.snapshot++;
+                callback_(v);
+            }
+        }
+        finish();
+        return ok;
+    }
+
+    const SnapshotStats& stats() const noexcept { return stats_; }
+
+private:
+    struct Seq {
+        uint64_t seq = 0;
+        bool from_snapshot = false;         // 아직 첫 live 를 받지 않음 (gap 검사)
+    };
+
+    // 보관한 live 를 모두 전달하고 빈 상태에서 ready 로 전환 (전달 중 도착한 것도 순서대로)
+    void finish() {
+        for (;;) {
+            std::deque<RawMessage> batch;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (pending_.empty()) {
+                    ready_ = true;
+                    return;
+                }
+                batch.swap(pending_);
+            }
+            for (auto& raw : batch) {
+                bool deliver;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    deliver = accept(raw);
+                }
+                if (deliver) callback_(raw);
+            }
+        }
+    }
+
+    // mutex_ 보유 상태에서 호출
+    bool accept(const RawMessage& raw) {
+        if (!raw.seq) return true;
+        // seq 가 붙은 topic (publisher 의 cache / lossless topic) 만 여기까지 옴 - topic 별 seq 를 보관하므로 intern
+        TopicId id = raw.topic_id ? raw.topic_id : internTopic(raw.topic);
+        if (id == NO_TOPIC) return true;
+        auto it = last_.find(id);
+        if (it == last_.end()) {
+            last_.emplace(id, Seq{raw.seq, false});
+            return true;
+        }
+        auto& s = it->second;
+        if (raw.seq <= s.seq) {
+            stats_.duplicates++;
+            return false;
+        }
+        if (s.from_snapshot && raw.seq > s.seq + 1) stats_.gaps++;
+        s = Seq{raw.seq, false};
+        return true;
+    }
+
+    static RawMessage retain(const RawMessage& raw) {
+        if (raw.owner) return raw;
+        auto copy = std::make_shared<const std::pair<std::string, std::string>>(raw.topicString(), raw.payloadString());
+        return RawMessage{copy->first, copy->second, copy, raw.seq, raw.topic_id};
+    }
+
+    Callback callback_;
+    std::mutex mutex_;
+    bool ready_ = false;
+    std::deque<RawMessage> pending_;
+    std::unordered_map<TopicId, Seq> last_;
+    SnapshotStats stats_;
+};
@@ -1,10 +1,13 @@
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <functional>
 #include <vector>
 
 #include "result.h"
+#include "message.hpp"
 
 
 class MessageSubscription {
@@ -20,10 +23,23 @@ public:
     // PUB
     virtual Result<void> publish(const std::string& topic, const std::string& msg) = 0;
 
+    // 소유권 이전 publish - transport 가 지원하면 payload 를 복사하지 않음 (기본: 복사)
+    virtual Result<void> publish(const std::string& topic, std::string&& msg) {
+        return publish(topic, static_cast<const std::string&>(msg));
+    }
+    virtual Result<void> publish(const std::string& topic, std::vector<uint8_t>&& msg) {
+        return publish(topic, std::string(msg.begin(), msg.end()));
+    }
+    // payload 는 owner 가 해제될 때까지 유효 (pool buffer, 수신한 RawMessage 재전송 등)
+    virtual Result<void> publish(const std::string& topic, std::string_view payload,
+                                 [[maybe_unused]] std::shared_ptr<const void> owner) {
+        return publish(topic, std::string(payload));
+    }
+
     // SUB
     virtual std::unique_ptr<MessageSubscription> subscribe(
         const std::string& topic,
-        std::function<void(const Message&)> callback) = 0;
+        std::function<void(const message::Message&)> callback) = 0;
 
     // REQ/REP
     virtual std::string request(const std::string& endpoint, const std::string& msg) = 0;
@@ -1,62 +1,221 @@
-
-
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 #include <nlohmann/json.hpp>
 using json = nlohmann::json;
 
 #include "message.hpp"
+#include "wire_format.hpp"
+#include "raw_message.hpp"
+
+// NOTE
+// std::string payload = message::serialize(msg);            // topic 별 codec (기본 Binary)
+// auto msg = message::deserialize(topic, payload);          // Binary / JSON 자동 판별
+//
+// message::setTopicCodec("debug.", message::Codec::Json);   // "debug." 로 시작하는 topic 은 JSON
 
 namespace message
 {
 
-std::string serialize(const Message& msg) {
-    json j;
+enum class Codec {
+    Binary,
+    Json,           // 디버깅용 (사람이 읽을 수 있음)
+};
 
-    for (auto& [key, val] : msg.values) {
-        if (val.type() == typeid(int)) {
-            j[key] = std::any_cast<int>(val);
+// ------------------------------------------------------
+// topic prefix 별 codec 선택 (가장 긴 prefix 우선)
+// ------------------------------------------------------
+class CodecSelector {
+public:
+    static CodecSelector& instance() {
+        static CodecSelector selector;
+        return selector;
+    }
+
+    void set(const std::string& topic_prefix, Codec codec) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (auto& r : rules_) {
+            if (r.first == topic_prefix) {
+                r.second = codec;
+                return;
+            }
         }
-        else if (val.type() == typeid(double)) {
-            j[key] = std::any_cast<double>(val);
+        rules_.emplace_back(topic_prefix, codec);
+        has_rules_.store(true, std::memory_order_release);
+    }
+
+    void setDefault(Codec codec) noexcept { default_.store(codec, std::memory_order_relaxed); }
+
+    Codec codecFor(std::string_view topic) const {
+        if (!has_rules_.load(std::memory_order_acquire)) return default_.load(std::memory_order_relaxed);
+
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        size_t best_len = 0;
+        Codec best = default_.load(std::memory_order_relaxed);
+        for (auto& [prefix, codec] : rules_) {
+            if (prefix.size() >= best_len && topic.substr(0, prefix.size()) == prefix) {
+                best_len = prefix.size();
+                best = codec;
+            }
         }
-        else if (val.type() == typeid(bool)) {
-            j[key] = std::any_cast<bool>(val);
+        return best;
+    }
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::vector<std::pair<std::string, Codec>> rules_;
+    std::atomic<bool> has_rules_{false};
+    std::atomic<Codec> default_{Codec::Binary};
+};
+
+inline void setTopicCodec(const std::string& topic_prefix, Codec codec) {
+    CodecSelector::instance().set(topic_prefix, codec);
+}
+
+
+// ------------------------------------------------------
+// Binary codec
+// ------------------------------------------------------
+inline void serializeBinary(const Message& msg, std::string& out) {
+    wire::WireWriter w(out, static_cast<uint32_t>(msg.size()));
+
+    for (auto& f : msg) {
+        const std::string_view key = f.name();
+        switch (f.type()) {
+        case ValueType::Int:    w.putInt(key, std::get<int64_t>(f.value));                  break;
+        case ValueType::Double: w.putDouble(key, std::get<double>(f.value));                break;
+        case ValueType::Bool:   w.putBool(key, std::get<bool>(f.value));                    break;
+        case ValueType::String: w.putString(key, std::get<std::string_view>(f.value));      break;
+        case ValueType::Bytes: {
+            auto b = std::get<Bytes>(f.value);
+            w.putBytes(key, b.data, b.size);
+            break;
         }
-        else if (val.type() == typeid(std::string)) {
-            j[key] = std::any_cast<std::string>(val);
+        case ValueType::Null:
+            throw std::runtime_error("Null value in Message: " + std::string(key));
+        }
+    }
+}
+
+// owner 가 주어지면 문자열 / bytes 는 payload 를 그대로 가리킴 (복사 없음)
+inline Message deserializeBinary(std::string_view topic, std::string_view payload,
+                                 std::shared_ptr<const void> owner = nullptr) {
+    Message msg;
+    msg.topic = topic;
+
+    wire::WireReader r(payload);
+    msg.reserve(r.count());
+
+    wire::WireField f;
+    while (r.next(f)) {
+        Key k = key(f.name);
+        switch (f.type) {
+        case wire::WireType::Int:
+            msg.set(k, f.i);
+            break;
+        case wire::WireType::Double:
+            msg.set(k, f.d);
+            break;
+        case wire::WireType::False:
+        case wire::WireType::True:
+            msg.set(k, f.boolean());
+            break;
+        case wire::WireType::String:
+            if (owner) msg.setView(k, f.bytes);
+            else       msg.set(k, f.bytes);
+            break;
+        case wire::WireType::Bytes: {
+            Bytes b{reinterpret_cast<const uint8_t*>(f.bytes.data()), f.bytes.size()};
+            if (owner) msg.setView(k, b);
+            else       msg.set(k, b);
+            break;
         }
-        else {
-            // 지원하지 않는 타입 (원한다면 base64 또는 binary 처리)
-            throw std::runtime_error("Unsupported type in Message::values");
+        }
+    }
+    if (!r.ok()) {
+        throw std::runtime_error(std::string("binary message decode failed: ") + r.error());
+    }
+    if (owner) msg.retain(std::move(owner));
+    return msg;
+}
+
+
+// ------------------------------------------------------
+// JSON codec (debug)
+// ------------------------------------------------------
+inline std::string serializeJson(const Message& msg) {
+    json j = json::object();
+
+    for (auto& f : msg) {
+        std::string key(f.name());
+        switch (f.type()) {
+        case ValueType::Int:    j[key] = std::get<int64_t>(f.value);                        break;
+        case ValueType::Double: j[key] = std::get<double>(f.value);                         break;
+        case ValueType::Bool:   j[key] = std::get<bool>(f.value);                           break;
+        case ValueType::String: j[key] = std::string(std::get<std::string_view>(f.value));  break;
+        default:
+            // 지원하지 않는 타입 (bytes 는 binary codec 사용)
+            throw std::runtime_error("Unsupported type in Message: " + key);
         }
     }
 
     return j.dump(); // JSON 문자열로 변환
 }
 
-
-Message deserialize(const std::string& topic, const std::string& payload) {
+inline Message deserializeJson(std::string_view topic, std::string_view payload) {
     Message msg;
     msg.topic = topic;
 
     json j = json::parse(payload);
 
-    for (auto& [key, val] : j.items()) {
+    for (auto& [name, val] : j.items()) {
         if (val.is_number_integer()) {
-            msg.values[key] = val.get<int>();
+            msg.set(name, val.get<int64_t>());
         }
         else if (val.is_number_float()) {
-            msg.values[key] = val.get<double>();
+            msg.set(name, val.get<double>());
         }
         else if (val.is_boolean()) {
-            msg.values[key] = val.get<bool>();
+            msg.set(name, val.get<bool>());
         }
         else if (val.is_string()) {
-            msg.values[key] = val.get<std::string>();
+            msg.set(name, val.get_ref<const std::string&>());
         }
     }
 
     return msg;
 }
 
-} // namespace message
 
+// ------------------------------------------------------
+// topic 별 codec 으로 인코딩, 디코딩은 첫 byte 로 자동 판별
+// ------------------------------------------------------
+inline std::string serialize(const Message& msg, Codec codec) {
+    if (codec == Codec::Json) return serializeJson(msg);
+    std::string out;
+    serializeBinary(msg, out);
+    return out;
+}
+
+inline std::string serialize(const Message& msg) {
+    return serialize(msg, CodecSelector::instance().codecFor(msg.topic));
+}
+
+inline Message deserialize(std::string_view topic, std::string_view payload) {
+    if (wire::WireReader::isBinary(payload)) return deserializeBinary(topic, payload);
+    return deserializeJson(topic, payload);
+}
+
+// 수신 버퍼를 참조하는 Message (binary 는 문자열 복사 없음, 버퍼는 Message 가 보관)
+inline Message deserialize(const RawMessage& raw) {
+    if (wire::WireReader::isBinary(raw.payload)) return deserializeBinary(raw.topic, raw.payload, raw.owner);
+    return deserializeJson(raw.topic, raw.payload);
+}
+
+} // namespace message
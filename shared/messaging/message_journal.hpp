@@ -0,0 +1,755 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "result.h"
+#include "logging.hpp"
+#include "raw_message.hpp"
+#include "wire_format.hpp"
+#include "topic_router.hpp"
+#include "topic_registry.hpp"
+
+// NOTE
+// bus 메시지 journal - append only, segment file 단위 mmap
+//
+//   <directory>/<name>.<number 8 자리>.jnl   segment (segment_bytes 로 미리 할당, seal 시 사용한 크기로 줄임)
+//   <directory>/<name>.<number 8 자리>.idx   seal 시 기록하는 topic / 시간 index (없으면 reader 가 scan 해서 생성)
+//
+// 기록 (ZmqMessageBus 가 publish 마다 호출 - d.journal_directory / d.journal_topics)
+//   JournalWriterDescriptor d;
+//   d.directory = "/var/lib/app/journal";
+//   d.topics    = {"cmd.#", "state.#"};        // 비어 있으면 전부 기록
+//   auto w = JournalWriter::create(d);
+//   w.value()->append(internTopic(topic), payload, seq);
+//
+// 읽기 / 재생
+//   auto r = JournalReader::open("/var/lib/app/journal");
+//   JournalRange range;
+//   range.topic = "state.#";
+//   r.value()->read(range, [&](const JournalRecord& rec) { restore(rec.message); return true; });   // warm restart
+//   r.value()->replay(range, 2.0, [&](const JournalRecord& rec) { ...; return true; });           // 2 배속
+//
+// - 기록 시각은 system_clock (ns) - 같은 journal 안에서는 감소하지 않도록 보정
+// - 다른 process 가 기록 중인 segment 도 읽을 수 있음 (open 시점의 write_pos 까지)
+// - process 가 죽어도 mmap 에 쓴 내용은 남음 - 다음 writer 가 index 가 없는 segment 를 seal
+
+namespace journal {
+
+inline constexpr uint32_t MAGIC          = 0x4A524E4C;     // "JRNL"
+inline constexpr uint32_t INDEX_MAGIC    = 0x4A524E49;     // "JRNI"
+inline constexpr uint32_t VERSION        = 1;
+inline constexpr size_t   RECORD_ALIGN   = 8;
+inline constexpr size_t   INDEX_INTERVAL = 64 << 10;      // reader 가 index 를 만들 때의 mark 간격
+
+struct SegmentHeader {
+    std::atomic<uint32_t> magic{0};         // 초기화 완료 후 마지막에 기록
+    uint32_t version = VERSION;
+    uint64_t number = 0;
+    uint64_t capacity = 0;                  // file 크기
+    int32_t  writer_pid = 0;
+    uint32_t reserved = 0;
+    std::atomic<uint64_t> write_pos{0};     // 커밋된 마지막 record 의 끝 (file offset)
+    std::atomic<uint64_t> records{0};
+};
+
+inline constexpr size_t DATA_OFFSET = 64;
+static_assert(sizeof(SegmentHeader) <= DATA_OFFSET, "segment header too large");
+
+struct RecordHeader {
+    uint32_t size;              // header 포함 record 전체 크기 (RECORD_ALIGN 배수)
+    uint32_t topic_len;
+    uint32_t payload_len;
+    uint32_t flags;
+    int64_t  time_ns;           // 기록 시각 (system_clock, epoch 기준)
+    uint64_t seq;               // publish seq (lossless / last-value cache topic, 아니면 0)
+};
+
+inline size_t alignRecord(size_t n) { return (n + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1); }
+
+inline int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+inline std::string segmentPath(const std::string& dir, const std::string& name, uint64_t number, const char* ext) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), ".%08llu.", static_cast<unsigned long long>(number));
+    return dir + "/" + name + buf + ext;
+}
+
+// dir 안의 <name>.<number>.jnl 번호 (오름차순)
+inline std::vector<uint64_t> listSegments(const std::string& dir, const std::string& name) {
+    std::vector<uint64_t> numbers;
+    DIR* d = ::opendir(dir.c_str());
+    if (!d) return numbers;
+    const std::string prefix = name + ".";
+    while (auto* e = ::readdir(d)) {
+        std::string_view f(e->d_name);
+        if (f.size() != prefix.size() + 12 || f.compare(0, prefix.size(), prefix) != 0 ||
+            f.compare(f.size() - 4, 4, ".jnl") != 0) {
+            continue;
+        }
+        auto digits = f.substr(prefix.size(), 8);
+        if (!std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) continue;
+        numbers.push_back(std::stoull(std::string(digits)));
+    }
+    ::closedir(d);
+    std::sort(numbers.begin(), numbers.end());
+    return numbers;
+}
+
+inline bool processAlive(int32_t pid) {
+    return pid > 0 && (::kill(pid, 0) == 0 || errno == EPERM);
+}
+
+// 이 process 에서 writer 가 열려있는 journal (directory/name)
+//  segment 의 writer_pid 가 자신의 pid 인 경우 (같은 process 의 두 번째 writer / 재사용된 pid) 구분용
+class WriterRegistry {
+public:
+    static WriterRegistry& instance() {
+        static WriterRegistry registry;
+        return registry;
+    }
+
+    static std::string keyOf(const std::string& directory, const std::string& name) {
+        char buf[PATH_MAX];
+        std::string dir = ::realpath(directory.c_str(), buf) ? std::string(buf) : directory;
+        return dir + "/" + name;
+    }
+
+    bool acquire(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return keys_.insert(key).second;
+    }
+
+    void release(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        keys_.erase(key);
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_set<std::string> keys_;
+};
+
+// ------------------------------------------------------
+// SegmentIndex - segment 하나의 topic 목록 / 시간 범위 / 시간 -> offset mark
+// ------------------------------------------------------
+struct SegmentIndex {
+    uint64_t number = 0;
+    int64_t  first_ns = 0;
+    int64_t  last_ns = 0;
+    uint64_t records = 0;
+    uint64_t end = DATA_OFFSET;                         // 마지막 record 의 끝
+    std::map<std::string, uint64_t, std::less<>> topics;    // topic -> record 수
+    std::vector<std::pair<int64_t, uint64_t>> marks;    // (time_ns, offset) - 시간 순
+
+    void add(int64_t time_ns, uint64_t offset, uint64_t size, size_t interval) {
+        if (!records) first_ns = time_ns;
+        if (marks.empty() || offset - marks.back().second >= interval) marks.emplace_back(time_ns, offset);
+        last_ns = time_ns;
+        records++;
+        end = offset + size;
+    }
+
+    void count(std::string_view topic, uint64_t n = 1) {
+        auto it = topics.find(topic);
+        if (it == topics.end()) it = topics.emplace(std::string(topic), 0).first;
+        it->second += n;
+    }
+
+    // from_ns 이전 record 를 건너뛸 수 있는 시작 offset
+    uint64_t seek(int64_t from_ns) const {
+        uint64_t offset = DATA_OFFSET;
+        for (auto& [t, o] : marks) {
+            if (t >= from_ns) break;
+            offset = o;
+        }
+        return offset;
+    }
+
+    std::string encode() const {
+        std::string out;
+        uint32_t magic = INDEX_MAGIC;
+        out.append(reinterpret_cast<const char*>(&magic), sizeof(magic));
+        out.push_back(static_cast<char>(VERSION));
+        wire::putVarint(out, number);
+        wire::putVarint(out, wire::zigzagEncode(first_ns));
+        wire::putVarint(out, wire::zigzagEncode(last_ns));
+        wire::putVarint(out, records);
+        wire::putVarint(out, end);
+        wire::putVarint(out, topics.size());
+        for (auto& [topic, count] : topics) {
+            wire::putVarint(out, topic.size());
+            out.append(topic);
+            wire::putVarint(out, count);
+        }
+        wire::putVarint(out, marks.size());
+        for (auto& [t, o] : marks) {
+            wire::putVarint(out, wire::zigzagEncode(t));
+            wire::putVarint(out, o);
+        }
+        return out;
+    }
+
+    static bool decode(std::string_view in, SegmentIndex& out) {
+        uint32_t magic = 0;
+        if (in.size() < sizeof(magic) + 1) return false;
+        std::memcpy(&magic, in.data(), sizeof(magic));
+        if (magic != INDEX_MAGIC || static_cast<uint8_t>(in[sizeof(magic)]) != VERSION) return false;
+
+        auto* p   = reinterpret_cast<const uint8_t*>(in.data()) + sizeof(magic) + 1;
+        auto* end = reinterpret_cast<const uint8_t*>(in.data()) + in.size();
+        uint64_t first, last, count;
+        if (!wire::getVarint(p, end, out.number) || !wire::getVarint(p, end, first) || !wire::getVarint(p, end, last) ||
+            !wire::getVarint(p, end, out.records) || !wire::getVarint(p, end, out.end) || !wire::getVarint(p, end, count)) {
+            return false;
+        }
+        out.first_ns = wire::zigzagDecode(first);
+        out.last_ns  = wire::zigzagDecode(last);
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t len, n;
+            if (!wire::getVarint(p, end, len) || len > static_cast<uint64_t>(end - p)) return false;
+            std::string topic(reinterpret_cast<const char*>(p), len);
+            p += len;
+            if (!wire::getVarint(p, end, n)) return false;
+            out.topics.emplace(std::move(topic), n);
+        }
+        if (!wire::getVarint(p, end, count)) return false;
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t t, o;
+            if (!wire::getVarint(p, end, t) || !wire::getVarint(p, end, o)) return false;
+            out.marks.emplace_back(wire::zigzagDecode(t), o);
+        }
+        return true;
+    }
+};
+
+// ------------------------------------------------------
+// Segment - segment file mmap (reader 가 보관 중인 RawMessage 가 참조)
+// ------------------------------------------------------
+class Segment {
+public:
+    Segment(void* addr, size_t size) : addr_(addr), size_(size) { }
+    ~Segment() { if (addr_) ::munmap(addr_, size_); }
+
+    Segment(const Segment&)            = delete;
+    Segment& operator=(const Segment&) = delete;
+
+    SegmentHeader* header() const noexcept { return static_cast<SegmentHeader*>(addr_); }
+    uint8_t* base() const noexcept { return static_cast<uint8_t*>(addr_); }
+    size_t size() const noexcept { return size_; }
+
+    // create: capacity 크기로 새로 만듦 (이미 있으면 AlreadyExists)
+    static Result<std::shared_ptr<Segment>> open(const std::string& path, bool create, uint64_t capacity = 0) {
+        using R = Result<std::shared_ptr<Segment>>;
+        int fd = create ? ::open(path.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0640)
+                        : ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            ResultCode code = errno == ENOENT ? ResultCode::NotFound
+                            : errno == EEXIST ? ResultCode::AlreadyExists
+                            : errno == EACCES ? ResultCode::PermissionDenied
+                            : ResultCode::InternalError;
+            return R::Error(code, path + ": " + std::strerror(errno));
+        }
+        if (create && ::ftruncate(fd, static_cast<off_t>(capacity)) != 0) {
+            int err = errno;
+            ::close(fd);
+            ::unlink(path.c_str());
+            return R::Error(ResultCode::InternalError, path + ": " + std::strerror(err));
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < DATA_OFFSET) {
+            ::close(fd);
+            return R::Error(ResultCode::InvalidState, path + ": not a journal segment");
+        }
+        size_t size = static_cast<size_t>(st.st_size);
+        void* addr = ::mmap(nullptr, size, create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) return R::Error(ResultCode::InternalError, path + ": mmap failed");
+
+        auto seg = std::make_shared<Segment>(addr, size);
+        if (!create && (seg->header()->magic.load(std::memory_order_acquire) != MAGIC ||
+                        seg->header()->version != VERSION)) {
+            return R::Error(ResultCode::InvalidState, path + ": not a journal segment");
+        }
+        return R::OK(std::move(seg));
+    }
+
+    // fn(offset, const RecordHeader&) 를 [from, write_pos) 의 record 마다 호출 - false 면 중단
+    // return: false (손상된 record - 그 앞까지만 유효)
+    template<typename Fn>
+    bool forEach(uint64_t from, Fn&& fn) const {
+        uint64_t end = std::min<uint64_t>(header()->write_pos.load(std::memory_order_acquire), size_);
+        uint64_t pos = std::max<uint64_t>(from, DATA_OFFSET);
+        while (pos + sizeof(RecordHeader) <= end) {
+            auto* rh = reinterpret_cast<const RecordHeader*>(base() + pos);
+            if (rh->size < sizeof(RecordHeader) || rh->size > end - pos ||
+                static_cast<uint64_t>(rh->topic_len) + rh->payload_len > rh->size - sizeof(RecordHeader)) {
+                return false;
+            }
+            if (!fn(pos, *rh)) return true;
+            pos += rh->size;
+        }
+        return true;
+    }
+
+    // index 파일이 없을 때 (seal 전에 종료된 segment, 기록 중인 segment)
+    SegmentIndex scan() const {
+        SegmentIndex index;
+        index.number = header()->number;
+        forEach(DATA_OFFSET, [&](uint64_t offset, const RecordHeader& rh) {
+            index.add(rh.time_ns, offset, rh.size, INDEX_INTERVAL);
+            index.count(std::string_view(reinterpret_cast<const char*>(&rh + 1), rh.topic_len));
+            return true;
+        });
+        return index;
+    }
+
+private:
+    void* addr_;
+    size_t size_;
+};
+
+inline Result<void> writeFile(const std::string& path, const std::string& data) {
+    std::string tmp = path + ".tmp";
+    int fd = ::open(tmp.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0640);
+    if (fd < 0) return Error(ResultCode::InternalError, tmp + ": " + std::strerror(errno));
+    bool ok = ::write(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size());
+    ::close(fd);
+    if (!ok || ::rename(tmp.c_str(), path.c_str()) != 0) {
+        ::unlink(tmp.c_str());
+        return Error(ResultCode::InternalError, path + ": write failed");
+    }
+    return OK();
+}
+
+inline bool readFile(const std::string& path, std::string& out) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    char buf[64 << 10];
+    ssize_t n;
+    while ((n = ::read(fd, buf, sizeof(buf))) > 0) out.append(buf, static_cast<size_t>(n));
+    ::close(fd);
+    return n == 0;
+}
+
+// index 를 기록하고 file 을 사용한 크기로 줄임 - writer 가 없는 segment 만
+inline Result<void> seal(const std::string& dir, const std::string& name, const SegmentIndex& index) {
+    auto r = writeFile(segmentPath(dir, name, index.number, "idx"), index.encode());
+    if (!r) return r;
+    if (::truncate(segmentPath(dir, name, index.number, "jnl").c_str(), static_cast<off_t>(index.end)) != 0) {
+        return Error(ResultCode::InternalError, "truncate segment failed: " + std::string(std::strerror(errno)));
+    }
+    return OK();
+}
+
+} // namespace journal
+
+
+struct JournalWriterDescriptor {
+    std::string directory;              // 미리 만들어 둔 directory
+    std::string name = "bus";           // segment file 이름 prefix (같은 directory 에 writer 하나)
+    std::vector<std::string> topics;    // 기록할 topic pattern (비어 있으면 전부)
+    size_t segment_bytes = 64 << 20;    // segment file 크기 (record 하나의 최대 크기이기도 함)
+    size_t index_interval = 64 << 10;   // 이 byte 마다 시간 mark (읽기 시작 위치 탐색)
+    size_t max_segments = 0;            // 넘으면 오래된 segment 삭제 (0 = 무제한)
+};
+
+struct JournalStats {
+    std::atomic<size_t> records{0};
+    std::atomic<size_t> bytes{0};           // record header 포함
+    std::atomic<size_t> filtered{0};        // topic filter 에 걸려 기록하지 않음
+    std::atomic<size_t> segments{0};        // 만든 segment 수
+    std::atomic<size_t> removed{0};         // max_segments 로 삭제한 segment 수
+    std::atomic<size_t> errors{0};
+};
+
+// ------------------------------------------------------
+// JournalWriter - 한 process 의 한 객체만 같은 directory / name 에 기록 (내부 lock)
+// ------------------------------------------------------
+class JournalWriter {
+public:
+    static Result<std::unique_ptr<JournalWriter>> create(JournalWriterDescriptor desc) {
+        using R = Result<std::unique_ptr<JournalWriter>>;
+        if (desc.directory.empty()) return R::Error(ResultCode::InvalidArgument, "journal directory is empty");
+        if (desc.segment_bytes < 4096) return R::Error(ResultCode::InvalidArgument, "journal segment must be >= 4096 bytes");
+        for (auto& pattern : desc.topics) {
+            auto v = topic::validate(pattern);
+            if (!v) return R::Error(v.code(), v.error());
+        }
+        struct stat st{};
+        if (::stat(desc.directory.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+            return R::Error(ResultCode::NotFound, "journal directory not found: " + desc.directory);
+        }
+
+        auto key = journal::WriterRegistry::keyOf(desc.directory, desc.name);
+        if (!journal::WriterRegistry::instance().acquire(key)) {
+            return R::Error(ResultCode::AlreadyExists, "journal already has a writer in this process: " + key);
+        }
+
+        std::unique_ptr<JournalWriter> w(new JournalWriter(std::move(desc)));
+        w->key_ = std::move(key);
+        auto r = w->recover();
+        if (!r) return R::Error(r.code(), r.error());
+        return R::OK(std::move(w));
+    }
+
+    ~JournalWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto r = sealCurrent();
+            if (!r) LOGW("journal seal failed: {}", to_string(r));
+        }
+        journal::WriterRegistry::instance().release(key_);
+    }
+
+    JournalWriter(const JournalWriter&)            = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    // topic filter 에 걸리면 기록하지 않고 OK
+    // id: internTopic 결과 - filter 와 segment 별 topic 수는 id 로 index
+    Result<void> append(TopicId id, std::string_view payload, uint64_t seq = 0) {
+        std::string_view topic = topicName(id);
+        if (topic.empty()) {
+            stats_.errors++;
+            return Error(ResultCode::InvalidArgument, "journal append with unknown topic id");
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& t = topics_.get(id);
+        if (!wants(t, topic)) {
+            stats_.filtered++;
+            return OK();
+        }
+
+        size_t need = journal::alignRecord(sizeof(journal::RecordHeader) + topic.size() + payload.size());
+        if (need > desc_.segment_bytes - journal::DATA_OFFSET) {
+            stats_.errors++;
+            return Error(ResultCode::InvalidArgument, "record larger than journal segment: " + std::string(topic));
+        }
+        if (!segment_ || pos_ + need > segment_->size()) {
+            auto r = nextSegment();
+            if (!r) {
+                stats_.errors++;
+                return r;
+            }
+        }
+
+        // 같은 journal 안에서 시간이 거꾸로 가지 않도록 (reader 가 시간 순이라고 가정)
+        last_ns_ = std::max(last_ns_, journal::nowNs());
+
+        auto* rh = reinterpret_cast<journal::RecordHeader*>(segment_->base() + pos_);
+        rh->size        = static_cast<uint32_t>(need);
+        rh->topic_len   = static_cast<uint32_t>(topic.size());
+        rh->payload_len = static_cast<uint32_t>(payload.size());
+        rh->flags       = 0;
+        rh->time_ns     = last_ns_;
+        rh->seq         = seq;
+        auto* p = reinterpret_cast<char*>(rh + 1);
+        std::memcpy(p, topic.data(), topic.size());
+        if (!payload.empty()) std::memcpy(p + topic.size(), payload.data(), payload.size());
+
+        index_.add(last_ns_, pos_, need, desc_.index_interval);
+        if (t.records++ == 0) written_.push_back(id);
+        pos_ += need;
+        segment_->header()->records.fetch_add(1, std::memory_order_relaxed);
+        segment_->header()->write_pos.store(pos_, std::memory_order_release);
+
+        stats_.records++;
+        stats_.bytes += need;
+        return OK();
+    }
+
+    // 현재 segment 를 seal - 다음 append 는 새 segment
+    Result<void> rotate() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sealCurrent();
+    }
+
+    const JournalWriterDescriptor& descriptor() const noexcept { return desc_; }
+    const JournalStats& stats() const noexcept { return stats_; }
+
+protected:
+    static constexpr const char* LOG_TAG = "JournalWriter";
+
+private:
+    explicit JournalWriter(JournalWriterDescriptor desc) : desc_(std::move(desc)) {
+        for (auto& pattern : desc_.topics) router_.add(pattern, 0);
+    }
+
+    // 이전 writer 가 seal 하지 못한 segment 정리 - 살아있는 writer 가 있으면 AlreadyExists
+    Result<void> recover() {
+        numbers_ = journal::listSegments(desc_.directory, desc_.name);
+        for (auto number : numbers_) {
+            auto idx = journal::segmentPath(desc_.directory, desc_.name, number, "idx");
+            if (::access(idx.c_str(), F_OK) == 0) continue;
+
+            auto path = journal::segmentPath(desc_.directory, desc_.name, number, "jnl");
+            auto seg = journal::Segment::open(path, false);
+            if (!seg) {
+                LOGW("skip journal segment {}: {}", path, to_string(Result<void>::Error(seg.code(), seg.error())));
+                continue;
+            }
+            // 자신의 pid 는 registry 로 확인했으므로 이전 실행의 잔여물 (pid 재사용)
+            int32_t pid = seg.value()->header()->writer_pid;
+            if (pid != ::getpid() && journal::processAlive(pid)) {
+                return Error(ResultCode::AlreadyExists, "journal already has a writer: " + path);
+            }
+            auto index = seg.value()->scan();
+            index.number = number;
+            seg.value().reset();
+            auto r = journal::seal(desc_.directory, desc_.name, index);
+            if (!r) return r;
+            LOGI("recovered journal segment {} ({} records)", path, index.records);
+        }
+        return OK();
+    }
+
+    struct Topic {
+        bool resolved = false;          // filter 매칭 결과를 기억함
+        bool wanted = false;
+        uint64_t records = 0;           // 현재 segment 에 기록한 수 (seal 시 index 에 반영)
+    };
+
+    bool wants(Topic& t, std::string_view topic) {
+        if (desc_.topics.empty()) return true;
+        if (!t.resolved) {
+            t.resolved = true;
+            t.wanted   = router_.match(topic, [](const int&) { }) > 0;
+        }
+        return t.wanted;
+    }
+
+    // mutex_ 보유 상태에서 호출
+    Result<void> nextSegment() {
+        auto r = sealCurrent();
+        if (!r) return r;
+
+        uint64_t number = numbers_.empty() ? 1 : numbers_.back() + 1;
+        auto seg = journal::Segment::open(journal::segmentPath(desc_.directory, desc_.name, number, "jnl"),
+                                          true, desc_.segment_bytes);
+        if (!seg) return Error(seg.code(), seg.error());
+
+        auto* h = new (seg.value()->header()) journal::SegmentHeader();
+        h->number     = number;
+        h->capacity   = desc_.segment_bytes;
+        h->writer_pid = ::getpid();
+        h->write_pos.store(journal::DATA_OFFSET, std::memory_order_relaxed);
+        h->magic.store(journal::MAGIC, std::memory_order_release);
+
+        segment_ = std::move(seg.value());
+        pos_ = journal::DATA_OFFSET;
+        index_ = journal::SegmentIndex();
+        index_.number = number;
+        numbers_.push_back(number);
+        stats_.segments++;
+        trim();
+        return OK();
+    }
+
+    Result<void> sealCurrent() {
+        if (!segment_) return OK();
+        segment_.reset();
+        for (auto id : written_) {
+            auto& t = topics_.get(id);
+            index_.count(topicName(id), t.records);
+            t.records = 0;
+        }
+        written_.clear();
+        return journal::seal(desc_.directory, desc_.name, index_);
+    }
+
+    // 현재 segment 는 지우지 않음
+    void trim() {
+        if (!desc_.max_segments) return;
+        while (numbers_.size() > std::max<size_t>(desc_.max_segments, 1)) {
+            uint64_t number = numbers_.front();
+            numbers_.erase(numbers_.begin());
+            ::unlink(journal::segmentPath(desc_.directory, desc_.name, number, "jnl").c_str());
+            ::unlink(journal::segmentPath(desc_.directory, desc_.name, number, "idx").c_str());
+            stats_.removed++;
+        }
+    }
+
+    JournalWriterDescriptor desc_;
+    std::string key_;                                   // WriterRegistry key
+    TopicRouter<int> router_;
+    TopicSlots<Topic> topics_;                          // TopicId -> filter 결과 / 현재 segment 기록 수
+    std::vector<TopicId> written_;                      // 현재 segment 에 기록한 topic
+
+    std::mutex mutex_;
+    std::shared_ptr<journal::Segment> segment_;
+    uint64_t pos_ = 0;
+    int64_t last_ns_ = 0;
+    journal::SegmentIndex index_;
+    std::vector<uint64_t> numbers_;                     // directory 에 있는 segment (오름차순)
+    JournalStats stats_;
+};
+
+
+struct JournalRange {
+    int64_t from_ns = 0;                // 포함 (system_clock epoch ns)
+    int64_t to_ns = INT64_MAX;          // 포함
+    std::string topic;                  // topic pattern (비어 있으면 전부)
+};
+
+struct JournalRecord {
+    int64_t time_ns;
+    RawMessage message;                 // topic / payload 는 segment mmap 을 가리킴 (owner = segment)
+};
+
+// ------------------------------------------------------
+// JournalReader - open 시점의 segment 목록 / index 로 읽음 (이후 추가된 record 는 보이지 않음)
+// ------------------------------------------------------
+class JournalReader {
+public:
+    struct SegmentInfo {
+        journal::SegmentIndex index;
+        std::shared_ptr<journal::Segment> segment;
+    };
+
+    static Result<std::unique_ptr<JournalReader>> open(const std::string& directory, const std::string& name = "bus") {
+        using R = Result<std::unique_ptr<JournalReader>>;
+        std::unique_ptr<JournalReader> reader(new JournalReader());
+        for (auto number : journal::listSegments(directory, name)) {
+            auto path = journal::segmentPath(directory, name, number, "jnl");
+            auto seg = journal::Segment::open(path, false);
+            if (!seg) {
+                LOG_WARN(LOG_TAG, "skip journal segment {}: {}", path, to_string(Result<void>::Error(seg.code(), seg.error())));
+                continue;
+            }
+
+            SegmentInfo info;
+            std::string data;
+            if (!journal::readFile(journal::segmentPath(directory, name, number, "idx"), data) ||
+                !journal::SegmentIndex::decode(data, info.index)) {
+                info.index = seg.value()->scan();       // seal 전 (기록 중 / 비정상 종료)
+            }
+            info.index.number = number;
+            info.segment = std::move(seg.value());
+            reader->segments_.push_back(std::move(info));
+        }
+        if (reader->segments_.empty()) return R::Error(ResultCode::NotFound, "no journal segments: " + directory + "/" + name);
+        return R::OK(std::move(reader));
+    }
+
+    const std::vector<SegmentInfo>& segments() const noexcept { return segments_; }
+
+    int64_t firstNs() const noexcept {
+        for (auto& s : segments_) if (s.index.records) return s.index.first_ns;
+        return 0;
+    }
+
+    int64_t lastNs() const noexcept {
+        for (auto it = segments_.rbegin(); it != segments_.rend(); ++it) if (it->index.records) return it->index.last_ns;
+        return 0;
+    }
+
+    // fn(const JournalRecord&) -> bool (false 면 중단) 를 시간 순으로 호출
+    // return: 전달한 record 수
+    template<typename Fn>
+    Result<size_t> read(const JournalRange& range, Fn&& fn) const {
+        using R = Result<size_t>;
+        TopicRouter<int> router;
+        if (!range.topic.empty()) {
+            auto v = topic::validate(range.topic);
+            if (!v) return R::Error(v.code(), v.error());
+            router.add(range.topic, 0);
+        }
+        auto matches = [&](std::string_view topic) {
+            return range.topic.empty() || router.match(topic, [](const int&) { }) > 0;
+        };
+
+        size_t count = 0;
+        bool stop = false;
+        for (auto& s : segments_) {
+            if (stop) break;
+            auto& index = s.index;
+            if (!index.records || index.last_ns < range.from_ns || index.first_ns > range.to_ns) continue;
+            if (!range.topic.empty() &&
+                std::none_of(index.topics.begin(), index.topics.end(), [&](auto& t) { return matches(t.first); })) {
+                continue;
+            }
+
+            // segment 안의 topic 별 결과 기억 (key 는 mmap 을 가리킴)
+            std::unordered_map<std::string_view, bool> seen;
+            bool intact = s.segment->forEach(index.seek(range.from_ns), [&](uint64_t offset, const journal::RecordHeader& rh) {
+                if (offset >= index.end) return false;
+                if (rh.time_ns < range.from_ns) return true;
+                if (rh.time_ns > range.to_ns) {
+                    stop = true;
+                    return false;
+                }
+                auto* p = reinterpret_cast<const char*>(&rh + 1);
+                std::string_view topic(p, rh.topic_len);
+                if (!range.topic.empty()) {
+                    auto it = seen.find(topic);
+                    if (it == seen.end()) it = seen.emplace(topic, matches(topic)).first;
+                    if (!it->second) return true;
+                }
+                JournalRecord rec{rh.time_ns, RawMessage{topic, std::string_view(p + rh.topic_len, rh.payload_len),
+                                                         s.segment, rh.seq}};
+                count++;
+                if (!fn(static_cast<const JournalRecord&>(rec))) stop = true;
+                return !stop;
+            });
+            if (!intact) LOGW("journal segment {} is truncated after {} bytes", index.number, index.end);
+        }
+        return R::OK(count);
+    }
+
+    // read 와 같지만 기록 당시 간격을 speed 배로 재현 (speed <= 0 이면 기다리지 않음)
+    // stop 이 true 가 되면 중단
+    template<typename Fn>
+    Result<size_t> replay(const JournalRange& range, double speed, Fn&& fn, const std::atomic<bool>* stop = nullptr) const {
+        using Clock = std::chrono::steady_clock;
+        auto start = Clock::now();
+        int64_t base = -1;
+        return read(range, [&](const JournalRecord& rec) {
+            if (stop && stop->load(std::memory_order_relaxed)) return false;
+            if (speed > 0) {
+                if (base < 0) base = rec.time_ns;
+                auto due = start + std::chrono::nanoseconds(static_cast<int64_t>((rec.time_ns - base) / speed));
+                // 긴 공백 중에도 stop 을 확인
+                while (Clock::now() < due) {
+                    if (stop && stop->load(std::memory_order_relaxed)) return false;
+                    std::this_thread::sleep_until(std::min(due, Clock::now() + std::chrono::milliseconds(100)));
+                }
+            }
+            return fn(rec);
+        });
+    }
+
+protected:
+    static constexpr const char* LOG_TAG = "JournalReader";
+
+private:
+    JournalReader() = default;
+
+    std::vector<SegmentInfo> segments_;
+};
@@ -0,0 +1,399 @@
+#pragma once
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "message.hpp"
+#include "message_helper.hpp"
+#include "wire_format.hpp"
+#include "raw_message.hpp"
+
+// NOTE
+// 수신 버퍼 위의 지연 decode view - field 를 처음 조회할 때 offset index 를 만들고 읽은 field 만 변환
+//
+// message::MessageView view(raw);                         // decode 없음 (RawMessage 복사 = owner 참조)
+// int op = view.getOr<int>("op", 0);                      // 첫 조회에서 index, op 만 변환
+// auto s = view.get<std::string_view>(k_state);           // Key 도 가능, view 가 살아있는 동안 유효
+// if (!view.ok()) LOGW("bad payload: {}", view.error());
+// message::Message full = view.toMessage();               // 전부 필요하면 기존 decode
+//
+// 구독 : SubscribeDescriptor::view_callback - 같은 메시지를 받는 구독들이 view (index) 하나를 공유
+//
+// - Binary : WireReader 한 번 순회 (key intern / arena 할당 없음), 문자열 / bytes 는 버퍼를 가리킴
+// - JSON   : top-level object 의 key / value 범위만 기록 (SAX 방식, nested 값은 괄호 / 문자열만 맞춰 건너뜀)
+//            숫자는 조회 시 변환, escape 없는 문자열은 버퍼를 그대로 가리킴
+// - 값 변환 규칙은 Message::as 와 같음, JSON 의 null / object / array 는 Message 와 같이 field 로 취급하지 않음
+// - 여러 thread 에서 동시에 읽어도 됨 (index 는 한 번만 생성)
+
+namespace message {
+
+class MessageView {
+public:
+    explicit MessageView(RawMessage raw) : raw_(std::move(raw)) { }
+
+    MessageView(const MessageView&)            = delete;
+    MessageView& operator=(const MessageView&) = delete;
+
+    std::string_view topic() const noexcept { return raw_.topic; }
+    const RawMessage& raw() const noexcept { return raw_; }
+
+    // payload 형식 오류가 없으면 true (index 생성)
+    bool ok() const {
+        index();
+        return error_ == nullptr;
+    }
+
+    const char* error() const {
+        index();
+        return error_ ? error_ : "";
+    }
+
+    // 형식 오류면 0
+    size_t size() const {
+        index();
+        return error_ ? 0 : slots_.size();
+    }
+
+    template<typename K>
+    bool contains(const K& k) const { return find(k) != nullptr; }
+
+    // 없거나 타입이 맞지 않으면 nullopt
+    template<typename T, typename K>
+    std::optional<T> get(const K& k) const {
+        const Slot* s = find(k);
+        if (!s) return std::nullopt;
+        return Message::as<T>(decode(*s));
+    }
+
+    template<typename T, typename K>
+    T getOr(const K& k, const T& default_value) const {
+        auto v = get<T>(k);
+        return v ? *v : default_value;
+    }
+
+    // fn(std::string_view name, const Value& value) - 모든 field 변환 (debug / 전체 순회용)
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        index();
+        if (error_) return;
+        for (auto& s : slots_) fn(s.name, decode(s));
+    }
+
+    // 기존 decode 경로 (Message callback 과 같은 결과)
+    Message toMessage() const { return deserialize(raw_); }
+
+private:
+    // JSON number 는 text 로 보관했다가 조회 시 변환
+    enum class Kind : uint8_t { Int, Double, Bool, String, Bytes, JsonNumber, JsonString };
+
+    struct Slot {
+        std::string_view name;
+        Kind kind = Kind::Int;
+        bool escaped = false;               // JsonString - escape 포함 (조회 시 변환 후 보관)
+        std::string_view text;              // String / Bytes / JSON 원문
+        int64_t i = 0;
+        double d = 0.0;
+        mutable const std::string* unescaped = nullptr;
+    };
+
+    // 같은 이름이 여러 번 오면 마지막 값 (Message::set / nlohmann 과 같음)
+    const Slot* find(std::string_view name) const {
+        index();
+        if (error_) return nullptr;
+        for (auto it = slots_.rbegin(); it != slots_.rend(); ++it) {
+            if (it->name == name) return &*it;
+        }
+        return nullptr;
+    }
+
+    const Slot* find(Key k) const { return find(k.name); }
+
+    void index() const {
+        std::call_once(once_, [this] {
+            if (wire::WireReader::isBinary(raw_.payload)) indexBinary();
+            else                                          indexJson();
+            if (error_) slots_.clear();
+        });
+    }
+
+    void indexBinary() const {
+        wire::WireReader r(raw_.payload);
+        slots_.reserve(r.count());
+        wire::WireField f;
+        while (r.next(f)) {
+            Slot s;
+            s.name = f.name;
+            switch (f.type) {
+            case wire::WireType::Int:    s.kind = Kind::Int;    s.i = f.i;              break;
+            case wire::WireType::Double: s.kind = Kind::Double; s.d = f.d;              break;
+            case wire::WireType::False:
+            case wire::WireType::True:   s.kind = Kind::Bool;   s.i = f.boolean();      break;
+            case wire::WireType::String: s.kind = Kind::String; s.text = f.bytes;       break;
+            case wire::WireType::Bytes:  s.kind = Kind::Bytes;  s.text = f.bytes;       break;
+            }
+            slots_.push_back(s);
+        }
+        if (!r.ok()) error_ = r.error();
+    }
+
+    // { "key" : value , ... } - top-level 만 index
+    void indexJson() const {
+        const char* p   = raw_.payload.data();
+        const char* end = p + raw_.payload.size();
+        slots_.reserve(8);
+
+        skipSpace(p, end);
+        if (p == end || *p != '{') return fail("json: expected object");
+        ++p;
+        skipSpace(p, end);
+        if (p < end && *p == '}') return;
+
+        for (;;) {
+            Slot s;
+            bool escaped = false;
+            skipSpace(p, end);
+            if (!scanString(p, end, s.name, escaped)) return fail("json: bad key");
+            if (escaped) s.name = unescape(s.name);
+            skipSpace(p, end);
+            if (p == end || *p++ != ':') return fail("json: expected ':'");
+            skipSpace(p, end);
+            if (p == end) return fail("json: truncated value");
+
+            const char* begin = p;
+            switch (*p) {
+            case '"':
+                if (!scanString(p, end, s.text, s.escaped)) return fail("json: bad string");
+                s.kind = Kind::JsonString;
+                slots_.push_back(s);
+                break;
+            case '{':
+            case '[':
+                if (!skipNested(p, end)) return fail("json: bad nested value");
+                break;
+            case 't':
+            case 'f':
+            case 'n': {
+                std::string_view word = *p == 't' ? "true" : *p == 'f' ? "false" : "null";
+                if (static_cast<size_t>(end - p) < word.size() || std::string_view(p, word.size()) != word) {
+                    return fail("json: bad literal");
+                }
+                p += word.size();
+                if (word != "null") {
+                    s.kind = Kind::Bool;
+                    s.i = word == "true";
+                    slots_.push_back(s);
+                }
+                break;
+            }
+            default:
+                while (p < end && (std::isdigit(static_cast<unsigned char>(*p)) || *p == '-' || *p == '+' ||
+                                   *p == '.' || *p == 'e' || *p == 'E')) {
+                    ++p;
+                }
+                if (p == begin) return fail("json: bad value");
+                s.kind = Kind::JsonNumber;
+                s.text = std::string_view(begin, p - begin);
+                slots_.push_back(s);
+                break;
+            }
+
+            skipSpace(p, end);
+            if (p == end) return fail("json: truncated object");
+            if (*p == ',') {
+                ++p;
+                continue;
+            }
+            if (*p++ != '}') return fail("json: expected ',' or '}'");
+            return;
+        }
+    }
+
+    Value decode(const Slot& s) const {
+        switch (s.kind) {
+        case Kind::Int:    return Value{s.i};
+        case Kind::Double: return Value{s.d};
+        case Kind::Bool:   return Value{s.i != 0};
+        case Kind::String: return Value{s.text};
+        case Kind::Bytes:  return Value{Bytes{reinterpret_cast<const uint8_t*>(s.text.data()), s.text.size()}};
+        case Kind::JsonString:
+            if (!s.escaped) return Value{s.text};
+            return Value{unescapedOf(s)};
+        case Kind::JsonNumber: {
+            // 소수점 / 지수가 없으면 정수 (nlohmann 의 is_number_integer 와 같은 기준)
+            const char* b = s.text.data();
+            const char* e = b + s.text.size();
+            if (s.text.find_first_of(".eE") == std::string_view::npos) {
+                int64_t v = 0;
+                auto r = std::from_chars(b, e, v);
+                if (r.ec == std::errc() && r.ptr == e) return Value{v};
+            }
+            double d = 0.0;
+            auto r = std::from_chars(b, e, d);
+            if (r.ec == std::errc() && r.ptr == e) return Value{d};
+            return Value{};
+        }
+        }
+        return Value{};
+    }
+
+    // escape 포함 문자열은 처음 조회할 때 한 번 변환해서 view 수명 동안 보관
+    std::string_view unescapedOf(const Slot& s) const {
+        std::lock_guard<std::mutex> lock(text_mutex_);
+        if (!s.unescaped) s.unescaped = &decoded_.emplace_back(unescapeText(s.text));
+        return *s.unescaped;
+    }
+
+    // index 생성 중 (call_once 안) - key 이름
+    std::string_view unescape(std::string_view text) const {
+        return decoded_.emplace_back(unescapeText(text));
+    }
+
+    void fail(const char* why) const { error_ = why; }
+
+    static void skipSpace(const char*& p, const char* end) noexcept {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) ++p;
+    }
+
+    // p 는 여는 따옴표 - out 은 따옴표 안 원문
+    static bool scanString(const char*& p, const char* end, std::string_view& out, bool& escaped) noexcept {
+        if (p == end || *p != '"') return false;
+        const char* begin = ++p;
+        escaped = false;
+        while (p < end) {
+            if (*p == '\\') {
+                if (end - p < 2) return false;
+                escaped = true;
+                p += 2;
+                continue;
+            }
+            if (*p == '"') {
+                out = std::string_view(begin, p - begin);
+                ++p;
+                return true;
+            }
+            ++p;
+        }
+        return false;
+    }
+
+    static bool skipNested(const char*& p, const char* end) noexcept {
+        size_t depth = 0;
+        while (p < end) {
+            char c = *p;
+            if (c == '"') {
+                std::string_view ignored;
+                bool escaped;
+                if (!scanString(p, end, ignored, escaped)) return false;
+                continue;
+            }
+            ++p;
+            if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                if (depth == 0) return false;
+                if (--depth == 0) return true;
+            }
+        }
+        return false;
+    }
+
+    static int hexValue(char c) noexcept {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    static bool hex4(std::string_view text, size_t pos, uint32_t& out) noexcept {
+        if (pos + 4 > text.size()) return false;
+        out = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            int v = hexValue(text[pos + i]);
+            if (v < 0) return false;
+            out = (out << 4) | static_cast<uint32_t>(v);
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t cp) {
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    // 잘못된 escape 는 그대로 둠
+    static std::string unescapeText(std::string_view text) {
+        std::string out;
+        out.reserve(text.size());
+        for (size_t i = 0; i < text.size(); ++i) {
+            char c = text[i];
+            if (c != '\\' || i + 1 >= text.size()) {
+                out.push_back(c);
+                continue;
+            }
+            char e = text[++i];
+            switch (e) {
+            case '"':  out.push_back('"');  break;
+            case '\\': out.push_back('\\'); break;
+            case '/':  out.push_back('/');  break;
+            case 'b':  out.push_back('\b'); break;
+            case 'f':  out.push_back('\f'); break;
+            case 'n':  out.push_back('\n'); break;
+            case 'r':  out.push_back('\r'); break;
+            case 't':  out.push_back('\t'); break;
+            case 'u': {
+                uint32_t cp;
+                if (!hex4(text, i + 1, cp)) {
+                    out.append("\\u");
+                    break;
+                }
+                i += 4;
+                // surrogate pair
+                uint32_t low;
+                if (cp >= 0xD800 && cp < 0xDC00 && i + 2 < text.size() && text[i + 1] == '\\' && text[i + 2] == 'u' &&
+                    hex4(text, i + 3, low) && low >= 0xDC00 && low < 0xE000) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+                appendUtf8(out, cp);
+                break;
+            }
+            default:
+                out.push_back('\\');
+                out.push_back(e);
+                break;
+            }
+        }
+        return out;
+    }
+
+    RawMessage raw_;
+
+    mutable std::once_flag once_;
+    mutable std::vector<Slot> slots_;
+    mutable const char* error_ = nullptr;
+
+    mutable std::mutex text_mutex_;
+    mutable std::deque<std::string> decoded_;       // escape 변환 결과 (주소 고정)
+};
+
+} // namespace message
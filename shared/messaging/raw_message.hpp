@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "topic_registry.hpp"
+
+// ------------------------------------------------------
+// RawMessage - 수신 버퍼를 복사하지 않고 그대로 노출
+//  topic / payload 는 owner 가 살아있는 동안 유효
+//  callback 이후에도 보관하려면 RawMessage 를 복사 (owner 참조 계수 증가)
+// ------------------------------------------------------
+struct RawMessage {
+    std::string_view topic;
+    std::string_view payload;
+    std::shared_ptr<const void> owner;      // transport 의 수신 버퍼 (zmq frame 등)
+    uint64_t seq = 0;                       // topic 별 publish 순번 (last-value cache topic 만, 0 = 없음)
+    TopicId topic_id = NO_TOPIC;            // 수신 시 intern 한 topic id (NO_TOPIC = 아직 intern 하지 않음)
+
+    std::string topicString() const { return std::string(topic); }
+    std::string payloadString() const { return std::string(payload); }
+};
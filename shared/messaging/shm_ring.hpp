@@ -0,0 +1,506 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "result.h"
+#include "logging.hpp"
+#include "worker.hpp"
+#include "futex.hpp"
+#include "raw_message.hpp"
+
+// NOTE
+// 같은 host 의 process 간 bus - endpoint "shm://<name>" (POSIX shm "/bus.<name>")
+//
+// auto w = ShmRingWriter::create("sample", 4 << 20);     // publisher (ring 하나 = topic group 하나)
+// w.value()->write("event.sample.completed", payload);
+//
+// ShmRingReader r("sample", [](const RawMessage& m) { ... });   // subscriber process
+// r.start();
+//
+// - 단일 writer / 다중 reader broadcast ring, reader 마다 shm 에 cursor slot 을 가짐
+// - writer 는 가장 느린 reader 를 넘어서 쓰지 않음 (공간이 없으면 drop + ResourceBusy)
+// - reader 는 record 를 ring 안에서 그대로 전달 (복사 없음)
+//   RawMessage 를 보관하는 동안 해당 위치는 덮어쓰지 않음 (오래 보관하면 writer 가 drop)
+
+namespace shm {
+
+inline constexpr uint32_t MAGIC          = 0x53484D52;     // "SHMR"
+inline constexpr uint32_t VERSION        = 1;
+inline constexpr size_t   MAX_READERS    = 32;
+inline constexpr size_t   RECORD_ALIGN   = 16;
+inline constexpr uint32_t RECORD_PADDING = 1;             // ring 끝 남는 공간 (건너뜀)
+
+inline std::string shmName(const std::string& name) { return "/bus." + name; }
+
+inline bool isShmEndpoint(const std::string& endpoint) { return endpoint.compare(0, 6, "shm://") == 0; }
+inline std::string nameOf(const std::string& endpoint) { return endpoint.substr(6); }
+
+struct alignas(64) ReaderSlot {
+    std::atomic<uint64_t> cursor{0};        // 이 위치 이전은 다 읽음 (writer 가 덮어써도 됨)
+    std::atomic<int32_t>  pid{0};           // 0 = 빈 slot
+};
+
+struct Header {
+    std::atomic<uint32_t> magic{0};         // 초기화 완료 후 마지막에 기록
+    uint32_t version = VERSION;
+    uint64_t capacity = 0;                  // data 영역 크기 (2 의 거듭제곱)
+    int32_t  writer_pid = 0;
+
+    alignas(64) std::atomic<uint64_t> write_pos{0};     // 커밋된 위치 (단조 증가)
+    alignas(64) std::atomic<uint32_t> seq{0};           // futex word - 커밋마다 증가
+    std::atomic<uint32_t> waiters{0};
+
+    ReaderSlot readers[MAX_READERS];
+};
+
+struct RecordHeader {
+    uint32_t size;              // header 포함 record 전체 크기 (RECORD_ALIGN 배수)
+    uint32_t flags;
+    uint32_t topic_len;
+    uint32_t payload_len;
+};
+
+inline constexpr size_t DATA_OFFSET = (sizeof(Header) + 63) & ~size_t(63);
+
+inline size_t alignRecord(size_t n) { return (n + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1); }
+
+// ------------------------------------------------------
+// Mapping - shm fd + mmap (reader 가 보관 중인 RawMessage 가 참조)
+// ------------------------------------------------------
+class Mapping {
+public:
+    Mapping(void* addr, size_t size, ino_t ino) : addr_(addr), size_(size), ino_(ino) { }
+    ~Mapping() { if (addr_) ::munmap(addr_, size_); }
+
+    Mapping(const Mapping&)            = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    Header* header() const noexcept { return static_cast<Header*>(addr_); }
+    uint8_t* data() const noexcept { return static_cast<uint8_t*>(addr_) + DATA_OFFSET; }
+    ino_t inode() const noexcept { return ino_; }
+    size_t size() const noexcept { return size_; }
+
+    static Result<std::shared_ptr<Mapping>> open(const std::string& name, bool create, uint64_t capacity) {
+        using R = Result<std::shared_ptr<Mapping>>;
+        const std::string path = shmName(name);
+
+        int fd = create ? ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660)
+                        : ::shm_open(path.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            ResultCode code = errno == ENOENT ? ResultCode::NotFound
+                            : errno == EEXIST ? ResultCode::AlreadyExists
+                            : ResultCode::InternalError;
+            return R::Error(code, path + ": " + std::strerror(errno));
+        }
+
+        size_t size = DATA_OFFSET + capacity;
+        struct stat st{};
+        if (create) {
+            if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                int err = errno;
+                ::close(fd);
+                ::shm_unlink(path.c_str());
+                return R::Error(ResultCode::InternalError, path + ": " + std::strerror(err));
+            }
+        }
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < DATA_OFFSET) {
+            ::close(fd);
+            return R::Error(ResultCode::InvalidState, path + ": not initialized");
+        }
+        size = static_cast<size_t>(st.st_size);
+
+        void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) return R::Error(ResultCode::InternalError, path + ": mmap failed");
+
+        return R::OK(std::make_shared<Mapping>(addr, size, st.st_ino));
+    }
+
+    // 같은 이름의 shm 이 다시 만들어졌는지 (writer 재시작)
+    static bool replaced(const std::string& name, ino_t ino) {
+        int fd = ::shm_open(shmName(name).c_str(), O_RDONLY, 0);
+        if (fd < 0) return false;
+        struct stat st{};
+        bool changed = ::fstat(fd, &st) == 0 && st.st_ino != ino;
+        ::close(fd);
+        return changed;
+    }
+
+private:
+    void* addr_;
+    size_t size_;
+    ino_t ino_;
+};
+
+inline bool processAlive(int32_t pid) {
+    return pid > 0 && (::kill(pid, 0) == 0 || errno == EPERM);
+}
+
+// 이 process 에서 writer 가 열려있는 ring 이름
+//  writer_pid 가 자신의 pid 인 경우 (같은 process 의 두 번째 writer / 재사용된 pid) 구분용
+class WriterRegistry {
+public:
+    static WriterRegistry& instance() {
+        static WriterRegistry registry;
+        return registry;
+    }
+
+    bool acquire(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return names_.insert(name).second;
+    }
+
+    void release(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        names_.erase(name);
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_set<std::string> names_;
+};
+
+} // namespace shm
+
+
+struct ShmRingStats {
+    std::atomic<size_t> published{0};
+    std::atomic<size_t> dropped{0};         // reader 가 따라오지 못해 공간 부족
+    std::atomic<size_t> bytes{0};
+};
+
+// ------------------------------------------------------
+// ShmRingWriter - 한 process 만 write (호출자가 직렬화)
+// ------------------------------------------------------
+class ShmRingWriter {
+public:
+    static Result<std::unique_ptr<ShmRingWriter>> create(const std::string& name, uint64_t capacity) {
+        using R = Result<std::unique_ptr<ShmRingWriter>>;
+        if (capacity < 4096 || (capacity & (capacity - 1)) != 0) {
+            return R::Error(ResultCode::InvalidArgument, "shm ring capacity must be a power of two >= 4096");
+        }
+
+        if (!shm::WriterRegistry::instance().acquire(name)) {
+            return R::Error(ResultCode::AlreadyExists, "shm ring already has a writer in this process: " + name);
+        }
+        auto fail = [&name](ResultCode code, const auto& msg) {
+            shm::WriterRegistry::instance().release(name);
+            return R::Error(code, msg);
+        };
+
+        auto m = shm::Mapping::open(name, true, capacity);
+        if (!m && m.code() == ResultCode::AlreadyExists) {
+            // 이전 writer 가 남긴 shm - 살아있는 writer 가 없으면 새로 생성
+            //  자신의 pid 는 registry 로 확인했으므로 이전 실행의 잔여물 (pid 재사용)
+            auto old = shm::Mapping::open(name, false, 0);
+            if (old && old.value()->header()->magic.load(std::memory_order_acquire) == shm::MAGIC &&
+                old.value()->header()->writer_pid != ::getpid() &&
+                shm::processAlive(old.value()->header()->writer_pid)) {
+                return fail(ResultCode::AlreadyExists, "shm ring already has a writer: " + name);
+            }
+            ::shm_unlink(shm::shmName(name).c_str());
+            m = shm::Mapping::open(name, true, capacity);
+        }
+        if (!m) return fail(m.code(), m.error());
+
+        auto* h = new (m.value()->header()) shm::Header();
+        h->capacity   = capacity;
+        h->writer_pid = ::getpid();
+        h->magic.store(shm::MAGIC, std::memory_order_release);
+
+        return R::OK(std::unique_ptr<ShmRingWriter>(new ShmRingWriter(name, std::move(m.value()))));
+    }
+
+    ~ShmRingWriter() {
+        // reader 는 inode 변경 / writer 종료로 감지 후 다시 연결
+        ::shm_unlink(shm::shmName(name_).c_str());
+        shm::WriterRegistry::instance().release(name_);
+    }
+
+    // return: ResourceBusy (가장 느린 reader 가 ring 한 바퀴 뒤), InvalidArgument (ring 의 절반 초과)
+    Result<void> write(std::string_view topic, std::string_view payload) {
+        shm::Header* h = map_->header();
+        const uint64_t cap  = h->capacity;
+        const size_t   need = shm::alignRecord(sizeof(shm::RecordHeader) + topic.size() + payload.size());
+        if (need > cap / 2) return Error(ResultCode::InvalidArgument, "message too large for shm ring");
+
+        uint64_t pos = h->write_pos.load(std::memory_order_relaxed);
+        uint64_t idx = pos & (cap - 1);
+        uint64_t pad = idx + need > cap ? cap - idx : 0;
+
+        if (pos + pad + need - minCursor(pos) > cap) {
+            stats_.dropped++;
+            return Error(ResultCode::ResourceBusy, "shm ring full");
+        }
+
+        if (pad) {
+            auto* r = reinterpret_cast<shm::RecordHeader*>(map_->data() + idx);
+            *r = {static_cast<uint32_t>(pad), shm::RECORD_PADDING, 0, 0};
+            pos += pad;
+            idx = 0;
+        }
+
+        uint8_t* p = map_->data() + idx;
+        auto* r = reinterpret_cast<shm::RecordHeader*>(p);
+        *r = {static_cast<uint32_t>(need), 0, static_cast<uint32_t>(topic.size()), static_cast<uint32_t>(payload.size())};
+        std::memcpy(p + sizeof(shm::RecordHeader), topic.data(), topic.size());
+        std::memcpy(p + sizeof(shm::RecordHeader) + topic.size(), payload.data(), payload.size());
+
+        h->write_pos.store(pos + need, std::memory_order_release);
+        h->seq.fetch_add(1, std::memory_order_seq_cst);
+        if (h->waiters.load(std::memory_order_seq_cst) > 0) {
+            task::futexWake(h->seq, INT_MAX, true);
+        }
+
+        stats_.published++;
+        stats_.bytes += payload.size();
+        return OK();
+    }
+
+    const std::string& name() const noexcept { return name_; }
+    const ShmRingStats& stats() const noexcept { return stats_; }
+
+protected:
+    static constexpr const char* LOG_TAG = "ShmRingWriter";
+
+private:
+    ShmRingWriter(std::string name, std::shared_ptr<shm::Mapping> map)
+        : name_(std::move(name)), map_(std::move(map)) { }
+
+    // 등록된 reader 중 가장 뒤처진 cursor (죽은 process 의 slot 은 회수)
+    uint64_t minCursor(uint64_t pos) {
+        shm::Header* h = map_->header();
+        uint64_t min = pos;
+        for (auto& slot : h->readers) {
+            int32_t pid = slot.pid.load(std::memory_order_acquire);
+            if (!pid) continue;
+            uint64_t c = slot.cursor.load(std::memory_order_acquire);
+            if (pos - c >= h->capacity / 2 && !shm::processAlive(pid)) {
+                slot.pid.compare_exchange_strong(pid, 0);
+                continue;
+            }
+            if (c < min) min = c;
+        }
+        return min;
+    }
+
+    std::string name_;
+    std::shared_ptr<shm::Mapping> map_;
+    ShmRingStats stats_;
+};
+
+
+// ------------------------------------------------------
+// ShmRingReader - ring 하나를 읽어 sink 로 전달하는 worker
+//  writer 가 아직 없으면 / 재시작하면 주기적으로 다시 연결
+// ------------------------------------------------------
+class ShmRingReader : public task::Worker {
+public:
+    using Sink = std::function<void(const RawMessage&)>;
+
+    ShmRingReader(std::string name, Sink sink, int core = -1)
+        : name_(std::move(name)), sink_(std::move(sink)) {
+        task::WorkerDescriptor wd;
+        wd.name = "shm." + name_;
+        wd.type = task::WorkerType::Single;
+        if (core >= 0) wd.affinity = {core};
+
+        auto r = Worker::init(wd);
+        if (!r) {
+            LOGE("shm reader init failed: {}", to_string(r));
+        }
+    }
+
+    ~ShmRingReader() override {
+        stop();
+    }
+
+    size_t received() const noexcept { return received_.load(std::memory_order_relaxed); }
+    size_t corrupt() const noexcept { return corrupt_.load(std::memory_order_relaxed); }
+
+protected:
+    static constexpr const char* LOG_TAG = "ShmRingReader";
+    static constexpr int WAIT_MS = 100;
+
+    Result<void> run() override {
+        while (!isStopRequested()) {
+            if (!cursor_ && !attach()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_MS));
+                continue;
+            }
+
+            if (!drain()) waitForData();
+        }
+        detach();
+        return OK();
+    }
+
+    void onPreStop() override {
+        if (auto map = std::atomic_load(&map_)) task::futexWake(map->header()->seq, INT_MAX, true);
+    }
+
+private:
+    // reader slot 의 cursor - 읽는 중 / 보관 중인 record 는 writer 가 덮어쓰지 않음
+    struct Cursor {
+        std::shared_ptr<shm::Mapping> map;
+        shm::ReaderSlot* slot = nullptr;
+
+        std::mutex mutex;
+        std::multiset<uint64_t> pinned;     // 보관 중인 batch 시작 위치
+        uint64_t read_pos = 0;
+
+        ~Cursor() { slot->pid.store(0, std::memory_order_release); }
+
+        void publish() {
+            uint64_t c = pinned.empty() ? read_pos : std::min(read_pos, *pinned.begin());
+            slot->cursor.store(c, std::memory_order_release);
+        }
+    };
+
+    // batch 단위 RawMessage owner - 마지막 참조가 사라지면 pin 해제
+    struct Pin {
+        std::shared_ptr<Cursor> cursor;
+        uint64_t pos;
+
+        Pin(std::shared_ptr<Cursor> c, uint64_t p) : cursor(std::move(c)), pos(p) {
+            std::lock_guard<std::mutex> lock(cursor->mutex);
+            cursor->pinned.insert(pos);
+        }
+        ~Pin() {
+            std::lock_guard<std::mutex> lock(cursor->mutex);
+            cursor->pinned.erase(cursor->pinned.find(pos));
+            cursor->publish();
+        }
+    };
+
+    bool attach() {
+        auto m = shm::Mapping::open(name_, false, 0);
+        if (!m) return false;
+        auto map = m.value();
+        shm::Header* h = map->header();
+        if (h->magic.load(std::memory_order_acquire) != shm::MAGIC || h->version != shm::VERSION) return false;
+        if (h->capacity == 0 || (h->capacity & (h->capacity - 1)) != 0 ||
+            shm::DATA_OFFSET + h->capacity > map->size()) {
+            LOGE("shm ring {} header corrupt (capacity={})", name_, h->capacity);
+            return false;
+        }
+
+        const int32_t pid = ::getpid();
+        for (auto& slot : h->readers) {
+            int32_t expected = 0;
+            // 등록 직후 writer 가 이전 reader 의 cursor 를 볼 수 있지만 더 뒤쪽이므로 drop 쪽으로만 안전
+            if (!slot.pid.compare_exchange_strong(expected, pid)) continue;
+
+            auto c = std::make_shared<Cursor>();
+            c->map  = map;
+            c->slot = &slot;
+            // 등록 이후 위치부터 읽음 (구독 이전 메시지는 받지 않음)
+            c->read_pos = h->write_pos.load(std::memory_order_acquire);
+            slot.cursor.store(c->read_pos, std::memory_order_release);
+
+            std::atomic_store(&map_, map);
+            cursor_ = std::move(c);
+            LOGI("attached to shm ring {}", name_);
+            return true;
+        }
+        LOGW("shm ring {} has no free reader slot", name_);
+        return false;
+    }
+
+    void detach() {
+        cursor_.reset();        // 보관 중인 RawMessage 가 없으면 slot 바로 반환
+        std::atomic_store(&map_, std::shared_ptr<shm::Mapping>());
+    }
+
+    // return: 처리한 record 가 있는지
+    bool drain() {
+        shm::Header* h = map_->header();
+        const uint64_t mask = h->capacity - 1;
+        const uint64_t end  = h->write_pos.load(std::memory_order_acquire);
+        uint64_t pos = cursor_->read_pos;
+        if (pos == end) return false;
+
+        auto pin = std::make_shared<Pin>(cursor_, pos);
+        while (pos != end && !isStopRequested()) {
+            const uint8_t* p = map_->data() + (pos & mask);
+            auto* r = reinterpret_cast<const shm::RecordHeader*>(p);
+            if (!validRecord(r, pos, end, h->capacity)) {
+                // 손상된 record - 이후 위치는 신뢰할 수 없으므로 writer 위치로 건너뜀
+                LOGE("shm ring {} corrupt record at {} (size={}), skipping {} bytes",
+                     name_, pos, r->size, end - pos);
+                corrupt_.fetch_add(1, std::memory_order_relaxed);
+                pos = end;
+                break;
+            }
+            pos += r->size;
+            if (r->flags & shm::RECORD_PADDING) continue;
+
+            const char* body = reinterpret_cast<const char*>(p + sizeof(shm::RecordHeader));
+            RawMessage m{std::string_view(body, r->topic_len),
+                         std::string_view(body + r->topic_len, r->payload_len), pin};
+            m.topic_id = findTopic(m.topic);
+            received_.fetch_add(1, std::memory_order_relaxed);
+            sink_(m);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(cursor_->mutex);
+            cursor_->read_pos = pos;
+        }
+        pin.reset();            // 보관한 곳이 없으면 여기서 cursor 진행
+        return true;
+    }
+
+    // size 가 0 (무한 반복) 이거나 커밋된 범위 / ring 끝을 넘으면 손상
+    static bool validRecord(const shm::RecordHeader* r, uint64_t pos, uint64_t end, uint64_t cap) {
+        const uint64_t idx = pos & (cap - 1);
+        if (r->size == 0 || r->size > end - pos || r->size > cap - idx) return false;
+        if (r->flags & shm::RECORD_PADDING) return true;
+        return r->size >= sizeof(shm::RecordHeader) &&
+               uint64_t(r->topic_len) + r->payload_len <= r->size - sizeof(shm::RecordHeader);
+    }
+
+    void waitForData() {
+        shm::Header* h = map_->header();
+        uint32_t seq = h->seq.load(std::memory_order_seq_cst);
+        h->waiters.fetch_add(1, std::memory_order_seq_cst);
+        if (h->write_pos.load(std::memory_order_acquire) == cursor_->read_pos && !isStopRequested()) {
+            int rc = task::futexWait(h->seq, seq, WAIT_MS, true);
+            h->waiters.fetch_sub(1, std::memory_order_seq_cst);
+            // 새 데이터 없이 timeout - writer 재시작 / 종료 확인
+            if (rc == ETIMEDOUT && (shm::Mapping::replaced(name_, map_->inode()) ||
+                                    !shm::processAlive(h->writer_pid))) {
+                LOGI("shm ring {} writer gone, reattaching", name_);
+                detach();
+            }
+            return;
+        }
+        h->waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    std::string name_;
+    Sink sink_;
+    std::shared_ptr<shm::Mapping> map_;     // onPreStop 에서도 접근 - atomic_load / atomic_store
+    std::shared_ptr<Cursor> cursor_;
+    std::atomic<size_t> received_{0};
+    std::atomic<size_t> corrupt_{0};
+};
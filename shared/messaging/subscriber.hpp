@@ -12,10 +12,24 @@
 
 #include "result.h"
 #include "message.hpp"
+#include "raw_message.hpp"
+#include "message_view.hpp"
 
 struct SubscribeDescriptor {
     std::string topic;
     std::function<Result<void>(const message::Message&)> callback;
+    // 지정 시 callback 대신 호출, 수신 버퍼를 그대로 전달 (decode 없음)
+    std::function<Result<void>(const RawMessage&)> raw_callback;
+    // 지정 시 callback 대신 호출, field 는 읽을 때 decode (message_view.hpp) - 같은 메시지의 구독들이 index 공유
+    std::function<Result<void>(const message::MessageView&)> view_callback;
+
+    // subscriber 에 callback pool 이 있을 때 (ZmqSubscriberDescriptor::callback_pool)
+    // 같은 key 끼리는 수신 순서대로 실행, 다른 key 는 병렬 - 비어 있으면 topic 이 key
+    std::function<uint64_t(const RawMessage&)> order_key;
+    size_t max_pending = 0;             // 실행 대기 상한, 넘으면 drop (0 = subscriber 기본값)
+    uint32_t slow_threshold_ms = 0;     // 수신 ~ callback 완료가 이보다 길면 slow (0 = subscriber 기본값)
+    bool inline_dispatch = false;       // pool 이 있어도 수신 thread 에서 바로 호출 (가벼운 callback)
+    bool conflate = false;              // topic 별 최신 메시지 하나만 대기 (ZMQ_CONFLATE 처럼), callback pool 필요
 };
 
 class ISubscriber {
@@ -30,7 +44,7 @@ public:
 
     virtual Result<void> addBus(const std::string& bus) = 0;
 
-    // Subscribe to a topic (exact prefix match)
+    // topic pattern 구독 - 정확히 일치 또는 '*' (segment 하나), '#' (나머지 전부)
     virtual Result<void> subscribe(SubscribeDescriptor desc) = 0;
     virtual Result<void> unsubscribe(const std::string& topic) = 0;    
     
@@ -0,0 +1,193 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "result.h"
+#include "wire_format.hpp"
+#include "topic_router.hpp"
+#include "topic_registry.hpp"
+
+// NOTE
+// batch 메시지 = 3 frame (일반 pub/sub 메시지는 2 frame)
+//   [topic][TAG][blob]
+//   blob : [0] MAGIC 0xB3  [1] VERSION 1  { varint len + payload } * N
+//
+// topic frame 은 batch 안 메시지들의 topic 그대로 - 구독자의 ZMQ prefix filter 가 그대로 동작
+// 구독 쪽 (ZmqPollSubscriber) 은 TAG frame 을 보고 payload 별 RawMessage 로 풀어서 전달
+//
+// TopicBatcherDescriptor d;
+// d.topics = {"telemetry.#"};                  // 이 pattern 에 맞는 topic 만 모아서 전송
+// TopicBatcher batcher(d);
+// batcher.add(internTopic(topic), topic, payload, [&](const std::string& t, const std::string& blob) { send(t, blob); });
+// batcher.flushExpired(send);                  // 주기적으로 (max_delay_ms)
+
+namespace batch {
+
+inline constexpr uint8_t MAGIC   = 0xB3;
+inline constexpr uint8_t VERSION = 1;
+inline constexpr std::string_view TAG = "\xB3" "batch";
+
+inline bool isBatch(std::string_view tag_frame) noexcept { return tag_frame == TAG; }
+
+// fn(std::string_view payload) 를 메시지마다 호출, return: false (형식 오류 - 앞의 메시지는 이미 전달됨)
+template<typename Fn>
+bool forEach(std::string_view blob, Fn&& fn) {
+    if (blob.size() < 2 || static_cast<uint8_t>(blob[0]) != MAGIC || static_cast<uint8_t>(blob[1]) != VERSION) {
+        return false;
+    }
+    auto* p   = reinterpret_cast<const uint8_t*>(blob.data()) + 2;
+    auto* end = reinterpret_cast<const uint8_t*>(blob.data()) + blob.size();
+    while (p < end) {
+        uint64_t len;
+        if (!wire::getVarint(p, end, len) || len > static_cast<uint64_t>(end - p)) return false;
+        fn(std::string_view(reinterpret_cast<const char*>(p), len));
+        p += len;
+    }
+    return true;
+}
+
+} // namespace batch
+
+
+struct TopicBatcherDescriptor {
+    std::vector<std::string> topics;    // batch 대상 topic pattern (topic_router.hpp 문법)
+    size_t max_bytes = 16 << 10;        // blob 크기가 넘으면 바로 전송
+    size_t max_messages = 256;          // 메시지 수가 넘으면 바로 전송
+    int max_delay_ms = 2;               // 첫 메시지 이후 이 시간이 지나면 전송 (flushExpired)
+};
+
+struct BatchStats {
+    std::atomic<size_t> batches{0};
+    std::atomic<size_t> messages{0};            // batch 로 보낸 메시지 수 (평균 = messages / batches)
+    std::atomic<size_t> bytes{0};               // blob 합계 (평균 batch 크기 = bytes / batches)
+    std::atomic<size_t> max_messages{0};        // batch 하나의 최대 메시지 수
+    std::atomic<size_t> by_size{0};             // 크기 / 개수 budget 으로 전송
+    std::atomic<size_t> by_time{0};             // 시간 budget 으로 전송
+    std::atomic<uint64_t> total_delay_us{0};    // 첫 메시지 ~ 전송 (평균 = total / batches)
+    std::atomic<uint64_t> max_delay_us{0};
+};
+
+
+// ------------------------------------------------------
+// TopicBatcher - topic 별 buffer 에 모았다가 budget 초과 시 send(topic, blob) 호출
+//  - thread-safe 하지 않음 (publisher 의 send lock 안에서 사용)
+//  - 같은 topic 안의 순서는 유지, batch 대상이 아닌 topic 과의 순서는 보장하지 않음
+//  - buffer 는 TopicId 로 index (intern 되지 않은 topic 은 batch 하지 않음)
+// ------------------------------------------------------
+class TopicBatcher {
+public:
+    explicit TopicBatcher(TopicBatcherDescriptor desc = {}) : desc_(std::move(desc)) {
+        for (auto& pattern : desc_.topics) {
+            if (topic::validate(pattern)) router_.add(pattern, 0);
+        }
+    }
+
+    bool enabled() const noexcept { return !desc_.topics.empty(); }
+
+    // batch 대상이면 buffer 에 추가하고 true (budget 을 넘으면 send 호출)
+    // 대상이 아니거나 max_bytes 이상이면 false - 호출자가 바로 전송
+    template<typename Send>
+    bool add(TopicId id, const std::string& topic, std::string_view payload, Send&& send) {
+        if (!enabled() || id == NO_TOPIC) return false;
+
+        auto& slot = slots_.get(id);
+        if (!slot.resolved) {
+            slot.resolved = true;
+            if (router_.match(topic, [](const int&) { }) > 0) {
+                slot.buffer = std::make_unique<Buffer>();
+                slot.buffer->topic = topic;
+                batched_.push_back(slot.buffer.get());
+            }
+        }
+        if (!slot.buffer) return false;
+
+        auto& b = *slot.buffer;
+        // budget 보다 큰 메시지는 쌓인 것을 먼저 보내고 단독 전송 (호출자의 zero-copy 경로 유지)
+        if (payload.size() >= desc_.max_bytes) {
+            if (b.count) flush(b, send, false);
+            return false;
+        }
+        // 새 메시지를 넣으면 넘칠 때는 먼저 비움
+        if (b.count && b.blob.size() + payload.size() + 10 > desc_.max_bytes) {
+            flush(b, send, false);
+        }
+        if (b.count == 0) {
+            b.blob.push_back(static_cast<char>(batch::MAGIC));
+            b.blob.push_back(static_cast<char>(batch::VERSION));
+            b.first = Clock::now();
+            pending_++;
+        }
+        wire::putVarint(b.blob, payload.size());
+        b.blob.append(payload.data(), payload.size());
+        b.count++;
+
+        if (b.count >= desc_.max_messages || b.blob.size() >= desc_.max_bytes) flush(b, send, false);
+        return true;
+    }
+
+    // max_delay_ms 가 지난 buffer 전송
+    template<typename Send>
+    void flushExpired(Send&& send) {
+        if (!pending_) return;
+        auto deadline = Clock::now() - std::chrono::milliseconds(desc_.max_delay_ms);
+        for (auto* b : batched_) {
+            if (b->count && b->first <= deadline) flush(*b, send, true);
+        }
+    }
+
+    template<typename Send>
+    void flushAll(Send&& send) {
+        for (auto* b : batched_) {
+            if (b->count) flush(*b, send, true);
+        }
+    }
+
+    size_t pending() const noexcept { return pending_; }
+    const BatchStats& stats() const noexcept { return stats_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Buffer {
+        std::string topic;
+        std::string blob;
+        size_t count = 0;
+        Clock::time_point first;
+    };
+
+    template<typename Send>
+    void flush(Buffer& b, Send& send, bool by_time) {
+        send(b.topic, b.blob);
+
+        auto us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - b.first).count());
+        stats_.batches++;
+        stats_.messages += b.count;
+        stats_.bytes += b.blob.size();
+        (by_time ? stats_.by_time : stats_.by_size)++;
+        stats_.total_delay_us += us;
+        if (b.count > stats_.max_messages.load(std::memory_order_relaxed)) stats_.max_messages = b.count;
+        if (us > stats_.max_delay_us.load(std::memory_order_relaxed)) stats_.max_delay_us = us;
+
+        b.blob.clear();                 // capacity 유지 - 다음 batch 에서 재사용
+        b.count = 0;
+        pending_--;
+    }
+
+    TopicBatcherDescriptor desc_;
+    TopicRouter<int> router_;
+    struct Slot {
+        bool resolved = false;          // batch 대상 여부를 확인함
+        std::unique_ptr<Buffer> buffer; // nullptr = batch 대상 아님
+    };
+
+    TopicSlots<Slot> slots_;
+    std::vector<Buffer*> batched_;      // batch 대상 buffer (flush 순회)
+    size_t pending_ = 0;                // 비어 있지 않은 buffer 수
+    BatchStats stats_;
+};
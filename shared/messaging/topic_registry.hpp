@@ -0,0 +1,148 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "logging.hpp"
+
+// NOTE
+// topic 문자열을 process 전역 정수 id 로 intern - hot path 의 table 은 문자열 hash 대신 id 로 index
+//
+// TopicId id = TopicRegistry::instance().intern("state.sample");   // 처음 보는 topic 이면 등록
+// std::string_view name = TopicRegistry::instance().name(id);     // process 수명 동안 유효
+//
+// TopicSlots<Counter> counters;                                     // id 로 index 하는 table (호출자가 lock)
+// counters.get(id).messages++;
+//
+// - wire 의 topic frame 은 문자열 그대로 (ZMQ prefix filter), 수신 시 한 번 intern 해서 RawMessage::topic_id 로 전달
+// - 등록된 topic 은 지우지 않음 (id 재사용 없음) - topic 수가 아니라 topic 종류 수만큼 메모리 사용
+
+using TopicId = uint32_t;
+inline constexpr TopicId NO_TOPIC = 0;         // intern 하지 않음 / 등록 한도 초과
+
+// ------------------------------------------------------
+// TopicRegistry - intern 은 shared lock 조회 (처음 보는 topic 만 exclusive lock)
+//  name(id) 는 lock 없이 조회 (chunk 단위로 할당, 할당된 chunk 는 이동하지 않음)
+// ------------------------------------------------------
+class TopicRegistry {
+public:
+    static constexpr size_t CHUNK_BITS = 12;
+    static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+    static constexpr size_t MAX_CHUNKS = 4096;                      // 최대 16M topic
+    static constexpr size_t WARN_TOPICS = size_t(1) << 20;          // topic 이 계속 늘어나는 설계 경고
+
+    static TopicRegistry& instance() {
+        static TopicRegistry registry;
+        return registry;
+    }
+
+    // return: 등록 한도를 넘으면 NO_TOPIC (호출자는 문자열 경로 사용)
+    TopicId intern(std::string_view topic) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = ids_.find(topic);
+            if (it != ids_.end()) return it->second;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(topic);
+        if (it != ids_.end()) return it->second;
+
+        size_t id = names_.size() + 1;
+        if (id >= MAX_CHUNKS * CHUNK_SIZE) {
+            if (!full_logged_) {
+                full_logged_ = true;
+                LOG_ERROR(LOG_TAG, "topic registry full ({} topics) - new topics are not interned", names_.size());
+            }
+            return NO_TOPIC;
+        }
+        size_t chunk = id >> CHUNK_BITS;
+        if (!chunks_[chunk].load(std::memory_order_relaxed)) {
+            owned_.push_back(std::make_unique<const std::string*[]>(CHUNK_SIZE));
+            chunks_[chunk].store(owned_.back().get(), std::memory_order_release);
+        }
+
+        names_.push_back(std::make_unique<const std::string>(topic));
+        const std::string* name = names_.back().get();
+        chunks_[chunk].load(std::memory_order_relaxed)[id & (CHUNK_SIZE - 1)] = name;
+        ids_.emplace(*name, static_cast<TopicId>(id));
+        size_.store(id, std::memory_order_release);
+
+        if (id == WARN_TOPICS) LOG_WARN(LOG_TAG, "{} topics interned - topic names should not carry unique ids", id);
+        return static_cast<TopicId>(id);
+    }
+
+    // 등록하지 않고 조회 (외부에서 들어온 문자열 등), 없으면 NO_TOPIC
+    TopicId find(std::string_view topic) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(topic);
+        return it != ids_.end() ? it->second : NO_TOPIC;
+    }
+
+    // id 는 intern 이 반환한 값 - 범위 밖이면 빈 문자열
+    std::string_view name(TopicId id) const noexcept {
+        if (id == NO_TOPIC || id > size_.load(std::memory_order_acquire)) return {};
+        auto* chunk = chunks_[id >> CHUNK_BITS].load(std::memory_order_acquire);
+        return *chunk[id & (CHUNK_SIZE - 1)];
+    }
+
+    // 가장 큰 id (id 로 index 하는 table 크기)
+    size_t size() const noexcept { return size_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr const char* LOG_TAG = "TopicRegistry";
+
+    TopicRegistry() = default;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, TopicId> ids_;                 // key 는 names_ 를 가리킴
+    std::vector<std::unique_ptr<const std::string>> names_;             // id - 1
+    std::vector<std::unique_ptr<const std::string*[]>> owned_;
+    std::atomic<const std::string**> chunks_[MAX_CHUNKS] = {};
+    std::atomic<size_t> size_{0};
+    bool full_logged_ = false;
+};
+
+inline TopicId internTopic(std::string_view topic) { return TopicRegistry::instance().intern(topic); }
+inline std::string_view topicName(TopicId id) noexcept { return TopicRegistry::instance().name(id); }
+// 수신 경로 - 외부에서 들어온 topic 은 등록하지 않음 (subscribe / publish 에서 intern 된 것만 id 를 가짐)
+inline TopicId findTopic(std::string_view topic) { return TopicRegistry::instance().find(topic); }
+
+
+// ------------------------------------------------------
+// TopicSlots - TopicId 로 index 하는 table (thread-safe 하지 않음, 사용하는 쪽의 lock 안에서)
+// ------------------------------------------------------
+template<typename T>
+class TopicSlots {
+public:
+    // 없으면 기본값으로 생성
+    T& get(TopicId id) {
+        if (id >= slots_.size()) slots_.resize(std::max<size_t>(id + 1, slots_.size() * 2));
+        return slots_[id];
+    }
+
+    T* find(TopicId id) noexcept { return id < slots_.size() ? &slots_[id] : nullptr; }
+    const T* find(TopicId id) const noexcept { return id < slots_.size() ? &slots_[id] : nullptr; }
+
+    // fn(TopicId, T&) - 할당된 모든 slot (기본값 포함)
+    template<typename Fn>
+    void forEach(Fn&& fn) {
+        for (size_t i = 1; i < slots_.size(); ++i) fn(static_cast<TopicId>(i), slots_[i]);
+    }
+
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t i = 1; i < slots_.size(); ++i) fn(static_cast<TopicId>(i), slots_[i]);
+    }
+
+    void clear() { slots_.clear(); }
+
+private:
+    std::vector<T> slots_;
+};
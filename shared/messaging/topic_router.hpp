@@ -0,0 +1,249 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "result.h"
+
+// NOTE
+// topic 은 '.' 으로 구분된 segment
+//   event.sample.completed     정확히 일치
+//   event.*.completed          '*' = segment 하나
+//   event.sample.#             '#' = 0 개 이상의 나머지 segment (마지막 segment 에서만 허용)
+//
+// TopicRouter<int> router;
+// router.add("event.*.completed", 1);
+// router.match("event.sample.completed", [](const int& v) { ... });
+//
+// 갱신은 변경된 경로의 node 만 복사해서 새 root 로 교체 (copy-on-write)
+// match 는 root snapshot 을 잡고 진행하므로 add / remove 와 서로 막지 않음
+
+namespace topic {
+
+inline constexpr char SEPARATOR = '.';
+inline constexpr std::string_view ANY_ONE  = "*";
+inline constexpr std::string_view ANY_REST = "#";
+
+// return: InvalidArgument ('#' 가 마지막이 아님, segment 안에 wildcard 문자가 섞임)
+inline Result<void> validate(std::string_view pattern) {
+    size_t pos = 0;
+    for (;;) {
+        size_t dot = pattern.find(SEPARATOR, pos);
+        std::string_view seg = pattern.substr(pos, dot == std::string_view::npos ? std::string_view::npos : dot - pos);
+        if (seg != ANY_ONE && seg != ANY_REST &&
+            seg.find_first_of("*#") != std::string_view::npos) {
+            return Error(ResultCode::InvalidArgument, "wildcard must be a whole segment: " + std::string(pattern));
+        }
+        if (seg == ANY_REST && dot != std::string_view::npos) {
+            return Error(ResultCode::InvalidArgument, "'#' must be the last segment: " + std::string(pattern));
+        }
+        if (dot == std::string_view::npos) return OK();
+        pos = dot + 1;
+    }
+}
+
+// wildcard 이전까지의 literal prefix - ZMQ SUB filter 로 사용
+//   event.*.completed -> "event."     event.sample.# -> "event.sample"     # -> ""
+inline std::string literalPrefix(std::string_view pattern) {
+    size_t pos = 0;
+    for (;;) {
+        size_t dot = pattern.find(SEPARATOR, pos);
+        std::string_view seg = pattern.substr(pos, dot == std::string_view::npos ? std::string_view::npos : dot - pos);
+        if (seg == ANY_ONE) return std::string(pattern.substr(0, pos));
+        if (seg == ANY_REST) return std::string(pattern.substr(0, pos ? pos - 1 : 0));
+        if (dot == std::string_view::npos) return std::string(pattern);
+        pos = dot + 1;
+    }
+}
+
+inline bool hasWildcard(std::string_view pattern) {
+    return literalPrefix(pattern).size() != pattern.size();
+}
+
+} // namespace topic
+
+
+// ------------------------------------------------------
+// TopicRouter - segment 단위 radix trie (edge = segment 문자열)
+//  match 비용은 topic 길이 x 동시에 진행하는 '*' 경로 수
+// ------------------------------------------------------
+template<typename T>
+class TopicRouter {
+public:
+    struct Node {
+        std::vector<std::pair<std::string, std::shared_ptr<const Node>>> children;   // segment 정렬
+        std::shared_ptr<const Node> any_one;        // '*'
+        std::vector<T> exact;                       // pattern 이 이 node 에서 끝남
+        std::vector<T> rest;                        // pattern 이 이 node 다음 '#' 으로 끝남
+
+        bool empty() const noexcept {
+            return children.empty() && !any_one && exact.empty() && rest.empty();
+        }
+    };
+    using NodePtr = std::shared_ptr<const Node>;
+
+    TopicRouter() : root_(std::make_shared<const Node>()) { }
+
+    // pattern 은 topic::validate() 를 통과해야 함
+    void add(std::string_view pattern, T value) {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        auto next = insert(snapshot().get(), pattern, 0, std::move(value));
+        std::atomic_store(&root_, NodePtr(std::move(next)));
+    }
+
+    // return: 제거한 항목 수
+    template<typename Pred>
+    size_t remove(std::string_view pattern, Pred&& pred) {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        size_t removed = 0;
+        auto next = erase(snapshot().get(), pattern, 0, pred, removed);
+        if (removed) std::atomic_store(&root_, next ? NodePtr(std::move(next)) : std::make_shared<const Node>());
+        return removed;
+    }
+
+    size_t removeAll(std::string_view pattern) {
+        return remove(pattern, [](const T&) { return true; });
+    }
+
+    // fn(const T&) 를 일치하는 항목마다 호출, return: 호출 수
+    // fn 안에서 add / remove 가능 (이번 match 는 기존 snapshot 기준)
+    template<typename Fn>
+    size_t match(std::string_view topic, Fn&& fn) const {
+        NodePtr root = snapshot();
+        return matchNode(*root, topic, 0, false, fn);
+    }
+
+    NodePtr snapshot() const { return std::atomic_load(&root_); }
+
+private:
+    static std::string_view segmentAt(std::string_view s, size_t pos, size_t& next) {
+        size_t dot = s.find(topic::SEPARATOR, pos);
+        if (dot == std::string_view::npos) {
+            next = std::string_view::npos;
+            return s.substr(pos);
+        }
+        next = dot + 1;
+        return s.substr(pos, dot - pos);
+    }
+
+    static const NodePtr* findChild(const Node& n, std::string_view seg) {
+        auto it = std::lower_bound(n.children.begin(), n.children.end(), seg,
+            [](const auto& c, std::string_view s) { return std::string_view(c.first) < s; });
+        return it != n.children.end() && it->first == seg ? &it->second : nullptr;
+    }
+
+    // done = topic 의 모든 segment 소비
+    template<typename Fn>
+    static size_t matchNode(const Node& n, std::string_view t, size_t pos, bool done, Fn& fn) {
+        size_t count = 0;
+        for (auto& v : n.rest) { fn(v); ++count; }
+        if (done) {
+            for (auto& v : n.exact) { fn(v); ++count; }
+            return count;
+        }
+
+        size_t next;
+        std::string_view seg = segmentAt(t, pos, next);
+        bool last = next == std::string_view::npos;
+
+        if (auto child = findChild(n, seg)) count += matchNode(**child, t, next, last, fn);
+        if (n.any_one) count += matchNode(*n.any_one, t, next, last, fn);
+        return count;
+    }
+
+    // 경로상의 node 만 복사
+    static std::shared_ptr<Node> insert(const Node* n, std::string_view p, size_t pos, T&& value) {
+        auto copy = n ? std::make_shared<Node>(*n) : std::make_shared<Node>();
+
+        size_t next;
+        std::string_view seg = segmentAt(p, pos, next);
+        if (seg == topic::ANY_REST) {
+            copy->rest.push_back(std::move(value));
+            return copy;
+        }
+
+        bool last = next == std::string_view::npos;
+        NodePtr* slot = nullptr;
+        if (seg == topic::ANY_ONE) {
+            slot = &copy->any_one;
+        } else {
+            auto it = std::lower_bound(copy->children.begin(), copy->children.end(), seg,
+                [](const auto& c, std::string_view s) { return std::string_view(c.first) < s; });
+            if (it == copy->children.end() || it->first != seg) {
+                it = copy->children.insert(it, {std::string(seg), nullptr});
+            }
+            slot = &it->second;
+        }
+
+        if (last) {
+            auto child = *slot ? std::make_shared<Node>(**slot) : std::make_shared<Node>();
+            child->exact.push_back(std::move(value));
+            *slot = std::move(child);
+        } else {
+            *slot = insert(slot->get(), p, next, std::move(value));
+        }
+        return copy;
+    }
+
+    // return: 변경된 node (비면 nullptr), 변경 없으면 removed == 0
+    template<typename Pred>
+    static std::shared_ptr<Node> erase(const Node* n, std::string_view p, size_t pos, Pred& pred, size_t& removed) {
+        if (!n) return nullptr;
+
+        auto dropFrom = [&](std::vector<T>& list) {
+            auto it = std::remove_if(list.begin(), list.end(), [&](const T& v) { return pred(v); });
+            removed += static_cast<size_t>(list.end() - it);
+            list.erase(it, list.end());
+        };
+
+        size_t next;
+        std::string_view seg = segmentAt(p, pos, next);
+        bool last = next == std::string_view::npos;
+
+        auto copy = std::make_shared<Node>(*n);
+        if (seg == topic::ANY_REST) {
+            dropFrom(copy->rest);
+            return copy->empty() ? nullptr : copy;
+        }
+
+        NodePtr* slot = nullptr;
+        if (seg == topic::ANY_ONE) {
+            slot = &copy->any_one;
+        } else {
+            auto it = std::lower_bound(copy->children.begin(), copy->children.end(), seg,
+                [](const auto& c, std::string_view s) { return std::string_view(c.first) < s; });
+            if (it == copy->children.end() || it->first != seg) return copy;
+            slot = &it->second;
+        }
+        if (!*slot) return copy;
+
+        std::shared_ptr<Node> child;
+        if (last) {
+            child = std::make_shared<Node>(**slot);
+            dropFrom(child->exact);
+            if (child->empty()) child.reset();
+        } else {
+            size_t before = removed;
+            child = erase(slot->get(), p, next, pred, removed);
+            if (removed == before) return copy;
+        }
+
+        if (child) {
+            *slot = std::move(child);
+        } else if (seg == topic::ANY_ONE) {
+            copy->any_one.reset();
+        } else {
+            copy->children.erase(std::find_if(copy->children.begin(), copy->children.end(),
+                [&](const auto& c) { return c.first == seg; }));
+        }
+        return copy->empty() ? nullptr : copy;
+    }
+
+    std::mutex update_mutex_;       // 갱신끼리만 직렬화 (match 는 잡지 않음)
+    NodePtr root_;
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "result.h"
+
+// NOTE
+// tools/generator/gen_command_types.py 가 생성한 struct 의 encode / decode 지원
+//
+//   [0]     MAGIC 0xB2 (binary Message 0xB1, JSON '{' 와 구분)
+//   [1]     VERSION 1
+//   [2..3]  reserved
+//   [4..7]  schema id (생성 시 field 이름 / 타입으로 계산)
+//   [8..]   고정 영역 - field 별 compile-time offset
+//           string / bytes 는 {u32 offset, u32 size} (버퍼 시작 기준)
+//   [...]   가변 영역 - string / bytes 내용
+//
+// decode 는 크기 / schema / 가변 영역 범위만 확인하고 string 은 버퍼를 그대로 가리킴
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "typed_codec assumes a little-endian target"
+#endif
+
+namespace typed {
+
+inline constexpr uint8_t MAGIC       = 0xB2;
+inline constexpr uint8_t VERSION     = 1;
+inline constexpr size_t  HEADER_SIZE = 8;
+inline constexpr size_t  REF_SIZE    = 8;      // string / bytes 참조 {offset, size}
+
+inline bool isTyped(std::string_view buf) noexcept {
+    return buf.size() >= HEADER_SIZE && static_cast<uint8_t>(buf[0]) == MAGIC;
+}
+
+// ------------------------------------------------------
+// Writer - 고정 영역을 먼저 확보하고 가변 영역은 뒤에 이어 씀
+// ------------------------------------------------------
+class Writer {
+public:
+    Writer(std::string& out, uint32_t schema_id, size_t fixed_size)
+        : out_(out), base_(out.size()) {
+        out_.resize(base_ + HEADER_SIZE + fixed_size, '\0');
+        char* p = out_.data() + base_;
+        p[0] = static_cast<char>(MAGIC);
+        p[1] = static_cast<char>(VERSION);
+        std::memcpy(p + 4, &schema_id, sizeof(schema_id));
+    }
+
+    template<typename V>
+    void put(size_t offset, V v) noexcept {
+        std::memcpy(out_.data() + base_ + HEADER_SIZE + offset, &v, sizeof(V));
+    }
+
+    void putBlock(size_t offset, const void* data, size_t size) {
+        uint32_t ref[2] = {static_cast<uint32_t>(out_.size() - base_), static_cast<uint32_t>(size)};
+        out_.append(static_cast<const char*>(data), size);
+        std::memcpy(out_.data() + base_ + HEADER_SIZE + offset, ref, sizeof(ref));
+    }
+
+    void putString(size_t offset, std::string_view s) { putBlock(offset, s.data(), s.size()); }
+
+private:
+    std::string& out_;
+    size_t base_;
+};
+
+// ------------------------------------------------------
+// Reader - 검증은 생성자 + getBlock 의 범위 확인뿐
+// ------------------------------------------------------
+class Reader {
+public:
+    Reader(std::string_view buf, uint32_t schema_id, size_t fixed_size) noexcept : buf_(buf) {
+        if (!isTyped(buf) || buf.size() < HEADER_SIZE + fixed_size) {
+            error_ = "buffer too small or not a typed message";
+            return;
+        }
+        if (static_cast<uint8_t>(buf[1]) != VERSION) {
+            error_ = "unsupported typed message version";
+            return;
+        }
+        uint32_t id;
+        std::memcpy(&id, buf.data() + 4, sizeof(id));
+        if (id != schema_id) error_ = "schema mismatch";
+    }
+
+    bool ok() const noexcept { return error_ == nullptr; }
+    const char* error() const noexcept { return error_; }
+
+    template<typename V>
+    V get(size_t offset) const noexcept {
+        V v;
+        std::memcpy(&v, buf_.data() + HEADER_SIZE + offset, sizeof(V));
+        return v;
+    }
+
+    bool getString(size_t offset, std::string_view& out) noexcept {
+        uint32_t ref[2];
+        std::memcpy(ref, buf_.data() + HEADER_SIZE + offset, sizeof(ref));
+        if (ref[0] > buf_.size() || ref[1] > buf_.size() - ref[0]) {
+            error_ = "string out of range";
+            return false;
+        }
+        out = buf_.substr(ref[0], ref[1]);
+        return true;
+    }
+
+    template<typename T>
+    Result<T> fail() const { return Result<T>::Error(ResultCode::ProtocolError, error_); }
+
+private:
+    std::string_view buf_;
+    const char* error_ = nullptr;
+};
+
+} // namespace typed
@@ -0,0 +1,307 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "result.h"
+
+// NOTE
+// binary wire format (message::Codec::Binary)
+//
+//   [0]  MAGIC   0xB1            ('{' 로 시작하는 JSON 과 구분)
+//   [1]  VERSION 1
+//   varint field_count
+//   field * field_count
+//       varint tag = (field_id << 3) | WireType
+//       field_id == 0 이면 varint name_len + name (FieldTable 에 없는 key)
+//       value
+//           Int     zigzag varint
+//           Double  8 byte little endian
+//           False / True  (값 없음)
+//           String / Bytes  varint len + bytes
+//
+// FieldTable::instance().add(1, "sample");      // 양쪽 process 가 같은 id 로 등록
+
+namespace wire {
+
+inline constexpr uint8_t MAGIC   = 0xB1;
+inline constexpr uint8_t VERSION = 1;
+
+enum class WireType : uint8_t {
+    Int    = 0,
+    Double = 1,
+    False  = 2,
+    True   = 3,
+    String = 4,
+    Bytes  = 5,
+};
+
+// ------------------------------------------------------
+// varint / zigzag
+// ------------------------------------------------------
+inline uint64_t zigzagEncode(int64_t v) noexcept {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t zigzagDecode(uint64_t v) noexcept {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+inline void putVarint(std::string& out, uint64_t v) {
+    char buf[10];
+    size_t n = 0;
+    while (v >= 0x80) {
+        buf[n++] = static_cast<char>(v | 0x80);
+        v >>= 7;
+    }
+    buf[n++] = static_cast<char>(v);
+    out.append(buf, n);
+}
+
+// return: false (버퍼 부족 / 10 byte 초과)
+inline bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v) noexcept {
+    v = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t b = *p++;
+        v |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+
+// ------------------------------------------------------
+// FieldTable - key 문자열 <-> field id (양쪽에서 같은 id 로 등록)
+//  읽기는 snapshot 으로 lock 없이, 등록은 copy-on-write
+// ------------------------------------------------------
+class FieldTable {
+public:
+    struct Snapshot {
+        std::unordered_map<std::string_view, uint32_t> ids;     // names 를 가리킴
+        std::vector<std::string> names;             // index = id (0 은 미사용)
+
+        uint32_t idOf(std::string_view name) const noexcept {
+            auto it = ids.find(name);
+            return it == ids.end() ? 0 : it->second;
+        }
+        std::string_view nameOf(uint32_t id) const noexcept {
+            return id < names.size() ? std::string_view(names[id]) : std::string_view{};
+        }
+    };
+
+    static FieldTable& instance() {
+        static FieldTable table;
+        return table;
+    }
+
+    Result<void> add(uint32_t id, const std::string& name) {
+        if (id == 0 || id > MAX_ID) return Error(ResultCode::OutOfRange, "field id must be 1.." + std::to_string(MAX_ID));
+        if (name.empty()) return Error(ResultCode::InvalidArgument, "field name is empty");
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto cur = snapshot();
+        if (auto it = cur->ids.find(name); it != cur->ids.end()) {
+            if (it->second == id) return OK();
+            return Error(ResultCode::AlreadyExists, "field '" + name + "' already has another id");
+        }
+        if (id < cur->names.size() && !cur->names[id].empty()) {
+            return Error(ResultCode::AlreadyExists, "field id " + std::to_string(id) + " already used");
+        }
+
+        // ids 는 names 를 가리키므로 새 snapshot 의 names 기준으로 다시 구성
+        auto next = std::make_shared<Snapshot>();
+        next->names = cur->names;
+        if (next->names.size() <= id) next->names.resize(id + 1);
+        next->names[id] = name;
+        for (uint32_t i = 1; i < next->names.size(); ++i) {
+            if (!next->names[i].empty()) next->ids.emplace(next->names[i], i);
+        }
+        std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(std::move(next)));
+        return OK();
+    }
+
+    std::shared_ptr<const Snapshot> snapshot() const {
+        return std::atomic_load(&snapshot_);
+    }
+
+    static constexpr uint32_t MAX_ID = (1u << 20);
+
+private:
+    FieldTable() : snapshot_(std::make_shared<Snapshot>()) { }
+
+    std::mutex mutex_;
+    std::shared_ptr<const Snapshot> snapshot_;
+};
+
+
+// ------------------------------------------------------
+// WireWriter - 하나의 메시지를 out 버퍼에 이어서 씀
+// ------------------------------------------------------
+class WireWriter {
+public:
+    explicit WireWriter(std::string& out, uint32_t field_count,
+                        std::shared_ptr<const FieldTable::Snapshot> table = FieldTable::instance().snapshot())
+        : out_(out), table_(std::move(table)) {
+        out_.push_back(static_cast<char>(MAGIC));
+        out_.push_back(static_cast<char>(VERSION));
+        putVarint(out_, field_count);
+    }
+
+    void putInt(std::string_view key, int64_t v) {
+        putKey(key, WireType::Int);
+        putVarint(out_, zigzagEncode(v));
+    }
+
+    void putDouble(std::string_view key, double v) {
+        putKey(key, WireType::Double);
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        char buf[8];
+        for (int i = 0; i < 8; ++i) buf[i] = static_cast<char>(bits >> (8 * i));
+        out_.append(buf, sizeof(buf));
+    }
+
+    void putBool(std::string_view key, bool v) {
+        putKey(key, v ? WireType::True : WireType::False);
+    }
+
+    void putString(std::string_view key, std::string_view v) {
+        putKey(key, WireType::String);
+        putVarint(out_, v.size());
+        out_.append(v.data(), v.size());
+    }
+
+    void putBytes(std::string_view key, const void* data, size_t size) {
+        putKey(key, WireType::Bytes);
+        putVarint(out_, size);
+        out_.append(static_cast<const char*>(data), size);
+    }
+
+private:
+    void putKey(std::string_view key, WireType type) {
+        uint32_t id = table_->idOf(key);
+        putVarint(out_, (static_cast<uint64_t>(id) << 3) | static_cast<uint8_t>(type));
+        if (id == 0) {
+            putVarint(out_, key.size());
+            out_.append(key.data(), key.size());
+        }
+    }
+
+    std::string& out_;
+    std::shared_ptr<const FieldTable::Snapshot> table_;
+};
+
+
+// ------------------------------------------------------
+// WireReader - 복사 없는 reader, name / String / Bytes 는 입력 버퍼를 가리킴
+// ------------------------------------------------------
+struct WireField {
+    uint32_t id = 0;
+    std::string_view name;
+    WireType type = WireType::Int;
+    int64_t i = 0;
+    double d = 0.0;
+    std::string_view bytes;         // String / Bytes
+
+    bool boolean() const noexcept { return type == WireType::True; }
+};
+
+class WireReader {
+public:
+    explicit WireReader(std::string_view buf,
+                        std::shared_ptr<const FieldTable::Snapshot> table = FieldTable::instance().snapshot())
+        : p_(reinterpret_cast<const uint8_t*>(buf.data())), end_(p_ + buf.size()), table_(std::move(table)) {
+        if (buf.size() < 2 || p_[0] != MAGIC) { fail("bad magic"); return; }
+        if (p_[1] != VERSION) { fail("unsupported version"); return; }
+        p_ += 2;
+        uint64_t count;
+        if (!getVarint(p_, end_, count)) { fail("truncated header"); return; }
+        remaining_ = count;
+        count_ = count;
+    }
+
+    static bool isBinary(std::string_view buf) noexcept {
+        return !buf.empty() && static_cast<uint8_t>(buf[0]) == MAGIC;
+    }
+
+    size_t count() const noexcept { return count_; }
+    bool ok() const noexcept { return error_ == nullptr; }
+    const char* error() const noexcept { return error_; }
+
+    // return: false (끝 또는 오류 - ok() 로 구분)
+    bool next(WireField& f) {
+        if (error_ || remaining_ == 0) return false;
+
+        uint64_t tag;
+        if (!getVarint(p_, end_, tag)) return fail("truncated tag");
+        f.id   = static_cast<uint32_t>(tag >> 3);
+        f.type = static_cast<WireType>(tag & 0x07);
+
+        if (f.id == 0) {
+            std::string_view name;
+            if (!getBlock(name)) return fail("truncated field name");
+            f.name = name;
+        } else {
+            f.name = table_->nameOf(f.id);
+            if (f.name.empty()) return fail("unknown field id");
+        }
+
+        switch (f.type) {
+        case WireType::Int: {
+            uint64_t v;
+            if (!getVarint(p_, end_, v)) return fail("truncated int");
+            f.i = zigzagDecode(v);
+            break;
+        }
+        case WireType::Double: {
+            if (end_ - p_ < 8) return fail("truncated double");
+            uint64_t bits = 0;
+            for (int i = 0; i < 8; ++i) bits |= static_cast<uint64_t>(p_[i]) << (8 * i);
+            std::memcpy(&f.d, &bits, sizeof(bits));
+            p_ += 8;
+            break;
+        }
+        case WireType::False:
+        case WireType::True:
+            break;
+        case WireType::String:
+        case WireType::Bytes:
+            if (!getBlock(f.bytes)) return fail("truncated string");
+            break;
+        default:
+            return fail("unknown wire type");
+        }
+
+        --remaining_;
+        return true;
+    }
+
+private:
+    bool getBlock(std::string_view& out) {
+        uint64_t len;
+        if (!getVarint(p_, end_, len) || len > static_cast<uint64_t>(end_ - p_)) return false;
+        out = std::string_view(reinterpret_cast<const char*>(p_), len);
+        p_ += len;
+        return true;
+    }
+
+    bool fail(const char* why) noexcept {
+        error_ = why;
+        return false;
+    }
+
+    const uint8_t* p_;
+    const uint8_t* end_;
+    std::shared_ptr<const FieldTable::Snapshot> table_;
+    uint64_t remaining_ = 0;
+    size_t count_ = 0;
+    const char* error_ = nullptr;
+};
+
+} // namespace wire
@@ -0,0 +1,236 @@
+#pragma once
+#include <zmq.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "result.h"
+#include "logging.hpp"
+#include "raw_message.hpp"
+
+// NOTE
+// host (모든 subsystem 을 dlopen 하는 process)
+//   SubsystemParams params = {..., &ZmqContext::instance()};
+//
+// subsystem create()
+//   if (params->bus_context)
+//       ZmqContext::adopt(static_cast<ZmqContext*>(params->bus_context));
+//
+// 같은 process 의 bus 끼리는 endpoint 를 그대로 써도 자동으로 inproc / direct 로 연결
+//   pub : tcp://*:5555            -> tcp + inproc://bus.tcp:5555 bind
+//   sub : tcp://127.0.0.1:5555    -> inproc://bus.tcp:5555 connect (같은 zmq context)
+
+// 같은 process 안의 peer 와 통신하는 방식 (publisher 쪽에서 결정)
+enum class LocalTransport {
+    None,       // 항상 지정한 endpoint 사용 (tcp loopback 포함)
+    Inproc,     // inproc alias 로 연결 - kernel 을 거치지 않음
+    Direct,     // ZMQ 없이 publisher thread 에서 구독자 callback 직접 호출
+};
+
+// ------------------------------------------------------
+// LocalChannel - Direct publisher 하나 <-> 같은 process 의 구독자들
+//  sink 는 publisher thread 에서 호출됨
+//  detach() 는 진행 중인 publish 가 끝날 때까지 대기 (callback 안에서 detach 금지)
+// ------------------------------------------------------
+class LocalChannel {
+public:
+    using Sink = std::function<void(const RawMessage&)>;
+
+    void attach(const void* token, Sink sink) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        sinks_.emplace_back(token, std::move(sink));
+        count_.store(sinks_.size(), std::memory_order_release);
+    }
+
+    void detach(const void* token) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (auto it = sinks_.begin(); it != sinks_.end();) {
+            if (it->first == token) it = sinks_.erase(it);
+            else ++it;
+        }
+        count_.store(sinks_.size(), std::memory_order_release);
+    }
+
+    bool empty() const noexcept { return count_.load(std::memory_order_acquire) == 0; }
+
+    // return: 전달한 구독자(sink) 수
+    size_t publish(const RawMessage& m) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (auto& [token, sink] : sinks_) sink(m);
+        return sinks_.size();
+    }
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::vector<std::pair<const void*, Sink>> sinks_;
+    std::atomic<size_t> count_{0};
+};
+
+
+// ------------------------------------------------------
+// ZmqContext - process 전역 zmq context + 같은 process endpoint 목록
+//  inproc 은 같은 zmq context 안에서만 동작하므로 모든 bus 가 이 context 를 공유
+//  subsystem 은 dlopen 으로 올라오므로 host 의 instance 를 adopt 해서 사용
+// ------------------------------------------------------
+class ZmqContext {
+public:
+    // connect 할 endpoint 를 같은 process publisher 기준으로 바꾼 결과
+    struct Resolved {
+        std::string endpoint;                       // 실제 connect 할 endpoint
+        std::shared_ptr<LocalChannel> channel;      // Direct publisher 이면 설정 (connect 안 함)
+    };
+
+    // publisher 가 bind 시 같이 써야 할 정보
+    struct Binding {
+        std::string alias;                          // 추가로 bind 할 inproc endpoint (없으면 empty)
+        std::shared_ptr<LocalChannel> channel;      // Direct 일 때
+    };
+
+    static ZmqContext& instance() {
+        if (auto* shared = adopted().load(std::memory_order_acquire)) return *shared;
+        return local();
+    }
+
+    // dlopen 된 subsystem 에서 host 의 context 사용 - 이 module 에서 socket 을 만들기 전에 호출
+    static Result<void> adopt(ZmqContext* shared) {
+        if (!shared || shared == &local()) return OK();
+        if (local().created()) {
+            return Error(ResultCode::InvalidState, "local zmq context already in use");
+        }
+        adopted().store(shared, std::memory_order_release);
+        return OK();
+    }
+
+    ~ZmqContext() {
+        if (context_) zmq_ctx_term(context_);
+    }
+
+    ZmqContext(const ZmqContext&)            = delete;
+    ZmqContext& operator=(const ZmqContext&) = delete;
+
+    void* get() {
+        std::call_once(once_, [this] {
+            context_ = zmq_ctx_new();
+            if (!context_) {
+                LOGE("zmq_ctx_new failed: {}", zmq_strerror(zmq_errno()));
+                return;
+            }
+            // 닫히지 않은 socket 이 남아 있어도 종료 시 대기하지 않음
+            zmq_ctx_set(context_, ZMQ_BLOCKY, 0);
+        });
+        return context_;
+    }
+
+    bool created() const noexcept { return context_ != nullptr; }
+
+    // -------------------------
+    // 같은 process endpoint 목록
+    // -------------------------
+
+    // publisher 등록 - 같은 endpoint 를 다른 publisher 가 이미 등록했으면 AlreadyExists
+    Result<Binding> bindLocal(const std::string& endpoint, LocalTransport mode, const void* owner) {
+        if (mode == LocalTransport::None) return Result<Binding>::OK({});
+
+        std::string key = localKey(endpoint, true);
+        if (key.empty()) return Result<Binding>::OK({});
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& slot = endpoints_[key];
+        if (slot.owner && slot.owner != owner) {
+            return Result<Binding>::Error(ResultCode::AlreadyExists, "endpoint already bound in process: " + endpoint);
+        }
+        slot.owner = owner;
+        slot.mode  = mode;
+        slot.alias = aliasOf(key, endpoint);
+        if (mode == LocalTransport::Direct && !slot.channel) {
+            slot.channel = std::make_shared<LocalChannel>();
+        }
+
+        Binding b;
+        if (slot.alias != endpoint) b.alias = slot.alias;
+        if (mode == LocalTransport::Direct) b.channel = slot.channel;
+        return Result<Binding>::OK(std::move(b));
+    }
+
+    void unbindLocal(const std::string& endpoint, const void* owner) {
+        std::string key = localKey(endpoint, true);
+        if (key.empty()) return;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = endpoints_.find(key);
+        if (it != endpoints_.end() && it->second.owner == owner) endpoints_.erase(it);
+    }
+
+    // 등록된 같은 process publisher 가 없으면 endpoint 그대로
+    Resolved resolve(const std::string& endpoint) const {
+        std::string key = localKey(endpoint, false);
+        if (!key.empty()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = endpoints_.find(key);
+            if (it != endpoints_.end()) {
+                if (it->second.mode == LocalTransport::Direct) return {it->second.alias, it->second.channel};
+                return {it->second.alias, nullptr};
+            }
+        }
+        return {endpoint, nullptr};
+    }
+
+protected:
+    static constexpr const char* LOG_TAG = "ZmqContext";
+
+private:
+    struct LocalEndpoint {
+        const void* owner = nullptr;
+        LocalTransport mode = LocalTransport::None;
+        std::string alias;
+        std::shared_ptr<LocalChannel> channel;
+    };
+
+    ZmqContext() = default;
+
+    static ZmqContext& local() {
+        static ZmqContext context;
+        return context;
+    }
+
+    static std::atomic<ZmqContext*>& adopted() {
+        static std::atomic<ZmqContext*> shared{nullptr};
+        return shared;
+    }
+
+    // tcp://<local host>:port -> "tcp:port", ipc://path -> "ipc:path", inproc://name -> 그대로
+    // local host 가 아닌 tcp 등은 empty (같은 process 판별 불가)
+    static std::string localKey(const std::string& endpoint, bool bind) {
+        static const std::string TCP = "tcp://", IPC = "ipc://", INPROC = "inproc://";
+
+        if (endpoint.compare(0, INPROC.size(), INPROC) == 0) return endpoint;
+        if (endpoint.compare(0, IPC.size(), IPC) == 0) return "ipc:" + endpoint.substr(IPC.size());
+        if (endpoint.compare(0, TCP.size(), TCP) != 0) return {};
+
+        auto colon = endpoint.rfind(':');
+        if (colon == std::string::npos || colon < TCP.size()) return {};
+        std::string host = endpoint.substr(TCP.size(), colon - TCP.size());
+        std::string port = endpoint.substr(colon + 1);
+
+        bool local = host == "127.0.0.1" || host == "localhost" || host == "lo";
+        if (bind) local = local || host == "*" || host == "0.0.0.0";
+        return local && !port.empty() ? "tcp:" + port : std::string{};
+    }
+
+    static std::string aliasOf(const std::string& key, const std::string& endpoint) {
+        if (key == endpoint) return endpoint;                       // 이미 inproc
+        return "inproc://bus." + key;
+    }
+
+    std::once_flag once_;
+    void* context_ = nullptr;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, LocalEndpoint> endpoints_;
+};
@@ -0,0 +1,129 @@
+#pragma once
+#include <zmq.h>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "result.h"
+#include "raw_message.hpp"
+
+// NOTE
+// ZmqMultipart parts;
+// auto r = parts.recv(socket, ZMQ_DONTWAIT);   // 모든 frame 수신 (크기 제한 없음)
+// auto topic   = parts[0].view();
+// auto payload = parts[1].view();
+
+// ------------------------------------------------------
+// ZmqFrame - zmq_msg_t RAII
+//  수신한 데이터는 libzmq 버퍼를 그대로 사용 (복사 없음)
+// ------------------------------------------------------
+class ZmqFrame {
+public:
+    ZmqFrame() noexcept { zmq_msg_init(&msg_); }
+
+    // data 소유권을 zmq 로 이전 - 전송 완료 후 zmq I/O thread 에서 free_fn(data, hint) 호출
+    ZmqFrame(void* data, size_t size, zmq_free_fn* free_fn, void* hint) noexcept {
+        if (zmq_msg_init_data(&msg_, data, size, free_fn, hint) != 0) {
+            zmq_msg_init(&msg_);
+            if (free_fn) free_fn(data, hint);
+            valid_ = false;
+        }
+    }
+    ~ZmqFrame() { zmq_msg_close(&msg_); }
+
+    ZmqFrame(const ZmqFrame&)            = delete;
+    ZmqFrame& operator=(const ZmqFrame&) = delete;
+
+    ZmqFrame(ZmqFrame&& other) noexcept : valid_(other.valid_) {
+        zmq_msg_init(&msg_);
+        zmq_msg_move(&msg_, &other.msg_);
+    }
+    ZmqFrame& operator=(ZmqFrame&& other) noexcept {
+        if (this != &other) {
+            zmq_msg_move(&msg_, &other.msg_);
+            valid_ = other.valid_;
+        }
+        return *this;
+    }
+
+    // return: ResourceBusy (DONTWAIT 에서 수신할 것 없음), Cancelled (context 종료)
+    Result<void> recv(void* socket, int flags = 0) {
+        if (zmq_msg_recv(&msg_, socket, flags) >= 0) return OK();
+        return errorOf(zmq_errno());
+    }
+
+    Result<void> send(void* socket, int flags = 0) {
+        if (zmq_msg_send(&msg_, socket, flags) >= 0) return OK();
+        return errorOf(zmq_errno());
+    }
+
+    const char* data() const noexcept { return static_cast<const char*>(zmq_msg_data(msg())); }
+    size_t size() const noexcept { return zmq_msg_size(&msg_); }
+    bool more() const noexcept { return zmq_msg_more(&msg_) != 0; }
+    bool valid() const noexcept { return valid_; }
+
+    std::string_view view() const noexcept { return {data(), size()}; }
+
+    zmq_msg_t* handle() noexcept { return &msg_; }
+
+    static Result<void> errorOf(int err) {
+        if (err == EAGAIN) return Error(ResultCode::ResourceBusy, "no message");
+        if (err == ETERM)  return Error(ResultCode::Cancelled, "context terminated");
+        if (err == EINTR)  return Error(ResultCode::Cancelled, "interrupted");
+        return Error(ResultCode::SocketError, zmq_strerror(err));
+    }
+
+private:
+    // zmq_msg_data 는 non-const 인자를 받음
+    zmq_msg_t* msg() const noexcept { return const_cast<zmq_msg_t*>(&msg_); }
+
+    zmq_msg_t msg_;
+    bool valid_ = true;
+};
+
+
+// ------------------------------------------------------
+// ZmqMultipart - 한 메시지의 모든 frame
+// ------------------------------------------------------
+class ZmqMultipart {
+public:
+    // 첫 frame 만 flags 적용, 나머지 frame 은 이미 도착해 있으므로 blocking 수신
+    Result<void> recv(void* socket, int flags = 0) {
+        frames_.clear();
+        do {
+            ZmqFrame frame;
+            auto r = frame.recv(socket, frames_.empty() ? flags : 0);
+            if (!r) return r;
+            frames_.push_back(std::move(frame));
+        } while (frames_.back().more());
+        return OK();
+    }
+
+    size_t size() const noexcept { return frames_.size(); }
+    bool empty() const noexcept { return frames_.empty(); }
+
+    ZmqFrame& operator[](size_t i) noexcept { return frames_[i]; }
+    const ZmqFrame& operator[](size_t i) const noexcept { return frames_[i]; }
+
+    std::string_view view(size_t i) const noexcept {
+        return i < frames_.size() ? frames_[i].view() : std::string_view{};
+    }
+
+private:
+    std::vector<ZmqFrame> frames_;
+};
+
+
+// frame 0 = topic, frame 1 = payload 인 pub/sub 메시지를 RawMessage 로 변환
+// multipart 소유권은 RawMessage::owner 로 이동
+inline RawMessage toRawMessage(ZmqMultipart&& parts) {
+    auto owner = std::make_shared<ZmqMultipart>(std::move(parts));
+    RawMessage raw;
+    raw.topic   = owner->view(0);
+    raw.payload = owner->view(1);
+    raw.owner   = std::move(owner);
+    return raw;
+}
@@ -1,138 +1,909 @@
 #pragma once
 #include "message_bus.hpp"
 #include <zmq.h>
+#include <algorithm>
+#include <functional>
 #include <thread>
 #include <atomic>
+#include <mutex>
 #include <unordered_map>
 
 #include "message.hpp"
+#include "zmq_frame.hpp"
+#include "zmq_subscriber.hpp"
+#include "zmq_context.hpp"
+#include "zmq_request_client.hpp"
+#include "zmq_reply_server.hpp"
+#include "shm_ring.hpp"
+#include "periodic_worker.hpp"
+#include "topic_batcher.hpp"
+#include "last_value_cache.hpp"
+#include "flow_control.hpp"
+#include "message_journal.hpp"
+#include "bus_metrics.hpp"
 
+// NOTE
+// 같은 process 의 bus 끼리는 endpoint 설정을 바꾸지 않아도 inproc 으로 연결됨
+// (publisher bus 가 subscriber bus 보다 먼저 생성된 경우 - 아니면 tcp 로 동작)
+//
+// ZmqMessageBusDescriptor d;
+// d.local_transport = LocalTransport::Direct;   // 같은 process 구독자는 publish thread 에서 바로 호출
+//
+// 같은 host 의 다른 process 와는 shared memory ring
+// d.pub_endpoint  = "shm://sample";
+// d.sub_endpoints = {"shm://gui"};
+//
+// request 는 endpoint 별 DEALER socket 을 유지하고 여러 요청을 동시에 보냄
+// auto f = bus.requestAsync("tcp://127.0.0.1:5600", "ping");   // std::future<Result<std::string>>
+// auto r = bus.request("tcp://127.0.0.1:5600", "ping", 500);   // Result<std::string>, 500 ms deadline
+// FiberTask 안에서 호출한 request / snapshot 요청은 응답까지 fiber 만 park (carrier 를 막지 않음)
+//
+// reply 는 ROUTER + handler worker (reply_workers 개 thread 또는 reply_pool) - 느린 요청이 다른 요청을 막지 않음
+// bus.reply("tcp://*:5600", handler);
+// bus.replyStats("tcp://*:5600")->active ...
+//
+// 작은 메시지가 많은 topic 은 모아서 frame 하나로 전송 (구독 쪽은 자동으로 풀어서 전달)
+// d.batch_topics = {"telemetry.#"};
+// d.batch_max_delay_ms = 2;                    // 첫 메시지 이후 최대 2 ms 지연
+// bus.batchStats()->messages / bus.batchStats()->batches ...
+//
+// 상태 topic 은 마지막 값을 보관하고 늦게 시작한 구독자에게 snapshot 으로 전달
+// d.cache_topics      = {"state.#"};
+// d.snapshot_endpoint = "tcp://*:5557";       // 구독 쪽: bus.subscribeSnapshot("state.#", "tcp://host:5557", cb)
+//
+// 유실되면 안 되는 topic 은 lossless - 구독자 ACK 로 credit 제어, 빠진 메시지는 NACK 로 재전송
+// d.lossless_topics  = {"cmd.result.#"};
+// d.control_endpoint = "tcp://*:5558";        // 구독 쪽: bus.subscribeReliable("cmd.result.#", "tcp://host:5558", cb)
+// d.pub_hwm = 10000;                           // 나머지 (best-effort) 는 HWM 에 걸린 구독자에게만 버림
+//                                              // (publisher 에서는 보이지 않음 - 구독 쪽 metrics_stamp 의 gaps / lost)
+//
+// publish 를 파일에 기록 (재생 : journal_replay tool 또는 JournalReader)
+// d.journal_directory = "/var/lib/app/journal";
+// d.journal_topics    = {"cmd.#", "state.#"};  // 비어 있으면 전부
+//
+// 큰 메시지에서 일부 field 만 읽는 구독은 view - 읽은 field 만 decode
+// bus.subscribeView("state.#", [](const message::MessageView& v) { v.getOr<int>("op", 0); });
+//
+// topic 별 송수신 / decode / callback / drop 계수와 end-to-end latency (bus_metrics.hpp)
+// d.metrics_stamp       = true;                // 송신 시각 + seq frame - 구독 쪽 bus 가 latency / gap 기록
+// d.metrics_interval_ms = 1000;                // 주기적으로 metrics_topic 에 publish
+// for (auto& t : bus.metricsSnapshot()) ... t.latency_p99_ns, t.lost
+
+struct ZmqMessageBusDescriptor {
+    std::string pub_endpoint = "tcp://*:5555";
+    std::vector<std::string> sub_endpoints = {"tcp://127.0.0.1:5555"};
+    size_t poll_loops = 1;              // 구독 poll loop 수
+    std::vector<int> affinity;          // poll loop affinity
+    void* context = nullptr;            // nullptr 이면 process 공유 context (ZmqContext)
+    LocalTransport local_transport = LocalTransport::Inproc;    // 같은 process 구독자 전달 방식
+    size_t shm_capacity = 4 << 20;      // pub_endpoint 가 shm:// 일 때 ring 크기 (2 의 거듭제곱)
+    task::ThreadPool* callback_pool = nullptr;  // 구독 callback 을 pool 에서 실행 (topic 별 순서 유지)
+    size_t request_connections = 1;     // request endpoint 당 DEALER socket 수
+    int request_timeout_ms = 3000;      // request 기본 deadline
+    size_t reply_workers = 4;           // reply endpoint 당 handler thread 수
+    task::ThreadPool* reply_pool = nullptr;     // 지정 시 reply handler 를 pool 에서 실행 (reply_workers 무시)
+    std::vector<std::string> batch_topics;      // batch 전송할 topic pattern (비어 있으면 사용 안 함, ZMQ 경로만)
+    size_t batch_max_bytes = 16 << 10;
+    size_t batch_max_messages = 256;
+    int batch_max_delay_ms = 2;
+    std::vector<std::string> cache_topics;      // 마지막 값 + seq 를 보관할 topic pattern (batch 하지 않음)
+    size_t cache_max_topics = 65536;
+    std::string snapshot_endpoint;              // 지정 시 이 endpoint 에서 snapshot 요청에 응답 (요청 = topic pattern)
+    std::vector<std::string> lossless_topics;   // 구독자 ACK 로 credit 제어 + NACK 재전송 (batch 하지 않음, ZMQ 경로만)
+    size_t lossless_window = 1024;              // topic 당 ACK 되지 않은 메시지 상한 = 재전송 보관 수
+    int lossless_block_ms = 1000;               // credit 대기 상한 - 넘으면 publish 가 ResourceBusy
+    int lossless_peer_timeout_ms = 3000;        // ACK 가 끊긴 구독자는 credit 계산에서 제외
+    std::string control_endpoint;               // lossless ACK / NACK 를 받는 endpoint (lossless_topics 사용 시 필요)
+    int pub_hwm = 1000;                         // PUB socket 송신 high-water mark (0 = 무제한)
+    int sub_hwm = 1000;                         // SUB socket 수신 high-water mark (0 = 무제한)
+    int reliable_tick_ms = 50;                  // subscribeReliable 의 ACK / 재요청 주기
+    std::string journal_directory;              // 지정 시 publish 를 journal 에 기록 (message_journal.hpp)
+    std::string journal_name = "bus";           // 같은 directory 를 쓰는 bus 가 여럿이면 다르게
+    std::vector<std::string> journal_topics;    // 기록할 topic pattern (비어 있으면 전부)
+    size_t journal_segment_bytes = 64 << 20;
+    size_t journal_max_segments = 0;            // 0 = 무제한
+    bool metrics = false;                       // topic 별 송수신 / decode / callback / drop 계수 (bus_metrics.hpp)
+    bool metrics_stamp = false;                 // ZMQ 로 보내는 메시지에 STAMP frame (송신 시각 + seq) - metrics 포함
+    int metrics_interval_ms = 0;                // > 0 이면 주기적으로 metrics_topic 에 topic 별 계수 publish
+    std::string metrics_topic = "sys.metrics.bus";
+};
+
+// PUB socket 단위 - ZmqMessageBus::pubStats()
+struct ZmqPubStats {
+    std::atomic<int> hwm{0};
+    std::atomic<size_t> sent{0};                // 보낸 message (batch 는 1)
+};
+
+// bus 보다 오래 유지되어도 안전 - subscriber 가 이미 해제되었으면 아무것도 하지 않음
 class ZmqMessageSubscription : public MessageSubscription {
 public:
-    ZmqMessageSubscription(std::atomic<bool>& running) 
-        : running_(running) {}
+    ZmqMessageSubscription(std::weak_ptr<ZmqPollSubscriber> subscriber, SubscriptionId id)
+        : subscriber_(std::move(subscriber)), id_(id) {}
+
+    ~ZmqMessageSubscription() override {
+        unsubscribe();
+    }
 
     Result<void> unsubscribe() override {
-        running_.store(false);
+        if (done_.exchange(true)) return OK();
+        auto subscriber = subscriber_.lock();
+        if (!subscriber) return OK();
+        return subscriber->remove(id_);
     }
 private:
-    std::atomic<bool>& running_;
+    std::weak_ptr<ZmqPollSubscriber> subscriber_;
+    SubscriptionId id_;
+    std::atomic<bool> done_{false};
 };
 
 
 class ZmqMessageBus : public MessageBus {
 public:
-    ZmqMessageBus() {
-        context_ = zmq_ctx_new();
+    explicit ZmqMessageBus(ZmqMessageBusDescriptor desc = {})
+        : desc_(std::move(desc)), batcher_(batchDescriptor(desc_)), cache_({desc_.cache_topics, desc_.cache_max_topics}),
+          window_(windowDescriptor(desc_)) {
+        if (desc_.metrics || desc_.metrics_stamp || desc_.metrics_interval_ms > 0) metrics_ = std::make_unique<BusMetrics>();
+
+        auto& shared = ZmqContext::instance();
+        context_ = desc_.context ? desc_.context : shared.get();
+
+        // inproc / Direct 는 공유 context 를 쓸 때만 가능
+        if (context_ == shared.get() && desc_.local_transport != LocalTransport::None) {
+            auto b = shared.bindLocal(desc_.pub_endpoint, desc_.local_transport, this);
+            if (b) {
+                local_ = b.value();
+                local_bound_ = true;
+            } else {
+                LOGW("local transport disabled for {}: {}", desc_.pub_endpoint,
+                     to_string(Result<void>::Error(b.code(), b.error())));
+            }
+        }
+
+        // shm ring 은 write 하나가 이미 memcpy 한 번이라 batch 하지 않음
+        if (batcher_.enabled() && !shm::isShmEndpoint(desc_.pub_endpoint)) {
+            // 시간 budget 의 절반 주기로 검사
+            flusher_ = std::make_unique<task::PeriodicWorker>("BusBatchFlush", [this] {
+                std::lock_guard<std::mutex> lock(pub_mutex_);
+                if (pub_socket_) batcher_.flushExpired(batchSender());
+            }, desc_.batch_max_delay_ms / 2);
+            auto r = flusher_->start();
+            if (!r) LOGW("batch flusher start failed: {}", to_string(r));
+        }
+
+        if (!desc_.snapshot_endpoint.empty()) {
+            auto r = addReplyServer(desc_.snapshot_endpoint, [this](const std::string& pattern) {
+                auto s = cache_.snapshot(pattern);
+                return s ? std::move(s.value()) : std::string();    // empty = 잘못된 pattern
+            });
+            if (!r) LOGE("snapshot server {} failed: {}", desc_.snapshot_endpoint, to_string(r));
+        }
+
+        if (!desc_.journal_directory.empty()) {
+            JournalWriterDescriptor jd;
+            jd.directory     = desc_.journal_directory;
+            jd.name          = desc_.journal_name;
+            jd.topics        = desc_.journal_topics;
+            jd.segment_bytes = desc_.journal_segment_bytes;
+            jd.max_segments  = desc_.journal_max_segments;
+            auto j = JournalWriter::create(std::move(jd));
+            if (j) {
+                journal_ = std::move(j.value());
+            } else {
+                LOGE("journal {} disabled: {}", desc_.journal_directory, to_string(Result<void>::Error(j.code(), j.error())));
+            }
+        }
+
+        if (window_.enabled()) {
+            if (desc_.control_endpoint.empty()) {
+                LOGW("lossless topics without control_endpoint - no retransmit / credit");
+            } else {
+                auto r = addReplyServer(desc_.control_endpoint, [this](const std::string& req) { return window_.handle(req); });
+                if (!r) LOGE("control server {} failed: {}", desc_.control_endpoint, to_string(r));
+            }
+        }
+
+        if (desc_.metrics_interval_ms > 0) {
+            metrics_ticker_ = std::make_unique<task::PeriodicWorker>("BusMetrics", [this] { publishMetrics(); },
+                                                                      desc_.metrics_interval_ms);
+            auto r = metrics_ticker_->start();
+            if (!r) LOGW("metrics ticker start failed: {}", to_string(r));
+        }
     }
 
     ~ZmqMessageBus() {
         shutdown();
-        zmq_ctx_destroy(context_);
+        if (local_bound_) ZmqContext::instance().unbindLocal(desc_.pub_endpoint, this);
     }
 
     // -------------------------
     // PUBLISH
     // -------------------------
+    // topic 은 publish 마다 한 번 intern - 이후 window / cache / batch / journal 은 TopicId 로 조회
     Result<void> publish(const std::string& topic, const std::string& msg) override {
-        void* socket = getOrCreatePubSocket();
+        TopicId id = internTopic(topic);
+        if (hasLocalSubscribers()) {
+            auto holder = std::make_shared<const std::string>(msg);
+            return publishShared(id, topic, *holder, holder);
+        }
+        return publishCopy(id, topic, msg.data(), msg.size());
+    }
+
+    // 소유권 이전 publish - payload 는 zmq_msg_init_data 로 그대로 전송 (복사 없음)
+    // 작은 payload 는 zmq 가 어차피 inline 복사하므로 일반 경로 사용
+    Result<void> publish(const std::string& topic, std::string&& msg) override {
+        TopicId id = internTopic(topic);
+        if (hasLocalSubscribers()) {
+            auto holder = std::make_shared<const std::string>(std::move(msg));
+            return publishShared(id, topic, *holder, holder);
+        }
+        if (msg.size() < ZERO_COPY_MIN_SIZE) return publishCopy(id, topic, msg.data(), msg.size());
+
+        auto* holder = new std::string(std::move(msg));
+        return publishFrame(id, topic, ZmqFrame(holder->data(), holder->size(),
+            [](void*, void* hint) { delete static_cast<std::string*>(hint); }, holder));
+    }
+
+    Result<void> publish(const std::string& topic, std::vector<uint8_t>&& msg) override {
+        TopicId id = internTopic(topic);
+        if (hasLocalSubscribers()) {
+            auto holder = std::make_shared<const std::vector<uint8_t>>(std::move(msg));
+            return publishShared(id, topic, std::string_view(reinterpret_cast<const char*>(holder->data()), holder->size()), holder);
+        }
+        if (msg.size() < ZERO_COPY_MIN_SIZE) {
+            return publishCopy(id, topic, msg.data(), msg.size());
+        }
+
+        auto* holder = new std::vector<uint8_t>(std::move(msg));
+        return publishFrame(id, topic, ZmqFrame(holder->data(), holder->size(),
+            [](void*, void* hint) { delete static_cast<std::vector<uint8_t>*>(hint); }, holder));
+    }
+
+    Result<void> publish(const std::string& topic, std::string_view payload,
+                         std::shared_ptr<const void> owner) override {
+        TopicId id = internTopic(topic);
+        if (hasLocalSubscribers()) {
+            if (!owner) {
+                auto holder = std::make_shared<const std::string>(payload);
+                return publishShared(id, topic, *holder, holder);
+            }
+            return publishShared(id, topic, payload, std::move(owner));
+        }
+        if (!owner || payload.size() < ZERO_COPY_MIN_SIZE) {
+            return publishCopy(id, topic, payload.data(), payload.size());
+        }
 
-        zmq_send(socket, topic.data(), topic.size(), ZMQ_SNDMORE);
-        zmq_send(socket, msg.data(), msg.size(), 0);
+        auto* holder = new std::shared_ptr<const void>(std::move(owner));
+        return publishFrame(id, topic, ZmqFrame(const_cast<char*>(payload.data()), payload.size(),
+            [](void*, void* hint) { delete static_cast<std::shared_ptr<const void>*>(hint); }, holder));
     }
 
     // -------------------------
     // SUBSCRIBE
+    //  모든 구독은 공유 SUB socket + poll loop 에서 처리
     // -------------------------
     std::unique_ptr<MessageSubscription> subscribe(
         const std::string& topic,
         std::function<void(const message::Message&)> callback) override 
     {
-        void* socket = zmq_socket(context_, ZMQ_SUB);
-        zmq_setsockopt(socket, ZMQ_SUBSCRIBE, topic.c_str(), topic.size());
-        zmq_connect(socket, "tcp://127.0.0.1:5555");
+        auto r = ensureSubscriber();
+        if (!r) {
+            LOGE("subscriber start failed: {}", to_string(r));
+            return nullptr;
+        }
+
+        SubscribeDescriptor sd;
+        sd.topic = topic;
+        sd.callback = [cb = std::move(callback)](const message::Message& m) -> Result<void> {
+            cb(m);
+            return OK();
+        };
+
+        return addSubscription(std::move(sd));
+    }
+
+    // payload 를 decode / 복사 없이 받는 구독 (RawMessage 는 callback 이후에도 보관 가능)
+    std::unique_ptr<MessageSubscription> subscribeRaw(
+        const std::string& topic,
+        std::function<void(const RawMessage&)> callback)
+    {
+        auto r = ensureSubscriber();
+        if (!r) {
+            LOGE("subscriber start failed: {}", to_string(r));
+            return nullptr;
+        }
 
-        auto running = std::make_shared<std::atomic<bool>>(true);
+        SubscribeDescriptor sd;
+        sd.topic = topic;
+        sd.raw_callback = [cb = std::move(callback)](const RawMessage& m) -> Result<void> {
+            cb(m);
+            return OK();
+        };
+        return addSubscription(std::move(sd));
+    }
 
-        std::thread([=]() {
-            while (running->load()) {
-                char topic_buf[256];
-                char msg_buf[1024];
+    // 일부 field 만 읽는 구독 - 읽은 field 만 decode (message_view.hpp), view 는 callback 안에서만 사용
+    std::unique_ptr<MessageSubscription> subscribeView(
+        const std::string& topic,
+        std::function<void(const message::MessageView&)> callback)
+    {
+        auto r = ensureSubscriber();
+        if (!r) {
+            LOGE("subscriber start failed: {}", to_string(r));
+            return nullptr;
+        }
 
-                int tsize = zmq_recv(socket, topic_buf, sizeof(topic_buf), 0);
-                if (tsize < 0) continue;
+        SubscribeDescriptor sd;
+        sd.topic = topic;
+        sd.view_callback = [cb = std::move(callback)](const message::MessageView& v) -> Result<void> {
+            cb(v);
+            return OK();
+        };
+        return addSubscription(std::move(sd));
+    }
 
-                int msize = zmq_recv(socket, msg_buf, sizeof(msg_buf), 0);
-                if (msize < 0) continue;
+    // order_key / conflate 등 SubscribeDescriptor 옵션을 그대로 사용
+    std::unique_ptr<MessageSubscription> subscribe(SubscribeDescriptor sd) {
+        auto r = ensureSubscriber();
+        if (!r) {
+            LOGE("subscriber start failed: {}", to_string(r));
+            return nullptr;
+        }
+        return addSubscription(std::move(sd));
+    }
 
-                Message m;
-                m.topic = std::string(topic_buf, tsize);
-                m.payload = std::string(msg_buf, msize);
+    // late joiner - live 구독 후 snapshot_endpoint 에서 topic 별 마지막 값을 받아 먼저 전달
+    // snapshot 이전 live 는 보관했다가 seq 로 중복을 걸러 전달 (snapshot 실패 시 live 만 전달)
+    // snapshot 응답까지 대기 (timeout_ms < 0 이면 request_timeout_ms)
+    std::unique_ptr<MessageSubscription> subscribeSnapshot(
+        const std::string& topic, const std::string& snapshot_endpoint,
+        std::function<void(const RawMessage&)> callback, int timeout_ms = -1)
+    {
+        auto stitcher = std::make_shared<SnapshotStitcher>(std::move(callback));
 
-                callback(m);
-            }
-            zmq_close(socket);
-        }).detach();
+        SubscribeDescriptor sd;
+        sd.topic = topic;
+        sd.raw_callback = [stitcher](const RawMessage& m) -> Result<void> {
+            stitcher->live(m);
+            return OK();
+        };
+        auto sub = subscribe(std::move(sd));
+        if (!sub) return nullptr;
 
-        return std::make_unique<ZmqMessageSubscription>(*running);
+        auto snapshot = request(snapshot_endpoint, topic, timeout_ms);
+        if (!snapshot) {
+            LOGW("snapshot {} from {} failed: {}", topic, snapshot_endpoint,
+                 to_string(Result<void>::Error(snapshot.code(), snapshot.error())));
+        }
+        auto blob = snapshot ? std::make_shared<const std::string>(std::move(snapshot.value())) : nullptr;
+        if (!stitcher->deliverSnapshot(std::move(blob))) {
+            LOGW("malformed snapshot {} from {}", topic, snapshot_endpoint);
+        }
+        auto& st = stitcher->stats();
+        LOGI("snapshot {}: {} value(s), {} buffered, {} duplicate(s)", topic,
+             st.snapshot.load(), st.buffered.load(), st.duplicates.load());
+        return sub;
+    }
+
+    // lossless topic 구독 - seq 순서대로 전달, 빠진 메시지는 control_endpoint 에 NACK 로 요청
+    // ACK 로 publisher 의 credit 을 돌려줌 (reliable_tick_ms 주기 + ack_every 마다)
+    std::unique_ptr<MessageSubscription> subscribeReliable(
+        const std::string& topic, const std::string& control_endpoint,
+        std::function<void(const RawMessage&)> callback, ReliableReceiverDescriptor rd = {})
+    {
+        auto rx = std::make_shared<ReliableReceiver>(std::move(rd), std::move(callback),
+            [this, control_endpoint](std::string req, ReliableReceiver::Reply reply) {
+                return requestAsync(control_endpoint, std::move(req), std::move(reply));
+            }, reliable_stats_);
+
+        SubscribeDescriptor sd;
+        sd.topic = topic;
+        sd.raw_callback = [rx](const RawMessage& m) -> Result<void> {
+            rx->live(m);
+            return OK();
+        };
+        auto sub = subscribe(std::move(sd));
+        if (!sub) return nullptr;
+
+        std::lock_guard<std::mutex> lock(reliable_mutex_);
+        if (!running_.load()) return nullptr;
+        receivers_.push_back(rx);
+        if (!reliable_ticker_) {
+            reliable_ticker_ = std::make_unique<task::PeriodicWorker>("BusReliable", [this] { tickReceivers(); },
+                                                                       desc_.reliable_tick_ms);
+            auto r = reliable_ticker_->start();
+            if (!r) LOGW("reliable ticker start failed: {}", to_string(r));
+        }
+        return sub;
     }
 
     // -------------------------
     // REQUEST
     // -------------------------
+    // 실패 / timeout 이면 empty - 원인이 필요하면 Result 를 반환하는 overload 사용
     std::string request(const std::string& endpoint, const std::string& msg) override {
-        void* socket = zmq_socket(context_, ZMQ_REQ);
-        zmq_connect(socket, endpoint.c_str());
+        auto r = request(endpoint, msg, -1);
+        if (!r) {
+            LOGW("request {} failed: {}", endpoint, to_string(Result<void>::Error(r.code(), r.error())));
+            return {};
+        }
+        return std::move(r.value());
+    }
+
+    // timeout_ms < 0 이면 request_timeout_ms
+    Result<std::string> request(const std::string& endpoint, std::string msg, int timeout_ms) {
+        auto r = ensureRequester();
+        if (!r) return Result<std::string>::Error(r.code(), r.error());
+        return requester_->request(endpoint, std::move(msg), timeout_ms);
+    }
 
-        zmq_send(socket, msg.data(), msg.size(), 0);
+    std::future<Result<std::string>> requestAsync(const std::string& endpoint, std::string msg, int timeout_ms = -1) {
+        auto r = ensureRequester();
+        if (!r) {
+            std::promise<Result<std::string>> failed;
+            failed.set_value(Result<std::string>::Error(r.code(), r.error()));
+            return failed.get_future();
+        }
+        return requester_->requestAsync(endpoint, std::move(msg), timeout_ms);
+    }
 
-        char buf[1024];
-        int size = zmq_recv(socket, buf, sizeof(buf), 0);
+    // callback 은 request I/O thread 에서 호출
+    Result<void> requestAsync(const std::string& endpoint, std::string msg,
+                              ZmqRequestClient::ReplyCallback callback, int timeout_ms = -1) {
+        auto r = ensureRequester();
+        if (!r) return r;
+        return requester_->requestAsync(endpoint, std::move(msg), std::move(callback), timeout_ms);
+    }
 
-        zmq_close(socket);
-        return std::string(buf, size);
+    const ZmqRequestStats* requestStats() const noexcept {
+        return requester_ ? &requester_->stats() : nullptr;
     }
 
     // -------------------------
     // REPLY
     // -------------------------
+    // handler 는 여러 thread 에서 동시에 호출될 수 있음
     void reply(const std::string& endpoint,
         std::function<std::string(const std::string&)> handler) override 
     {
-        void* socket = zmq_socket(context_, ZMQ_REP);
-        zmq_bind(socket, endpoint.c_str());
+        auto r = addReplyServer(endpoint, std::move(handler));
+        if (!r) {
+            LOGE("reply {} failed: {}", endpoint, to_string(r));
+        }
+    }
 
-        std::thread([this, socket, handler]() {
-            char buf[1024];
+    // return: AlreadyExists (같은 endpoint 에 이미 reply 중), SocketError (bind 실패)
+    Result<void> addReplyServer(const std::string& endpoint,
+        std::function<std::string(const std::string&)> handler)
+    {
+        std::lock_guard<std::mutex> lock(reply_mutex_);
+        if (!running_.load()) return Error(ResultCode::InvalidState, "bus is shut down");
+        if (reply_servers_.count(endpoint)) return Error(ResultCode::AlreadyExists, "already replying on " + endpoint);
 
-            while (running_.load()) {
-                int size = zmq_recv(socket, buf, sizeof(buf), 0);
-                if (size < 0) continue;
+        ZmqReplyServerDescriptor rd;
+        rd.name    = "BusReply";
+        rd.context = context_;
+        rd.pool    = desc_.reply_pool;
+        rd.workers = desc_.reply_workers;
 
-                std::string response = handler(std::string(buf, size));
+        auto server = std::make_unique<ZmqReplyServer>(endpoint, std::move(handler), rd);
+        auto r = server->start();
+        if (!r) return r;
+        reply_servers_.emplace(endpoint, std::move(server));
+        return OK();
+    }
 
-                zmq_send(socket, response.data(), response.size(), 0);
-            }
+    // batch_topics 가 비어 있으면 항상 0
+    const BatchStats& batchStats() const noexcept { return batcher_.stats(); }
+    const LastValueCacheStats& cacheStats() const noexcept { return cache_.stats(); }
+    const SendWindowStats& windowStats() const noexcept { return window_.stats(); }
+    const ZmqPubStats& pubStats() const noexcept { return pub_stats_; }
+    const ReliableStats& reliableStats() const noexcept { return reliable_stats_; }
+    // journal 을 쓰지 않으면 nullptr
+    const JournalStats* journalStats() const noexcept { return journal_ ? &journal_->stats() : nullptr; }
+    // metrics 를 쓰지 않으면 nullptr / 빈 vector
+    const BusMetrics* metrics() const noexcept { return metrics_.get(); }
+    std::vector<TopicMetricsSnapshot> metricsSnapshot() const { return metrics_ ? metrics_->snapshot() : std::vector<TopicMetricsSnapshot>{}; }
 
-            zmq_close(socket);
-        }).detach();
+    const ZmqReplyStats* replyStats(const std::string& endpoint) const {
+        std::lock_guard<std::mutex> lock(reply_mutex_);
+        auto it = reply_servers_.find(endpoint);
+        return it != reply_servers_.end() ? &it->second->stats() : nullptr;
     }
 
+protected:
+    static constexpr const char* LOG_TAG = "ZmqMessageBus";
+    static constexpr size_t ZERO_COPY_MIN_SIZE = 64;
+
 private:
     void shutdown() {
         running_.store(false);
+        if (metrics_ticker_) metrics_ticker_->stop();
+        {
+            std::lock_guard<std::mutex> lock(sub_mutex_);
+            if (subscriber_) subscriber_->stop();
+        }
+        {
+            std::lock_guard<std::mutex> lock(reliable_mutex_);
+            if (reliable_ticker_) reliable_ticker_->stop();
+        }
+        {
+            std::lock_guard<std::mutex> lock(req_mutex_);
+            if (requester_) requester_->stop();
+        }
+        {
+            std::lock_guard<std::mutex> lock(reply_mutex_);
+            reply_servers_.clear();
+        }
+        if (flusher_) flusher_->stop();
+        std::lock_guard<std::mutex> lock(pub_mutex_);
+        if (pub_socket_) {
+            batcher_.flushAll(batchSender());
+            zmq_close(pub_socket_);
+            pub_socket_ = nullptr;
+        }
+        shm_writer_.reset();
+        journal_.reset();
+    }
+
+    // metrics ticker thread - 지난 주기 이후 계수가 바뀐 topic 만 publish (metrics_topic 자신은 제외)
+    void publishMetrics() {
+        for (auto& t : metrics_->snapshot()) {
+            if (t.topic == desc_.metrics_topic) continue;
+            uint64_t& last = metrics_published_[t.topic];
+            if (t.activity() == last) continue;
+            last = t.activity();
+            auto r = publish(desc_.metrics_topic, message::serialize(metrics::toMessage(t, desc_.pub_endpoint, desc_.metrics_topic)));
+            if (!r) {
+                LOGW("metrics publish failed: {}", to_string(r));
+                return;
+            }
+        }
+    }
+
+    // reliable ticker thread - 해제된 구독의 receiver 는 정리
+    void tickReceivers() {
+        std::vector<std::shared_ptr<ReliableReceiver>> live;
+        {
+            std::lock_guard<std::mutex> lock(reliable_mutex_);
+            for (auto it = receivers_.begin(); it != receivers_.end();) {
+                if (auto rx = it->lock()) {
+                    live.push_back(std::move(rx));
+                    ++it;
+                } else {
+                    it = receivers_.erase(it);
+                }
+            }
+        }
+        for (auto& rx : live) rx->tick();
     }
 
     void* getOrCreatePubSocket() {
         if (!pub_socket_) {
             pub_socket_ = zmq_socket(context_, ZMQ_PUB);
-            zmq_bind(pub_socket_, "tcp://*:5555");
+            if (pub_socket_) {
+                // XPUB_NODROP 은 쓰지 않음 - socket 전체에 걸려 HWM 에 걸린 구독자 하나가 모든 구독자의 전송을 막음
+                // PUB 은 HWM 에 걸린 구독자 pipe 에서만 버림 (lossless 는 seq gap -> NACK 재전송, credit window 로 보장)
+                zmq_setsockopt(pub_socket_, ZMQ_SNDHWM, &desc_.pub_hwm, sizeof(int));
+                pub_stats_.hwm = desc_.pub_hwm;
+            }
+            if (pub_socket_ && zmq_bind(pub_socket_, desc_.pub_endpoint.c_str()) != 0) {
+                LOGE("bind {} failed: {}", desc_.pub_endpoint, zmq_strerror(zmq_errno()));
+                zmq_close(pub_socket_);
+                pub_socket_ = nullptr;
+            }
+            // 같은 process 구독자용 inproc endpoint (tcp 와 같은 socket)
+            if (pub_socket_ && !local_.alias.empty() && zmq_bind(pub_socket_, local_.alias.c_str()) != 0) {
+                LOGW("bind {} failed: {}", local_.alias, zmq_strerror(zmq_errno()));
+            }
         }
         return pub_socket_;
     }
 
+    // pub_mutex_ 보유 상태에서 호출 - ring 에 복사 (구독 process 는 ring 에서 바로 읽음)
+    Result<void> writeShm(const std::string& topic, std::string_view payload) {
+        if (!shm_writer_) {
+            auto w = ShmRingWriter::create(shm::nameOf(desc_.pub_endpoint), desc_.shm_capacity);
+            if (!w) return Error(w.code(), w.error());
+            shm_writer_ = std::move(w.value());
+        }
+        return shm_writer_->write(topic, payload);
+    }
+
+    // shm ring 은 seq frame 이 없으므로 lossless 미지원
+    static SendWindowDescriptor windowDescriptor(const ZmqMessageBusDescriptor& d) {
+        SendWindowDescriptor wd;
+        if (!shm::isShmEndpoint(d.pub_endpoint)) wd.topics = d.lossless_topics;
+        wd.window          = d.lossless_window;
+        wd.block_ms        = d.lossless_block_ms;
+        wd.peer_timeout_ms = d.lossless_peer_timeout_ms;
+        return wd;
+    }
+
+    static TopicBatcherDescriptor batchDescriptor(const ZmqMessageBusDescriptor& d) {
+        TopicBatcherDescriptor bd;
+        bd.topics       = d.batch_topics;
+        bd.max_bytes    = d.batch_max_bytes;
+        bd.max_messages = d.batch_max_messages;
+        bd.max_delay_ms = d.batch_max_delay_ms;
+        return bd;
+    }
+
+    // pub_mutex_ 보유 상태에서 사용 - [topic][TAG][blob]
+    void sendBatch(const std::string& topic, const std::string& blob) {
+        if (!beginSend(pub_socket_, topic, batch_error_)) return;
+        if (zmq_send(pub_socket_, batch::TAG.data(), batch::TAG.size(), ZMQ_SNDMORE) < 0 ||
+            zmq_send(pub_socket_, blob.data(), blob.size(), 0) < 0) {
+            batch_error_ = Error(ResultCode::SocketError, zmq_strerror(zmq_errno()));
+            return;
+        }
+        sent();
+    }
+
+    // [topic][payload] 다음 frame - [SEQ] (lossless / cache topic), [STAMP] (metrics_stamp)
+    Result<void> sendTrailer(void* socket, uint64_t seq, const metrics::Stamp& mark) {
+        if (seq) {
+            char frame[lvc::SEQ_FRAME_SIZE];
+            lvc::encodeSeq(seq, frame);
+            if (zmq_send(socket, frame, sizeof(frame), mark.seq ? ZMQ_SNDMORE : 0) < 0) {
+                return Error(ResultCode::SocketError, zmq_strerror(zmq_errno()));
+            }
+        }
+        if (mark.seq) {
+            char frame[metrics::STAMP_FRAME_SIZE];
+            metrics::encodeStamp(mark, frame);
+            if (zmq_send(socket, frame, sizeof(frame), 0) < 0) {
+                return Error(ResultCode::SocketError, zmq_strerror(zmq_errno()));
+            }
+        }
+        return sent();
+    }
+
+    std::function<void(const std::string&, const std::string&)> batchSender() {
+        return [this](const std::string& topic, const std::string& blob) { sendBatch(topic, blob); };
+    }
+
+    // pub_mutex_ 보유 상태에서 호출 - true 면 batch 에 들어감 (전송 실패는 result 로)
+    bool addToBatch(TopicId id, const std::string& topic, std::string_view payload, Result<void>& result) {
+        if (!batcher_.enabled()) return false;
+        batch_error_ = OK();
+        bool added = batcher_.add(id, topic, payload, batchSender());
+        result = batch_error_;
+        return added;
+    }
+
+    bool hasLocalSubscribers() const noexcept {
+        return local_.channel && !local_.channel->empty();
+    }
+
+    // 원격 구독자용 ZMQ 전송이 성공하면 Direct 구독자는 같은 thread 에서 바로 호출
+    // payload 는 owner 로 유지 - 구독자가 RawMessage 를 보관해도 유효
+    // topic 은 registry 의 이름을 가리킴 (intern 되지 않은 topic 만 owner 와 함께 복사)
+    Result<void> publishShared(TopicId id, const std::string& topic, std::string_view payload,
+                               std::shared_ptr<const void> owner) {
+        RawMessage local{topicName(id), payload, owner, 0, id};
+        if (id == NO_TOPIC) {
+            struct Held {
+                std::string topic;
+                std::shared_ptr<const void> owner;
+            };
+            auto held = std::make_shared<const Held>(Held{topic, owner});
+            local.topic = held->topic;
+            local.owner = held;
+        }
+
+        Result<void> r = OK();
+        if (payload.size() < ZERO_COPY_MIN_SIZE) {
+            r = publishCopy(id, topic, payload.data(), payload.size(), &local.seq);
+        } else {
+            auto* hint = new std::shared_ptr<const void>(std::move(owner));
+            r = publishFrame(id, topic, ZmqFrame(const_cast<char*>(payload.data()), payload.size(),
+                [](void*, void* h) { delete static_cast<std::shared_ptr<const void>*>(h); }, hint), &local.seq);
+        }
+
+        // 원격 전송 실패 (HWM / credit / batch 오류) 면 local 도 전달하지 않음 - seq 도 할당되지 않은 상태
+        if (!r) return r;
+
+        local_.channel->publish(local);
+        return r;
+    }
+
+    std::unique_ptr<MessageSubscription> addSubscription(SubscribeDescriptor sd) {
+        std::string topic = sd.topic;
+        auto id = subscriber_->add(std::move(sd));
+        if (!id) {
+            LOGE("subscribe '{}' failed: {}", topic, to_string(Result<void>::Error(id.code(), id.error())));
+            return nullptr;
+        }
+        return std::make_unique<ZmqMessageSubscription>(subscriber_, id.value());
+    }
+
+    // seq: lossless / last-value cache topic 이면 이번 publish 의 seq (아니면 0)
+    Result<void> publishCopy(TopicId id, const std::string& topic, const void* data, size_t size, uint64_t* seq = nullptr) {
+        std::string_view payload(static_cast<const char*>(data), size);
+        auto credit = window_.acquire(id);
+        if (!credit) return credit;
+        SendWindow::Reservation reservation(window_, id);
+
+        std::lock_guard<std::mutex> lock(pub_mutex_);
+        const bool to_shm = shm::isShmEndpoint(desc_.pub_endpoint);
+        void* socket = to_shm ? nullptr : getOrCreatePubSocket();
+        if (!to_shm && !socket) return Error(ResultCode::SocketError, "PUB socket unavailable");
+
+        metrics::Stamp mark;
+        uint64_t s = stamp(id, payload, mark);
+        reservation.commit();
+        if (seq) *seq = s;
+        if (to_shm) return writeShm(topic, payload);
+
+        // seq 가 붙는 topic 은 batch 하지 않음
+        if (!s) {
+            Result<void> batched = OK();
+            if (addToBatch(id, topic, payload, batched)) return batched;
+            if (!batched) return batched;
+        }
+
+        Result<void> result = OK();
+        if (!beginSend(socket, topic, result)) return result;
+        bool trailer = s || mark.seq;
+        if (zmq_send(socket, data, size, trailer ? ZMQ_SNDMORE : 0) < 0) {
+            return Error(ResultCode::SocketError, zmq_strerror(zmq_errno()));
+        }
+        return trailer ? sendTrailer(socket, s, mark) : sent();
+    }
+
+    // 전송 실패 시 frame 소멸자에서 free 콜백 호출
+    Result<void> publishFrame(TopicId id, const std::string& topic, ZmqFrame frame, uint64_t* seq = nullptr) {
+        if (!frame.valid()) return Error(ResultCode::OutOfMemory, "zmq_msg_init_data failed");
+        auto credit = window_.acquire(id);
+        if (!credit) return credit;
+        SendWindow::Reservation reservation(window_, id);
+
+        std::lock_guard<std::mutex> lock(pub_mutex_);
+        const bool to_shm = shm::isShmEndpoint(desc_.pub_endpoint);
+        void* socket = to_shm ? nullptr : getOrCreatePubSocket();
+        if (!to_shm && !socket) return Error(ResultCode::SocketError, "PUB socket unavailable");
+
+        metrics::Stamp mark;
+        uint64_t s = stamp(id, frame.view(), mark);
+        reservation.commit();
+        if (seq) *seq = s;
+        if (to_shm) return writeShm(topic, frame.view());
+
+        // batch 에 복사되면 frame 은 여기서 해제
+        if (!s) {
+            Result<void> batched = OK();
+            if (addToBatch(id, topic, frame.view(), batched)) return batched;
+            if (!batched) return batched;
+        }
+
+        Result<void> result = OK();
+        if (!beginSend(socket, topic, result)) return result;
+        bool trailer = s || mark.seq;
+        auto r = frame.send(socket, trailer ? ZMQ_SNDMORE : 0);
+        if (!r) return r;
+        return trailer ? sendTrailer(socket, s, mark) : sent();
+    }
+
+    // pub_mutex_ 보유 상태에서 호출 - lossless window, last-value cache, journal, metrics 에 기록
+    // return: seq (lossless / cache topic 이 아니면 0), mark: metrics_stamp 이면 STAMP frame 내용
+    // (batch / shm 으로 나가는 topic 은 항상 그 경로라 STAMP 없이 일관됨 - 구독 쪽 gap 으로 보이지 않음)
+    uint64_t stamp(TopicId id, std::string_view payload, metrics::Stamp& mark) {
+        if (metrics_) mark = metrics_->onPublish(id, payload.size(), desc_.metrics_stamp);
+        uint64_t seq = window_.append(id, payload);
+        seq = cache_.update(id, payload, seq);
+        if (journal_ && id != NO_TOPIC) journal_->append(id, payload, seq);     // 실패는 journalStats()->errors
+        return seq;
+    }
+
+    // pub_mutex_ 보유 상태에서 호출 - topic frame 전송
+    // (PUB 은 HWM 에 걸린 구독자 pipe 에서만 버리고 대기하지 않음 - 실패는 socket 오류뿐)
+    // return: false 면 보내지 않음 (result = socket 오류)
+    bool beginSend(void* socket, const std::string& topic, Result<void>& result) {
+        if (zmq_send(socket, topic.data(), topic.size(), ZMQ_SNDMORE | ZMQ_DONTWAIT) >= 0) return true;
+        result = Error(ResultCode::SocketError, zmq_strerror(zmq_errno()));
+        return false;
+    }
+
+    Result<void> sent() {
+        pub_stats_.sent++;
+        return OK();
+    }
+
+    Result<void> ensureRequester() {
+        if (requester_ready_.load(std::memory_order_acquire)) return OK();
+
+        std::lock_guard<std::mutex> lock(req_mutex_);
+        if (requester_) return OK();
+        if (!running_.load()) return Error(ResultCode::InvalidState, "bus is shut down");
+
+        ZmqRequestClientDescriptor rd;
+        rd.name        = "BusRequester";
+        rd.context     = context_;
+        rd.connections = desc_.request_connections;
+        rd.timeout_ms  = desc_.request_timeout_ms;
+
+        auto client = std::make_unique<ZmqRequestClient>(rd);
+        if (!client->valid()) return Error(ResultCode::InternalError, "request client unavailable");
+        auto r = client->start();
+        if (!r) return r;
+
+        requester_ = std::move(client);
+        requester_ready_.store(true, std::memory_order_release);
+        return OK();
+    }
+
+    Result<void> ensureSubscriber() {
+        std::lock_guard<std::mutex> lock(sub_mutex_);
+        if (subscriber_) return OK();
+
+        ZmqSubscriberDescriptor sd;
+        sd.name       = "BusSubscriber";
+        sd.poll_loops = desc_.poll_loops;
+        sd.affinity   = desc_.affinity;
+        sd.context    = context_;
+        sd.callback_pool = desc_.callback_pool;
+        sd.rcvhwm     = desc_.sub_hwm;
+        sd.metrics    = metrics_.get();
+
+        auto sub = std::make_shared<ZmqPollSubscriber>(sd);
+        auto r = sub->init();
+        if (!r) return r;
+
+        // 같은 process publisher 는 inproc alias 또는 Direct channel 로 대체
+        auto& shared = ZmqContext::instance();
+        for (auto& ep : desc_.sub_endpoints) {
+            if (context_ != shared.get()) {
+                r = sub->addBus(ep);
+            } else {
+                auto resolved = shared.resolve(ep);
+                if (resolved.channel) {
+                    r = sub->addLocal(std::move(resolved.channel));
+                } else {
+                    if (resolved.endpoint != ep) LOGI("{} -> {} (same process)", ep, resolved.endpoint);
+                    r = sub->addBus(resolved.endpoint);
+                }
+            }
+            if (!r) return r;
+        }
+        r = sub->start();
+        if (!r) return r;
+
+        subscriber_ = std::move(sub);
+        return OK();
+    }
+
 private:
+    ZmqMessageBusDescriptor desc_;
+    std::unique_ptr<BusMetrics> metrics_;       // 구독자 / publish 경로보다 오래 유지 (먼저 선언)
+    std::unique_ptr<task::PeriodicWorker> metrics_ticker_;
+    std::unordered_map<std::string, uint64_t> metrics_published_;   // metrics ticker thread 전용
     void* context_ = nullptr;
     void* pub_socket_ = nullptr;
+    std::mutex pub_mutex_;
+    std::unique_ptr<ShmRingWriter> shm_writer_;
+    TopicBatcher batcher_;                      // pub_mutex_ 로 보호
+    Result<void> batch_error_ = OK();
+    std::unique_ptr<task::PeriodicWorker> flusher_;
+    LastValueCache cache_;
+    SendWindow window_;
+    std::unique_ptr<JournalWriter> journal_;    // pub_mutex_ 안에서 기록
+    ZmqPubStats pub_stats_;
+
+    std::mutex reliable_mutex_;
+    std::vector<std::weak_ptr<ReliableReceiver>> receivers_;
+    std::unique_ptr<task::PeriodicWorker> reliable_ticker_;
+    ReliableStats reliable_stats_;
+    ZmqContext::Binding local_;
+    bool local_bound_ = false;
     std::atomic<bool> running_{true};
+
+    std::mutex sub_mutex_;
+    std::shared_ptr<ZmqPollSubscriber> subscriber_;     // 구독 handle 은 weak_ptr 로 참조
+
+    std::mutex req_mutex_;
+    std::unique_ptr<ZmqRequestClient> requester_;
+    std::atomic<bool> requester_ready_{false};
+
+    mutable std::mutex reply_mutex_;
+    std::unordered_map<std::string, std::unique_ptr<ZmqReplyServer>> reply_servers_;
 };
@@ -0,0 +1,404 @@
+#pragma once
+#include <zmq.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include "result.h"
+#include "logging.hpp"
+#include "worker.hpp"
+#include "thread_pool.hpp"
+#include "zmq_frame.hpp"
+#include "zmq_context.hpp"
+
+// NOTE
+// ZmqReplyServerDescriptor d;
+// d.workers = 8;                               // 전용 handler thread 8 개
+// // d.pool = &pool;                           // 또는 task::ThreadPool 에서 실행
+//
+// ZmqReplyServer server("tcp://*:5600", [](const std::string& req) { return handle(req); }, d);
+// server.start();
+// ...
+// server.stats().active / max_latency_us ...
+//
+// REQ / DEALER(ZmqRequestClient) 모두 지원 - 빈 frame 까지를 envelope 로 보고 응답에 그대로 붙임
+// 응답은 handler 가 끝나는 순서대로 전송 (요청 순서와 무관)
+
+struct ZmqReplyServerDescriptor {
+    std::string name = "ReplyServer";
+    void* context = nullptr;            // nullptr 이면 process 공유 context (ZmqContext)
+    task::ThreadPool* pool = nullptr;   // 지정 시 handler 를 pool 에서 실행
+    size_t workers = 4;                 // 전용 handler thread 수 (pool 사용 시 동시에 실행할 pool task 상한)
+    size_t max_queue = 4096;            // handler 대기 상한 - 넘으면 응답 없이 버림 (client 는 timeout)
+    int core = -1;                      // ROUTER I/O thread affinity
+};
+
+struct ZmqReplyStats {
+    std::atomic<size_t> received{0};
+    std::atomic<size_t> replied{0};
+    std::atomic<size_t> rejected{0};        // 대기 상한 초과
+    std::atomic<size_t> malformed{0};       // envelope 가 없는 요청
+    std::atomic<size_t> failed{0};          // handler 예외 / 응답 전송 실패
+    std::atomic<size_t> queued{0};          // handler 대기 중
+    std::atomic<size_t> active{0};          // handler 실행 중 (동시 처리 수)
+    std::atomic<size_t> max_active{0};
+    std::atomic<uint64_t> total_latency_us{0};  // 수신 ~ 응답 전송 (평균 = total / replied)
+    std::atomic<uint64_t> max_latency_us{0};
+};
+
+
+// ------------------------------------------------------
+// ZmqReplyServer - ROUTER frontend + handler worker 들
+//  - I/O thread 가 ROUTER 에서 요청을 받아 handler queue 로 넘기고 완료된 응답을 전송
+//  - handler 는 전용 thread 또는 task::ThreadPool 에서 병렬 실행 (느린 요청이 다른 client 를 막지 않음)
+//  - zmq socket 은 I/O thread 에서만 사용, 완료 응답은 queue + eventfd 로 전달
+// ------------------------------------------------------
+class ZmqReplyServer : public task::Worker {
+public:
+    using Handler = std::function<std::string(const std::string&)>;
+
+    ZmqReplyServer(std::string endpoint, Handler handler, ZmqReplyServerDescriptor desc = {})
+        : endpoint_(std::move(endpoint)), handler_(std::move(handler)), desc_(std::move(desc)) {
+        wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        context_ = desc_.context ? desc_.context : ZmqContext::instance().get();
+
+        task::WorkerDescriptor wd;
+        wd.name = desc_.name;
+        wd.type = task::WorkerType::Single;
+        if (desc_.core >= 0) wd.affinity = {desc_.core};
+
+        auto r = Worker::init(wd);
+        if (!r) {
+            LOGE("reply server init failed: {}", to_string(r));
+        }
+    }
+
+    ~ZmqReplyServer() override {
+        stop();
+        stopHandlers();
+        if (wake_fd_ >= 0) ::close(wake_fd_);
+    }
+
+    bool valid() const noexcept { return wake_fd_ >= 0 && context_ != nullptr && handler_; }
+
+    const std::string& endpoint() const noexcept { return endpoint_; }
+    const ZmqReplyStats& stats() const noexcept { return stats_; }
+
+protected:
+    static constexpr const char* LOG_TAG = "ZmqReplyServer";
+
+    // ROUTER bind 실패는 start() 결과로 전달
+    Result<void> onPreStart() override {
+        if (!valid()) return Error(ResultCode::InvalidState, "reply server not available");
+
+        socket_ = zmq_socket(context_, ZMQ_ROUTER);
+        if (!socket_) return Error(ResultCode::SocketError, zmq_strerror(zmq_errno()));
+
+        int linger = 0, hwm = 0;
+        zmq_setsockopt(socket_, ZMQ_LINGER, &linger, sizeof(linger));
+        zmq_setsockopt(socket_, ZMQ_SNDHWM, &hwm, sizeof(hwm));
+        zmq_setsockopt(socket_, ZMQ_RCVHWM, &hwm, sizeof(hwm));
+        if (zmq_bind(socket_, endpoint_.c_str()) != 0) {
+            auto err = Error(ResultCode::SocketError, "bind " + endpoint_ + " failed: " + zmq_strerror(zmq_errno()));
+            zmq_close(socket_);
+            socket_ = nullptr;
+            return err;
+        }
+
+        stopping_ = false;
+        drainers_ = 0;
+        busy_ = 0;
+        gate_ = std::make_shared<Gate>();
+        if (!desc_.pool) {
+            size_t count = desc_.workers ? desc_.workers : 1;
+            for (size_t i = 0; i < count; ++i) threads_.emplace_back([this] { handlerLoop(); });
+        }
+        return OK();
+    }
+
+    Result<void> run() override {
+        zmq_pollitem_t items[2] = {
+            {nullptr, wake_fd_, ZMQ_POLLIN, 0},
+            {socket_, 0, ZMQ_POLLIN, 0},
+        };
+
+        while (!isStopRequested()) {
+            // pool 제출이 실패해 남은 요청이 있으면 잠시 후 다시 시도
+            int rc = zmq_poll(items, 2, spawnDrainers() ? -1 : RETRY_MS);
+            if (rc < 0) {
+                if (zmq_errno() == ETERM) break;
+                continue;
+            }
+
+            if (items[0].revents & ZMQ_POLLIN) {
+                uint64_t v;
+                while (::read(wake_fd_, &v, sizeof(v)) > 0) { }
+            }
+            sendReplies();
+
+            if (items[1].revents & ZMQ_POLLIN) {
+                for (size_t n = 0; n < RECV_BATCH; ++n) {
+                    if (!receive()) break;
+                }
+            }
+        }
+
+        zmq_close(socket_);
+        socket_ = nullptr;
+        return OK();
+    }
+
+    void onPreStop() override {
+        wake();
+    }
+
+    void onPostStop() override {
+        stopHandlers();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t RECV_BATCH = 64;
+    static constexpr long RETRY_MS = 10;
+
+    // pool task 가 server 보다 늦게 실행될 수 있으므로 정지 시 닫고 실행 중인 task 만 기다림
+    struct Gate {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool open = true;
+        size_t running = 0;
+
+        bool enter() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!open) return false;
+            ++running;
+            return true;
+        }
+        void leave() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--running == 0) cv.notify_all();
+        }
+        void close() {
+            std::unique_lock<std::mutex> lock(mutex);
+            open = false;
+            cv.wait(lock, [this] { return running == 0; });
+        }
+    };
+
+    // envelope = 빈 delimiter frame 까지 (ROUTER identity + DEALER correlation id 등)
+    struct Job {
+        std::vector<std::string> envelope;
+        std::string body;                   // 요청 payload -> handler 이후 응답
+        Clock::time_point received;
+    };
+
+    void wake() {
+        uint64_t one = 1;
+        [[maybe_unused]] auto n = ::write(wake_fd_, &one, sizeof(one));
+    }
+
+    bool receive() {
+        ZmqMultipart parts;
+        auto r = parts.recv(socket_, ZMQ_DONTWAIT);
+        if (!r) return false;
+        stats_.received++;
+
+        size_t delimiter = 1;                       // [0] = ROUTER identity
+        while (delimiter < parts.size() && parts[delimiter].size() != 0) ++delimiter;
+        if (delimiter + 1 >= parts.size()) {
+            stats_.malformed++;
+            return true;
+        }
+
+        if (stats_.queued.load(std::memory_order_relaxed) >= desc_.max_queue) {
+            stats_.rejected++;
+            return true;
+        }
+        stats_.queued++;
+
+        Job job;
+        job.received = Clock::now();
+        job.envelope.reserve(delimiter + 1);
+        for (size_t i = 0; i <= delimiter; ++i) job.envelope.emplace_back(parts[i].view());
+        job.body.assign(parts[delimiter + 1].view());
+
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        if (desc_.pool) spawnDrainers();
+        else jobs_cv_.notify_one();
+        return true;
+    }
+
+    // pool 사용 시 - 대기 요청이 있고 실행 중인 drain task 가 workers 보다 적으면 추가 제출
+    // return: 처리되지 않고 남을 요청이 없는지 (pool 제출 실패 시 false)
+    bool spawnDrainers() {
+        if (!desc_.pool) return true;
+        size_t limit = desc_.workers ? desc_.workers : 1;
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                // handler 실행 중이 아닌 drain task 가 대기 요청 수보다 적을 때만 추가
+                if (jobs_.empty() || drainers_ >= limit || drainers_ - busy_ >= jobs_.size()) return true;
+                ++drainers_;
+            }
+
+            task::TaskDescriptor<void> td;
+            td.name     = desc_.name;
+            td.dispatch = task::TaskDispatchPolicy::Immediate;
+            td.throttle_time_ms = 0;
+            td.func     = [this, gate = gate_]() -> Result<void> {
+                if (!gate->enter()) return OK();        // 정지된 server
+                drain();
+                gate->leave();
+                return OK();
+            };
+            if (!desc_.pool->submit(td)) {
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                --drainers_;
+                return drainers_ > 0;                   // 실행 중인 drain 이 있으면 그쪽에서 처리
+            }
+        }
+    }
+
+    // pool thread - queue 가 빌 때까지 처리
+    void drain() {
+        std::unique_lock<std::mutex> lock(jobs_mutex_);
+        while (!stopping_ && !jobs_.empty()) {
+            Job job = std::move(jobs_.front());
+            jobs_.pop_front();
+            ++busy_;
+            lock.unlock();
+
+            handle(std::move(job));
+
+            lock.lock();
+            --busy_;
+        }
+        --drainers_;
+    }
+
+    // handler thread / pool thread
+    void handle(Job job) {
+        stats_.queued--;
+        size_t active = ++stats_.active;
+        size_t peak = stats_.max_active.load(std::memory_order_relaxed);
+        while (active > peak && !stats_.max_active.compare_exchange_weak(peak, active, std::memory_order_relaxed)) { }
+
+        bool ok = true;
+        try {
+            job.body = handler_(job.body);
+        } catch (const std::exception& e) {
+            ok = false;
+            LOGE("{} handler exception: {}", endpoint_, e.what());
+        } catch (...) {
+            ok = false;
+            LOGE("{} handler unknown exception", endpoint_);
+        }
+        stats_.active--;
+
+        if (!ok) {
+            stats_.failed++;
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(replies_mutex_);
+            replies_.push_back(std::move(job));
+        }
+        wake();
+    }
+
+    void handlerLoop() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(jobs_mutex_);
+                jobs_cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+                if (stopping_) return;
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            handle(std::move(job));
+        }
+    }
+
+    void stopHandlers() {
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            stopping_ = true;
+            stats_.queued -= jobs_.size();
+            jobs_.clear();
+        }
+        jobs_cv_.notify_all();
+        for (auto& t : threads_) {
+            if (t.joinable()) t.join();
+        }
+        threads_.clear();
+
+        if (gate_) {
+            gate_->close();
+            gate_.reset();
+        }
+    }
+
+    // I/O thread 전용
+    void sendReplies() {
+        std::deque<Job> replies;
+        {
+            std::lock_guard<std::mutex> lock(replies_mutex_);
+            replies.swap(replies_);
+        }
+
+        for (auto& job : replies) {
+            bool ok = true;
+            for (auto& frame : job.envelope) {
+                ok = ok && zmq_send(socket_, frame.data(), frame.size(), ZMQ_SNDMORE) >= 0;
+            }
+            ok = ok && zmq_send(socket_, job.body.data(), job.body.size(), 0) >= 0;
+            if (!ok) {
+                // 연결이 끊긴 client (ROUTER 는 보통 조용히 버림)
+                stats_.failed++;
+                continue;
+            }
+            stats_.replied++;
+
+            auto us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                Clock::now() - job.received).count());
+            stats_.total_latency_us += us;
+            uint64_t max = stats_.max_latency_us.load(std::memory_order_relaxed);
+            while (us > max && !stats_.max_latency_us.compare_exchange_weak(max, us, std::memory_order_relaxed)) { }
+        }
+    }
+
+    std::string endpoint_;
+    Handler handler_;
+    ZmqReplyServerDescriptor desc_;
+    void* context_ = nullptr;
+    void* socket_ = nullptr;
+    int wake_fd_ = -1;
+
+    std::mutex jobs_mutex_;
+    std::condition_variable jobs_cv_;
+    std::deque<Job> jobs_;
+    bool stopping_ = false;
+    size_t drainers_ = 0;                   // pool 에 제출된 drain task 수
+    size_t busy_ = 0;                       // 그 중 handler 실행 중인 수
+    std::vector<std::thread> threads_;
+    std::shared_ptr<Gate> gate_;
+
+    std::mutex replies_mutex_;
+    std::deque<Job> replies_;
+
+    ZmqReplyStats stats_;
+};
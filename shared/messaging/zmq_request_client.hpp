@@ -0,0 +1,394 @@
+#pragma once
+#include <zmq.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include "result.h"
+#include "logging.hpp"
+#include "worker.hpp"
+#include "fiber.hpp"
+#include "zmq_frame.hpp"
+#include "zmq_context.hpp"
+
+// NOTE
+// ZmqRequestClient client;                     // process 공유 zmq context 사용
+// client.start();
+//
+// auto r = client.request("tcp://127.0.0.1:5600", "ping");              // 동기 (기본 deadline)
+// auto f = client.requestAsync("tcp://127.0.0.1:5600", "ping", 500);    // std::future<Result<std::string>>
+// client.requestAsync("tcp://127.0.0.1:5600", "ping", [](Result<std::string> r) { ... });
+//
+// FiberTask 안에서 request() 는 fiber 만 park - 응답 대기 중 carrier 는 다른 fiber 를 수행
+//
+// wire : [correlation id (8 byte)][empty][payload]
+//   REP server 는 앞의 id frame 을 envelope 로 보고 그대로 돌려줌 - 기존 reply() 와 호환
+//   ROUTER server 는 [identity][id][empty][payload] 로 받아 같은 envelope 로 응답
+
+struct ZmqRequestClientDescriptor {
+    std::string name = "RequestClient";
+    void* context = nullptr;            // nullptr 이면 process 공유 context (ZmqContext)
+    size_t connections = 1;             // endpoint 당 DEALER socket 수 (요청 round-robin)
+    int timeout_ms = 3000;              // 요청 기본 deadline (0 이하 = 무제한)
+    size_t max_inflight = 4096;         // 응답 대기 상한 (넘으면 ResourceBusy)
+    int core = -1;                      // I/O thread affinity
+};
+
+struct ZmqRequestStats {
+    std::atomic<size_t> sent{0};
+    std::atomic<size_t> replied{0};
+    std::atomic<size_t> timeouts{0};
+    std::atomic<size_t> failed{0};          // 전송 실패 / 형식이 맞지 않는 응답
+    std::atomic<size_t> late{0};            // deadline 이후 도착한 응답 (버림)
+    std::atomic<size_t> inflight{0};
+    std::atomic<size_t> connections{0};     // 열려 있는 DEALER socket 수
+};
+
+
+// ------------------------------------------------------
+// ZmqRequestClient - endpoint 별로 유지하는 DEALER socket 위의 비동기 request / reply
+//  - 응답을 기다리지 않고 여러 요청을 보냄 (correlation id 로 응답 매칭, 순서 무관)
+//  - socket 은 endpoint 첫 요청 때 만들고 계속 재사용 (connect / handshake 1 회)
+//  - zmq socket 은 I/O thread 에서만 사용, 요청은 queue + eventfd 로 전달
+//  - callback 은 I/O thread 에서 호출되므로 오래 걸리는 작업은 넘겨서 처리
+// ------------------------------------------------------
+class ZmqRequestClient : public task::Worker {
+public:
+    using ReplyCallback = std::function<void(Result<std::string>)>;
+
+    explicit ZmqRequestClient(ZmqRequestClientDescriptor desc = {}) : desc_(std::move(desc)) {
+        wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        context_ = desc_.context ? desc_.context : ZmqContext::instance().get();
+
+        task::WorkerDescriptor wd;
+        wd.name = desc_.name;
+        wd.type = task::WorkerType::Single;
+        if (desc_.core >= 0) wd.affinity = {desc_.core};
+
+        auto r = Worker::init(wd);
+        if (!r) {
+            LOGE("request client init failed: {}", to_string(r));
+        }
+    }
+
+    ~ZmqRequestClient() override {
+        stop();
+        shutdown();                 // start 되지 않은 경우 대기 중인 요청 정리
+        if (wake_fd_ >= 0) ::close(wake_fd_);
+    }
+
+    bool valid() const noexcept { return wake_fd_ >= 0 && context_ != nullptr; }
+
+    // timeout_ms < 0 이면 descriptor 기본값, 0 = 무제한
+    // return: ResourceBusy (응답 대기 상한), Cancelled (정지됨) - 이 경우 callback 은 호출되지 않음
+    Result<void> requestAsync(const std::string& endpoint, std::string payload,
+                              ReplyCallback callback, int timeout_ms = -1) {
+        if (!valid()) return Error(ResultCode::InvalidState, "request client not available");
+        if (!callback) return Error(ResultCode::InvalidArgument, "callback is empty");
+
+        if (stats_.inflight.fetch_add(1, std::memory_order_relaxed) >= desc_.max_inflight) {
+            stats_.inflight.fetch_sub(1, std::memory_order_relaxed);
+            return Error(ResultCode::ResourceBusy, "too many requests in flight");
+        }
+
+        Send op;
+        op.endpoint = endpoint;
+        op.payload  = std::move(payload);
+        op.callback = std::move(callback);
+        int t = timeout_ms < 0 ? desc_.timeout_ms : timeout_ms;
+        op.deadline = t > 0 ? Clock::now() + std::chrono::milliseconds(t) : Clock::time_point::max();
+        {
+            std::lock_guard<std::mutex> lock(sends_mutex_);
+            if (closed_) {
+                stats_.inflight.fetch_sub(1, std::memory_order_relaxed);
+                return Error(ResultCode::Cancelled, "request client stopped");
+            }
+            sends_.push_back(std::move(op));
+        }
+        wake();
+        return OK();
+    }
+
+    std::future<Result<std::string>> requestAsync(const std::string& endpoint, std::string payload,
+                                                  int timeout_ms = -1) {
+        auto promise = std::make_shared<std::promise<Result<std::string>>>();
+        auto future  = promise->get_future();
+        auto r = requestAsync(endpoint, std::move(payload),
+            [promise](Result<std::string> reply) { promise->set_value(std::move(reply)); }, timeout_ms);
+        if (!r) promise->set_value(Result<std::string>::Error(r.code(), r.error()));
+        return future;
+    }
+
+    // fiber 안에서 호출하면 응답까지 fiber 를 park (carrier 를 점유하지 않음), 스레드에서는 futex 대기
+    // callback 안(I/O thread)에서 호출 금지 - InvalidState
+    Result<std::string> request(const std::string& endpoint, std::string payload, int timeout_ms = -1) {
+        if (std::this_thread::get_id() == io_thread_.load(std::memory_order_acquire)) {
+            return Result<std::string>::Error(ResultCode::InvalidState, "synchronous request from I/O thread");
+        }
+
+        Result<std::string> reply;
+        task::WaitNode node;
+        auto r = requestAsync(endpoint, std::move(payload), [&reply, &node](Result<std::string> res) {
+            reply = std::move(res);
+            node.notify();
+        }, timeout_ms);
+        if (!r) return Result<std::string>::Error(r.code(), r.error());
+
+        // 응답 / deadline / 정지 중 하나로 callback 이 반드시 호출됨
+        node.park();
+        return reply;
+    }
+
+    const ZmqRequestStats& stats() const noexcept { return stats_; }
+
+protected:
+    static constexpr const char* LOG_TAG = "ZmqRequestClient";
+
+    Result<void> run() override {
+        io_thread_.store(std::this_thread::get_id(), std::memory_order_release);
+        items_.clear();
+        items_.push_back({nullptr, wake_fd_, ZMQ_POLLIN, 0});
+
+        while (!isStopRequested()) {
+            applySends();
+            long timeout = expire();
+
+            int rc = zmq_poll(items_.data(), static_cast<int>(items_.size()), timeout);
+            if (rc < 0) {
+                if (zmq_errno() == ETERM) break;
+                continue;
+            }
+
+            if (items_[0].revents & ZMQ_POLLIN) {
+                uint64_t v;
+                while (::read(wake_fd_, &v, sizeof(v)) > 0) { }
+            }
+
+            for (size_t i = 1; i < items_.size(); ++i) {
+                if (!(items_[i].revents & ZMQ_POLLIN)) continue;
+                for (size_t n = 0; n < RECV_BATCH; ++n) {
+                    if (!receive(items_[i].socket)) break;
+                }
+            }
+        }
+
+        shutdown();
+        return OK();
+    }
+
+    void onPreStop() override {
+        wake();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t RECV_BATCH = 64;
+
+    struct Send {
+        std::string endpoint;
+        std::string payload;
+        ReplyCallback callback;
+        Clock::time_point deadline;
+    };
+
+    struct Pending {
+        ReplyCallback callback;
+        Clock::time_point deadline;
+    };
+
+    struct Connection {
+        std::vector<void*> sockets;
+        size_t next = 0;
+    };
+
+    void wake() {
+        uint64_t one = 1;
+        [[maybe_unused]] auto n = ::write(wake_fd_, &one, sizeof(one));
+    }
+
+    // I/O thread 전용 - callback 호출 + 대기 수 정리
+    void complete(ReplyCallback& callback, Result<std::string> r) {
+        stats_.inflight.fetch_sub(1, std::memory_order_relaxed);
+        try {
+            callback(std::move(r));
+        } catch (const std::exception& e) {
+            LOGE("reply callback exception: {}", e.what());
+        }
+    }
+
+    void applySends() {
+        std::vector<Send> sends;
+        {
+            std::lock_guard<std::mutex> lock(sends_mutex_);
+            sends.swap(sends_);
+        }
+
+        for (auto& op : sends) {
+            void* socket = socketFor(op.endpoint);
+            if (!socket) {
+                stats_.failed++;
+                complete(op.callback, Result<std::string>::Error(ResultCode::ConnectionFail, "connect failed: " + op.endpoint));
+                continue;
+            }
+
+            uint64_t id = next_id_++;
+            if (zmq_send(socket, &id, sizeof(id), ZMQ_SNDMORE | ZMQ_DONTWAIT) < 0 ||
+                zmq_send(socket, nullptr, 0, ZMQ_SNDMORE) < 0 ||
+                zmq_send(socket, op.payload.data(), op.payload.size(), 0) < 0) {
+                auto err = ZmqFrame::errorOf(zmq_errno());
+                stats_.failed++;
+                complete(op.callback, Result<std::string>::Error(err.code(), err.error()));
+                continue;
+            }
+            stats_.sent++;
+
+            if (op.deadline != Clock::time_point::max()) deadlines_.push({op.deadline, id});
+            pending_.emplace(id, Pending{std::move(op.callback), op.deadline});
+        }
+    }
+
+    // 만료된 요청 정리, return: 다음 deadline 까지 남은 ms (없으면 -1)
+    long expire() {
+        auto now = Clock::now();
+        while (!deadlines_.empty()) {
+            auto [deadline, id] = deadlines_.top();
+            auto it = pending_.find(id);
+            if (it == pending_.end()) {          // 이미 응답 받음
+                deadlines_.pop();
+                continue;
+            }
+            if (deadline > now) {
+                auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count();
+                return static_cast<long>(ms) + 1;
+            }
+            deadlines_.pop();
+            auto callback = std::move(it->second.callback);
+            pending_.erase(it);
+            stats_.timeouts++;
+            complete(callback, Result<std::string>::Error(ResultCode::Timeout, "request timed out"));
+        }
+        return -1;
+    }
+
+    // [id][empty][payload]
+    bool receive(void* socket) {
+        ZmqMultipart parts;
+        auto r = parts.recv(socket, ZMQ_DONTWAIT);
+        if (!r) return false;
+
+        uint64_t id = 0;
+        if (parts.size() != 3 || parts[0].size() != sizeof(id) || parts[1].size() != 0) {
+            stats_.failed++;
+            LOGW("malformed reply ({} frames)", parts.size());
+            return true;
+        }
+        std::memcpy(&id, parts[0].data(), sizeof(id));
+
+        auto it = pending_.find(id);
+        if (it == pending_.end()) {
+            stats_.late++;
+            return true;
+        }
+        auto callback = std::move(it->second.callback);
+        pending_.erase(it);
+        stats_.replied++;
+        complete(callback, Result<std::string>::OK(std::string(parts[2].view())));
+        return true;
+    }
+
+    void* socketFor(const std::string& endpoint) {
+        auto it = connections_.find(endpoint);
+        if (it == connections_.end()) {
+            Connection conn;
+            size_t count = desc_.connections ? desc_.connections : 1;
+            for (size_t i = 0; i < count; ++i) {
+                void* socket = openSocket(endpoint);
+                if (!socket) break;
+                conn.sockets.push_back(socket);
+            }
+            if (conn.sockets.empty()) return nullptr;
+            it = connections_.emplace(endpoint, std::move(conn)).first;
+        }
+        auto& conn = it->second;
+        return conn.sockets[conn.next++ % conn.sockets.size()];
+    }
+
+    void* openSocket(const std::string& endpoint) {
+        void* socket = zmq_socket(context_, ZMQ_DEALER);
+        if (!socket) {
+            LOGE("create DEALER socket failed: {}", zmq_strerror(zmq_errno()));
+            return nullptr;
+        }
+        int linger = 0;
+        zmq_setsockopt(socket, ZMQ_LINGER, &linger, sizeof(linger));
+        // 대기 수는 max_inflight 로 제한 - socket HWM 에서 요청이 거절되지 않도록 해제
+        int hwm = 0;
+        zmq_setsockopt(socket, ZMQ_SNDHWM, &hwm, sizeof(hwm));
+        zmq_setsockopt(socket, ZMQ_RCVHWM, &hwm, sizeof(hwm));
+
+        if (zmq_connect(socket, endpoint.c_str()) != 0) {
+            LOGE("connect {} failed: {}", endpoint, zmq_strerror(zmq_errno()));
+            zmq_close(socket);
+            return nullptr;
+        }
+        items_.push_back({socket, 0, ZMQ_POLLIN, 0});
+        stats_.connections++;
+        return socket;
+    }
+
+    // 정지 - 대기 중인 요청은 모두 Cancelled
+    void shutdown() {
+        std::vector<Send> sends;
+        {
+            std::lock_guard<std::mutex> lock(sends_mutex_);
+            closed_ = true;
+            sends.swap(sends_);
+        }
+        for (auto& op : sends) {
+            complete(op.callback, Result<std::string>::Error(ResultCode::Cancelled, "request client stopped"));
+        }
+        for (auto& [id, p] : pending_) {
+            complete(p.callback, Result<std::string>::Error(ResultCode::Cancelled, "request client stopped"));
+        }
+        pending_.clear();
+        deadlines_ = {};
+
+        for (size_t i = 1; i < items_.size(); ++i) zmq_close(items_[i].socket);
+        items_.clear();
+        connections_.clear();
+        stats_.connections = 0;
+        io_thread_.store(std::thread::id(), std::memory_order_release);
+    }
+
+    ZmqRequestClientDescriptor desc_;
+    void* context_ = nullptr;
+    int wake_fd_ = -1;
+    std::atomic<std::thread::id> io_thread_{};
+
+    std::mutex sends_mutex_;
+    std::vector<Send> sends_;
+    bool closed_ = false;
+
+    // I/O thread 전용
+    std::vector<zmq_pollitem_t> items_;         // [0] = wake fd
+    std::unordered_map<std::string, Connection> connections_;
+    std::unordered_map<uint64_t, Pending> pending_;
+    std::priority_queue<std::pair<Clock::time_point, uint64_t>,
+                        std::vector<std::pair<Clock::time_point, uint64_t>>,
+                        std::greater<>> deadlines_;
+    uint64_t next_id_ = 1;
+
+    ZmqRequestStats stats_;
+};
@@ -2,178 +2,897 @@
 #pragma once
 
 #include <zmq.h>
-#include <thread>
+#include <algorithm>
 #include <atomic>
-#include <unordered_map>
+#include <cerrno>
+#include <chrono>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <stdexcept>
-#include <iostream>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <unistd.h>
+#include <sys/eventfd.h>
 
 #include "result.h"
+#include "logging.hpp"
 #include "message.hpp"
 #include "worker.hpp"
+#include "serial_executor.hpp"
 #include "message_helper.hpp"
 #include "subscriber.hpp"
+#include "zmq_frame.hpp"
+#include "zmq_context.hpp"
+#include "shm_ring.hpp"
+#include "topic_router.hpp"
+#include "topic_registry.hpp"
+#include "topic_batcher.hpp"
+#include "last_value_cache.hpp"
+#include "bus_metrics.hpp"
+
+// NOTE
+// ZmqSubscriberDescriptor sd;
+// sd.poll_loops = 2;                           // topic 을 2개의 poll loop 에 분산
+// sd.affinity   = {2, 3};
+//
+// ZmqPollSubscriber sub(sd);
+// sub.init();
+// sub.addBus("tcp://127.0.0.1:5555");
+// sub.addBus("shm://sample");                  // 같은 host 의 다른 process (shared memory ring)
+// auto id = sub.add({"event.sample.completed", [](const message::Message& m) { ...; return OK(); }});
+// sub.add({"event.*.completed", ...});        // '*' = segment 하나, '#' = 나머지 전부 (topic_router.hpp)
+//
+// // payload 를 복사 / 변환 없이 받을 때
+// SubscribeDescriptor raw;
+// raw.topic        = "sensor.frame";
+// raw.raw_callback = [](const RawMessage& m) { process(m.payload); return OK(); };
+// sub.add(std::move(raw));
+//
+// // 일부 field 만 읽을 때 - 처음 읽을 때 index, 읽은 field 만 decode (구독들이 view 하나를 공유)
+// SubscribeDescriptor view;
+// view.topic         = "state.#";
+// view.view_callback = [](const message::MessageView& v) { use(v.getOr<int>("op", 0)); return OK(); };
+// sub.add(std::move(view));
+//
+// // callback 을 thread pool 에서 실행 (느린 구독자가 수신 thread 를 막지 않음)
+// task::ThreadPool pool({4});
+// pool.start();
+// sd.callback_pool = &pool;                    // 같은 topic(또는 order_key) 은 순서대로, 다른 topic 은 병렬
+// SubscribeDescriptor ordered;
+// ordered.topic     = "order.#";
+// ordered.order_key = [](const RawMessage& m) { return accountOf(m.payload); };
+// ordered.max_pending = 256;                   // 넘으면 drop - subscriptionStats(id)->dropped
+// SubscribeDescriptor state;
+// state.topic    = "state.#";
+// state.conflate = true;                       // 밀리면 topic 별 최신 값만 전달 - subscriptionStats(id)->conflated
+// sub.start();
+// ...
+// sub.remove(id.value());
+
+using SubscriptionId = uint64_t;
+
+struct ZmqSubscriberDescriptor {
+    std::string name = "Subscriber";
+    size_t poll_loops = 1;              // poll loop(worker) 수, topic hash 로 분산
+    std::vector<int> affinity;          // loop i 는 affinity[i % size] 에 고정
+    void* context = nullptr;            // nullptr 이면 process 공유 context (ZmqContext)
+    size_t recv_batch = 64;             // socket 당 한 번에 처리할 최대 메시지 수
+    int rcvhwm = 1000;                  // SUB socket 수신 high-water mark (넘으면 libzmq 가 버림, 0 = 무제한)
+
+    // 지정 시 callback 을 pool 에서 실행 - key 별 serial executor 로 순서 유지 (pool 은 subscriber 보다 오래 유지)
+    task::ThreadPool* callback_pool = nullptr;
+    size_t callback_shards = 16;        // serial executor shard 수 (동시에 실행 가능한 key 그룹 수)
+    size_t max_pending = 1024;          // 구독당 실행 대기 상한 기본값 (SubscribeDescriptor::max_pending)
+    uint32_t slow_threshold_ms = 100;   // slow consumer 판정 기본값 (SubscribeDescriptor::slow_threshold_ms)
+
+    // 지정 시 topic 별 수신 / decode / callback / drop 과 STAMP frame 의 latency / gap 기록 (subscriber 보다 오래 유지)
+    BusMetrics* metrics = nullptr;
+};
 
+struct ZmqSubscriberStats {
+    std::atomic<size_t> received{0};
+    std::atomic<size_t> dispatched{0};      // callback 호출 수
+    std::atomic<size_t> unmatched{0};       // 등록된 callback 이 없는 topic
+    std::atomic<size_t> failed{0};          // decode 실패 / callback 실패
+    std::atomic<size_t> control_ops{0};     // poll thread 에서 적용한 connect / filter 변경
+    std::atomic<size_t> local_received{0};  // Direct publisher 로부터 받은 메시지 (ZMQ 미사용)
+    std::atomic<size_t> queued{0};          // callback pool 에 넘긴 수
+    std::atomic<size_t> dropped{0};         // 실행 대기 상한 초과로 버린 수
+    std::atomic<size_t> slow{0};            // slow_threshold_ms 를 넘긴 callback 수
+    std::atomic<size_t> batches{0};         // 수신한 batch frame (topic_batcher.hpp)
+    std::atomic<size_t> unbatched{0};       // batch 에서 풀어낸 메시지 (received 에도 포함)
+    std::atomic<size_t> conflated{0};       // 대기 중인 메시지를 최신 값으로 교체한 수
+};
+
+// 구독(callback) 단위 - ZmqPollSubscriber::subscriptionStats(id)
+struct SubscriptionStats {
+    std::atomic<size_t> dispatched{0};
+    std::atomic<size_t> failed{0};
+    std::atomic<size_t> pending{0};         // pool 에서 실행 대기 중
+    std::atomic<size_t> max_pending{0};     // pending 최대값
+    std::atomic<size_t> dropped{0};
+    std::atomic<size_t> conflated{0};       // conflate 구독에서 전달되지 않고 교체된 메시지
+    std::atomic<size_t> slow{0};            // 수신 ~ callback 완료가 slow_threshold_ms 초과
+    std::atomic<uint64_t> max_latency_us{0};
+};
 
-class ZmqPollSubscriber : virtual public ISubscriber {
 
+// ------------------------------------------------------
+// ZmqPollSubscriber
+//  - 모든 구독은 N 개의 poll loop 가 처리 (구독마다 thread / socket 을 만들지 않음)
+//  - poll loop 는 bus endpoint 당 SUB socket 하나를 가지고 ZMQ_SUBSCRIBE filter 로 공유
+//  - 구독 pattern 은 hash 로 하나의 loop 에 배정, loop 는 자기 pattern 만 TopicRouter 로 매칭
+//  - ZMQ filter 는 pattern 의 literal prefix, loop 내 pattern 수로 참조 계수
+//  - zmq socket 은 thread-safe 하지 않으므로 connect / setsockopt 는 요청 큐에 넣고
+//    eventfd 로 poll 을 깨워 poll thread 에서 적용
+//  - callback_pool 지정 시 callback 은 key 별 serial executor 로 넘기고 수신 thread 는 바로 복귀
+//  - batch frame (topic_batcher.hpp) 은 메시지 단위로 풀어서 일반 메시지와 같은 경로로 전달
+//  - 수신한 topic 은 registry 조회만 (RawMessage::topic_id) - wildcard 없는 구독 topic 은 subscribe 시 intern
+//    loop 는 topic id 별 router 매칭 결과를 cache, id 가 없는 topic 은 매번 router 매칭
+// ------------------------------------------------------
+class ZmqPollSubscriber : virtual public ISubscriber {
 public:
-    ~ZmqPollSubscriber()
-    {
+    explicit ZmqPollSubscriber(ZmqSubscriberDescriptor desc = {}) : desc_(std::move(desc)) { }
+
+    ~ZmqPollSubscriber() override {
         stop();
     }
 
-    Result<void> init() {
-        context_ = zmq_ctx_new();
+    Result<void> init() override {
+        std::unique_lock<std::shared_mutex> guard(loops_mutex_);
+        if (!loops_.empty()) return Error(ResultCode::AlreadyExists, "subscriber already initialized");
+
+        context_ = desc_.context ? desc_.context : ZmqContext::instance().get();
         if (!context_) {
             return Error(ResultCode::InternalError, "Failed to create ZMQ context");
         }
 
-        running_.store(true);
-
-        //thread_ = std::thread(&ZmqPollSubscriber::pollLoop, this);
+        size_t count = desc_.poll_loops ? desc_.poll_loops : 1;
+        for (size_t i = 0; i < count; ++i) {
+            int core = desc_.affinity.empty() ? -1 : desc_.affinity[i % desc_.affinity.size()];
+            auto loop = std::make_unique<PollLoop>(*this, i, core);
+            if (!loop->valid()) {
+                loops_.clear();
+                context_ = nullptr;
+                return Error(ResultCode::InternalError, "Failed to create poll loop wake fd");
+            }
+            loops_.push_back(std::move(loop));
+        }
 
+        if (desc_.callback_pool) {
+            task::SerialExecutorDescriptor ed;
+            ed.name      = desc_.name + "Cb";
+            ed.shards    = desc_.callback_shards;
+            ed.max_depth = 0;                       // 구독 단위 max_pending 으로 제한
+            executor_ = std::make_unique<task::SerialExecutor>(*desc_.callback_pool, ed);
+        }
         return OK();
     }
 
-    Result<void> start() {
-
+    Result<void> start() override {
+        std::shared_lock<std::shared_mutex> guard(loops_mutex_);
+        if (loops_.empty()) return Error(ResultCode::InvalidState, "subscriber not initialized");
+        for (auto& loop : loops_) {
+            auto r = loop->start();
+            if (!r) return r;
+        }
+        std::lock_guard<std::mutex> sources(sources_mutex_);
+        for (auto& reader : readers_) {
+            auto r = reader->start();
+            if (!r) return r;
+        }
+        started_.store(true, std::memory_order_release);
+        LOGI("{} started with {} poll loop(s)", desc_.name, loops_.size());
+        return OK();
     }
 
-    Result<void> stop() {
-        bool expected = true;
-        if (running_.compare_exchange_strong(expected, false)) {
-            // wake up poll by setting a very short linger and closing after join
-            if (thread_.joinable()) {
-                thread_.join();
+    Result<void> stop() override {
+        started_.store(false, std::memory_order_release);
+
+        // publisher thread 에서 진행 중인 직접 전달 / ring reader 가 끝난 뒤 loop 정리
+        // detach / join 은 lock 밖에서 (진행 중인 callback 이 add / remove 를 호출해도 막히지 않음)
+        // 그 사이 addLocal / addBus 로 추가된 것이 있으면 다시 정리 - 없을 때만 loops_ 를 비움
+        std::vector<std::unique_ptr<PollLoop>> loops;
+        for (;;) {
+            std::vector<std::shared_ptr<LocalChannel>> channels;
+            std::vector<std::unique_ptr<ShmRingReader>> readers;
+            {
+                std::unique_lock<std::shared_mutex> guard(loops_mutex_);
+                std::lock_guard<std::mutex> sources(sources_mutex_);
+                if (channels_.empty() && readers_.empty()) {
+                    loops.swap(loops_);             // 이후 add / remove 는 loop 없음으로 처리
+                    break;
+                }
+                channels.swap(channels_);
+                readers.swap(readers_);
             }
-            zmq_close(sub_socket_);
-            zmq_ctx_term(context_);
+            for (auto& channel : channels) channel->detach(this);
+            readers.clear();
         }
+        for (auto& loop : loops) loop->stop();
+        loops.clear();
+
+        // 수신이 모두 멈춘 뒤 - 대기 중인 callback 은 버리고 실행 중인 것만 기다림
+        if (executor_) {
+            executor_->close();
+            executor_.reset();
+
+            std::lock_guard<std::mutex> lock(ids_mutex_);
+            for (auto& [id, sub] : ids_) {
+                sub->stats.pending.store(0, std::memory_order_relaxed);
+                std::lock_guard<std::mutex> latest(sub->latest_mutex);
+                sub->latest.clear();
+            }
+        }
+        context_ = nullptr;
         return OK();
     }
 
-    Result<void> addBus(const std::string& bus) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto socket = zmq_socket(context_, ZMQ_SUB);
-        if (!socket) {
-            zmq_ctx_term(context_);
-            return Error(ResultCode::SocketError, "create socket error");
+    // 모든 poll loop 가 해당 endpoint 에 SUB socket 을 connect
+    // shm://<name> 은 ring reader worker 하나가 읽어 topic 의 loop table 로 전달
+    Result<void> addBus(const std::string& bus) override {
+        std::shared_lock<std::shared_mutex> guard(loops_mutex_);
+        if (loops_.empty()) return Error(ResultCode::InvalidState, "subscriber not initialized");
+
+        if (shm::isShmEndpoint(bus)) {
+            auto reader = std::make_unique<ShmRingReader>(shm::nameOf(bus), [this](const RawMessage& m) {
+                stats_.received++;
+                dispatchAll(m);
+            });
+            std::lock_guard<std::mutex> sources(sources_mutex_);
+            if (started_.load(std::memory_order_acquire)) {
+                auto r = reader->start();
+                if (!r) return r;
+            }
+            readers_.push_back(std::move(reader));
+            return OK();
         }
 
-        if (zmq_connect(socket, bus.c_str()) != 0) {
-            zmq_close(socket);
-            zmq_ctx_term(context_);
-            return Error(ResultCode::ConnectionFail, "Failed to connect socket");
-        }
-        sockets_.push_back(socket);
-        items_.push_back({ socket, 0, ZMQ_POLLIN, 0 });
-        items_dirty.store(true);
+        for (auto& loop : loops_) loop->post({OpType::Connect, bus});
+        return OK();
     }
 
-    Result<void> subscribe(SubscribeDescriptor desc) { 
+    // 같은 process 의 Direct publisher - socket 없이 publisher thread 에서 callback 호출
+    Result<void> addLocal(std::shared_ptr<LocalChannel> channel) {
+        std::shared_lock<std::shared_mutex> guard(loops_mutex_);
+        if (loops_.empty()) return Error(ResultCode::InvalidState, "subscriber not initialized");
+        if (!channel) return Error(ResultCode::InvalidArgument, "channel is null");
+
+        channel->attach(this, [this](const RawMessage& m) {
+            stats_.local_received++;
+            dispatchAll(m);
+        });
+        std::lock_guard<std::mutex> sources(sources_mutex_);
+        channels_.push_back(std::move(channel));
+        return OK();
+    }
+
+    Result<void> subscribe(SubscribeDescriptor desc) override {
+        auto r = add(std::move(desc));
+        if (!r) return Error(r.code(), r.error());
+        return OK();
+    }
+
+    // pattern 의 모든 callback 제거 + filter 해제
+    Result<void> unsubscribe(const std::string& topic) override {
         {
-            std::lock_guard<std::mutex> lock(callbacks_mutex_);
-            auto it = callbacks_.find(desc.topic);
-            if(it != callbacks_.end()) {
-                auto list = it->second;
-                list.push_back(std::move(desc));
+            std::shared_lock<std::shared_mutex> guard(loops_mutex_);
+            if (loops_.empty()) return Error(ResultCode::InvalidState, "subscriber not initialized");
+            if (!loopFor(topic).removeTopic(topic)) {
+                return Error(ResultCode::NotFound, "topic not subscribed: " + topic);
+            }
+        }
+        std::lock_guard<std::mutex> lock(ids_mutex_);
+        for (auto it = ids_.begin(); it != ids_.end();) {
+            if (it->second->desc.topic == topic) {
+                it->second->active.store(false, std::memory_order_release);
+                it = ids_.erase(it);
+            } else {
+                ++it;
             }
         }
+        return OK();
     }
 
-    Result<void> unsubscribe(const std::string& topic) {
+    // 개별 callback 단위 구독 - 해제 시 remove(id)
+    Result<SubscriptionId> add(SubscribeDescriptor desc) {
+        std::shared_lock<std::shared_mutex> guard(loops_mutex_);
+        if (loops_.empty()) return Result<SubscriptionId>::Error(ResultCode::InvalidState, "subscriber not initialized");
+        if (!desc.callback && !desc.raw_callback && !desc.view_callback) return Result<SubscriptionId>::Error(ResultCode::InvalidArgument, "callback is empty");
+        if (auto v = topic::validate(desc.topic); !v) return Result<SubscriptionId>::Error(v.code(), v.error());
+        if (desc.conflate && (!executor_ || desc.inline_dispatch)) {
+            return Result<SubscriptionId>::Error(ResultCode::InvalidArgument, "conflate requires callback_pool dispatch");
+        }
 
+        if (!topic::hasWildcard(desc.topic)) internTopic(desc.topic);
+
+        auto sub = std::make_shared<Subscription>();
+        sub->id = next_id_.fetch_add(1, std::memory_order_relaxed);
+        sub->max_pending  = desc.max_pending ? desc.max_pending : desc_.max_pending;
+        sub->slow_us      = 1000ull * (desc.slow_threshold_ms ? desc.slow_threshold_ms : desc_.slow_threshold_ms);
+        sub->serial       = executor_ && !desc.inline_dispatch;
+        sub->desc         = std::move(desc);
+        {
+            std::lock_guard<std::mutex> lock(ids_mutex_);
+            ids_.emplace(sub->id, sub);
+        }
+        loopFor(sub->desc.topic).addCallback(sub);
+        return Result<SubscriptionId>::OK(sub->id);
     }
 
-    
+    // pool 에서 실행 대기 중인 callback 은 호출하지 않음 (이미 실행 중인 것은 기다리지 않음)
+    Result<void> remove(SubscriptionId id) {
+        std::shared_ptr<Subscription> sub;
+        {
+            std::lock_guard<std::mutex> lock(ids_mutex_);
+            auto it = ids_.find(id);
+            if (it == ids_.end()) return Error(ResultCode::NotFound, "unknown subscription id");
+            sub = std::move(it->second);
+            ids_.erase(it);
+        }
+        sub->active.store(false, std::memory_order_release);
+        std::shared_lock<std::shared_mutex> guard(loops_mutex_);
+        if (loops_.empty()) return OK();
+        loopFor(sub->desc.topic).removeCallback(sub->desc.topic, id);
+        return OK();
+    }
 
-    Result<void> addMessageBus(const std::string& endpoint) {
-        
+    // 해제된 구독도 반환받은 pointer 로 계속 조회 가능
+    std::shared_ptr<const SubscriptionStats> subscriptionStats(SubscriptionId id) const {
+        std::lock_guard<std::mutex> lock(ids_mutex_);
+        auto it = ids_.find(id);
+        if (it == ids_.end()) return nullptr;
+        return std::shared_ptr<const SubscriptionStats>(it->second, &it->second->stats);
     }
 
+    size_t loopCount() const {
+        std::shared_lock<std::shared_mutex> guard(loops_mutex_);
+        return loops_.size();
+    }
+    const ZmqSubscriberStats& stats() const noexcept { return stats_; }
 
+protected:
+    static constexpr const char* LOG_TAG = "ZmqSubscriber";
 
 private:
-    void pollLoop()
-    {
-        while (running_.load()) {
-            if (items_dirty) {
-                std::lock_guard<std::mutex> lock(items_mutex);
-                rebuildItemsVector();  // items를 새롭게 구성
-                items_dirty = false;
-            }
-
-            // timeout in ms (e.g., 100ms) – lets us check running_ periodically
-            int rc = zmq_poll(items, 1, 100);
-            if (rc < 0) {
-                // interrupted or error
-                if (!running_.load())
-                    break;
-                continue;
-            }
+    enum class OpType { Connect, Subscribe, Unsubscribe };
 
-            if (items[0].revents & ZMQ_POLLIN) {
-                receiveAndDispatch();
-            }
-        }
-    }
+    struct Op {
+        OpType type;
+        std::string arg;
+    };
 
-    void receiveAndDispatch()
-    {
-        // ZeroMQ pub/sub: frame 0 = topic, frame 1 = payload
-        char topic_buf[256];
-        char msg_buf[4096];
+    // pool 에서 실행을 기다리는 메시지 (RawMessage 복사로 수신 버퍼 유지)
+    struct Pending {
+        RawMessage raw;
+        std::shared_ptr<const message::Message> msg;
+        std::shared_ptr<const message::MessageView> view;
+        std::chrono::steady_clock::time_point queued_at;
+    };
 
-        int tsize = zmq_recv(sub_socket_, topic_buf, sizeof(topic_buf), 0);
-        if (tsize <= 0) return;
+    struct Subscription {
+        SubscriptionId id = 0;
+        SubscribeDescriptor desc;
+        size_t max_pending = 0;
+        uint64_t slow_us = 0;
+        bool serial = false;                    // callback pool 에서 실행
+        std::atomic<bool> active{true};         // remove 이후 대기 중인 callback 건너뜀
+        SubscriptionStats stats;
+
+        std::mutex latest_mutex;                // conflate - topic 별 실행 대기 중인 최신 메시지
+        std::unordered_map<TopicId, Pending> latest;
+    };
 
-        int msize = zmq_recv(sub_socket_, msg_buf, sizeof(msg_buf), 0);
-        if (msize <= 0) return;
+    // router 는 node 를 복사하므로 pointer 만 보관
+    using Entry = std::shared_ptr<Subscription>;
 
-    }
+    // Message callback 용 decode / view callback 용 view - 메시지당 한 번, pool 의 callback 들이 공유
+    struct LazyMessage {
+        explicit LazyMessage(const RawMessage& r) : raw(r) { }
 
-private:
-    class WorkerImpl : public task::Worker {
+        const RawMessage& raw;
+        std::shared_ptr<const message::Message> msg;
+        std::shared_ptr<const message::MessageView> view;
+        bool failed = false;
+
+        // index 는 callback 에서 처음 field 를 읽을 때 생성
+        const message::MessageView* getView() {
+            if (!view) view = std::make_shared<const message::MessageView>(retain(raw));
+            return view.get();
+        }
+
+        const message::Message* get(ZmqSubscriberStats& stats, BusMetrics* metrics) {
+            if (!msg && !failed) {
+                try {
+                    auto t0 = metrics ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+                    msg = std::make_shared<const message::Message>(message::deserialize(raw));
+                    if (metrics) metrics->onDecode(raw.topic_id, elapsedNs(t0));
+                } catch (const std::exception& ex) {
+                    failed = true;
+                    stats.failed++;
+                    LOG_WARN(LOG_TAG, "decode failed topic={} : {}", raw.topic, ex.what());
+                }
+            }
+            return msg.get();
+        }
+    };
+
+    // ------------------------------------------------------
+    // PollLoop - SUB socket 들과 wake fd 를 하나의 zmq_poll 로 감시
+    // ------------------------------------------------------
+    class PollLoop : public task::Worker {
     public:
-        WorkerImpl(ZmqPollSubscriber& parent) : parent_(parent) {
+        PollLoop(ZmqPollSubscriber& parent, size_t index, int core) : parent_(parent) {
+            wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
             task::WorkerDescriptor wd;
-            wd.name = "Subscriber";
-            wd.type = task::WorkerType::Loop;
-            wd.loop_sleep_ms = 2;        
+            wd.name = fmt::format("{}{}", parent.desc_.name, index);
+            wd.type = task::WorkerType::Single;
+            if (core >= 0) wd.affinity = {core};
 
             auto r = Worker::init(wd);
             if (!r) {
-                LOGE("Subscriber inner thread init failed: {}", r.error());
+                LOGE("Subscriber poll loop init failed: {}", to_string(r));
+            }
+        }
+
+        ~PollLoop() override {
+            stop();
+            if (wake_fd_ >= 0) ::close(wake_fd_);
+        }
+
+        bool valid() const noexcept { return wake_fd_ >= 0; }
+
+        void post(Op op) {
+            {
+                std::lock_guard<std::mutex> lock(ops_mutex_);
+                ops_.push_back(std::move(op));
             }
+            wake();
         }
-        
+
+        // router 갱신은 copy-on-write - 진행 중인 dispatch 를 막지 않음
+        void addCallback(const Entry& sub) {
+            const std::string& pattern = sub->desc.topic;
+            std::string filter = topic::literalPrefix(pattern);
+            bool first = false;
+            {
+                std::lock_guard<std::mutex> lock(filters_mutex_);
+                router_.add(pattern, sub);
+                first = ++filter_refs_[filter] == 1;
+            }
+            invalidateMatches();
+            if (first) post({OpType::Subscribe, std::move(filter)});
+        }
+
+        void removeCallback(const std::string& pattern, SubscriptionId id) {
+            removeMatching(pattern, [id](const Entry& e) { return e->id == id; });
+        }
+
+        bool removeTopic(const std::string& pattern) {
+            return removeMatching(pattern, [](const Entry&) { return true; });
+        }
+
     protected:
+        static constexpr const char* LOG_TAG = "ZmqSubscriber";
+
         Result<void> run() override {
-            parent_.pollLoop();
+            items_.clear();
+            items_.push_back({nullptr, wake_fd_, ZMQ_POLLIN, 0});
+
+            while (!isStopRequested()) {
+                applyOps();
+
+                int rc = zmq_poll(items_.data(), static_cast<int>(items_.size()), -1);
+                if (rc < 0) {
+                    if (zmq_errno() == ETERM) break;
+                    continue;
+                }
+
+                if (items_[0].revents & ZMQ_POLLIN) {
+                    uint64_t v;
+                    while (::read(wake_fd_, &v, sizeof(v)) > 0) { }
+                }
+
+                for (size_t i = 1; i < items_.size(); ++i) {
+                    if (!(items_[i].revents & ZMQ_POLLIN)) continue;
+                    for (size_t n = 0; n < parent_.desc_.recv_batch; ++n) {
+                        if (!receiveAndDispatch(items_[i].socket)) break;
+                    }
+                }
+            }
+
+            closeSockets();
+            return OK();
+        }
+
+        void onPreStop() override {
+            wake();
         }
 
     private:
+        void wake() {
+            uint64_t one = 1;
+            [[maybe_unused]] auto n = ::write(wake_fd_, &one, sizeof(one));
+        }
+
+        // poll thread 전용 - 요청된 connect / filter 변경을 socket 에 적용
+        void applyOps() {
+            std::vector<Op> ops;
+            {
+                std::lock_guard<std::mutex> lock(ops_mutex_);
+                ops.swap(ops_);
+            }
+
+            for (auto& op : ops) {
+                parent_.stats_.control_ops++;
+                switch (op.type) {
+                case OpType::Connect:     connect(op.arg);                      break;
+                case OpType::Subscribe:   setFilter(ZMQ_SUBSCRIBE, op.arg);     break;
+                case OpType::Unsubscribe: setFilter(ZMQ_UNSUBSCRIBE, op.arg);   break;
+                }
+            }
+        }
+
+        void connect(const std::string& endpoint) {
+            void* socket = zmq_socket(parent_.context_, ZMQ_SUB);
+            if (!socket) {
+                LOGE("create SUB socket failed: {}", zmq_strerror(zmq_errno()));
+                return;
+            }
+            int linger = 0;
+            zmq_setsockopt(socket, ZMQ_LINGER, &linger, sizeof(linger));
+            zmq_setsockopt(socket, ZMQ_RCVHWM, &parent_.desc_.rcvhwm, sizeof(int));
+
+            if (zmq_connect(socket, endpoint.c_str()) != 0) {
+                LOGE("connect {} failed: {}", endpoint, zmq_strerror(zmq_errno()));
+                zmq_close(socket);
+                return;
+            }
+            // 이미 등록된 filter 를 새 socket 에도 적용
+            for (auto& f : filters_) {
+                zmq_setsockopt(socket, ZMQ_SUBSCRIBE, f.data(), f.size());
+            }
+            items_.push_back({socket, 0, ZMQ_POLLIN, 0});
+        }
+
+        void setFilter(int option, const std::string& topic) {
+            if (option == ZMQ_SUBSCRIBE) {
+                if (!filters_.insert(topic).second) return;
+            } else {
+                // 해제 요청 이후 다시 구독된 경우 filter 유지
+                {
+                    std::lock_guard<std::mutex> lock(filters_mutex_);
+                    if (filter_refs_.count(topic)) return;
+                }
+                if (filters_.erase(topic) == 0) return;
+            }
+
+            for (size_t i = 1; i < items_.size(); ++i) {
+                if (zmq_setsockopt(items_[i].socket, option, topic.data(), topic.size()) != 0) {
+                    LOGW("filter '{}' update failed: {}", topic, zmq_strerror(zmq_errno()));
+                }
+            }
+        }
+
+        void closeSockets() {
+            for (size_t i = 1; i < items_.size(); ++i) zmq_close(items_[i].socket);
+            items_.clear();
+            filters_.clear();
+        }
+
+        // frame 0 = topic, frame 1 = payload (나머지 frame 은 무시)
+        // zmq_msg_t 로 수신하므로 크기 제한 / 복사 없음
+        bool receiveAndDispatch(void* socket) {
+            ZmqMultipart parts;
+            auto r = parts.recv(socket, ZMQ_DONTWAIT);
+            if (!r) return false;
+
+            if (parts.size() == 3 && batch::isBatch(parts.view(1))) {
+                dispatchBatch(std::move(parts));
+                return true;
+            }
+            // last-value cache / lossless topic 은 [topic][payload][SEQ], metrics_stamp 이면 마지막에 [STAMP]
+            uint64_t seq = 0;
+            metrics::Stamp mark;
+            for (size_t i = 2; i < parts.size(); ++i) {
+                auto frame = parts.view(i);
+                if (!metrics::decodeStamp(frame, mark)) seq = lvc::decodeSeq(frame);
+            }
+            size_t bytes = parts.size() > 1 ? parts.view(1).size() : 0;
+            auto raw = toRawMessage(std::move(parts));
+            raw.seq = seq;
+            raw.topic_id = findTopic(raw.topic);
+
+            parent_.stats_.received++;
+            if (parent_.desc_.metrics) parent_.desc_.metrics->onReceive(raw.topic_id, bytes, &mark);
+            if (!dispatch(raw)) parent_.stats_.unmatched++;
+            return true;
+        }
+
+        // [topic][TAG][blob] - 메시지마다 blob 안의 payload 를 가리키는 RawMessage 로 전달 (복사 없음)
+        void dispatchBatch(ZmqMultipart&& parts) {
+            auto owner = std::make_shared<ZmqMultipart>(std::move(parts));
+            RawMessage raw;
+            raw.topic = owner->view(0);
+            raw.owner = owner;
+            raw.topic_id = findTopic(raw.topic);
+
+            parent_.stats_.batches++;
+            bool ok = batch::forEach(owner->view(2), [&](std::string_view payload) {
+                raw.payload = payload;
+                parent_.stats_.received++;
+                parent_.stats_.unbatched++;
+                if (parent_.desc_.metrics) parent_.desc_.metrics->onReceive(raw.topic_id, payload.size());
+                if (!dispatch(raw)) parent_.stats_.unmatched++;
+            });
+            if (!ok) {
+                parent_.stats_.failed++;
+                LOGW("malformed batch on '{}'", raw.topic);
+            }
+        }
+
+    public:
+        // poll thread 또는 Direct / shm 수신 thread 에서 호출
+        // return: 이 loop 의 pattern 중 일치한 것이 있는지
+        bool dispatch(const RawMessage& raw) {
+            // Message 변환은 Message callback 이 있을 때 한 번만
+            LazyMessage lazy(raw);
+
+            // 매칭 결과 snapshot 기준 - callback 내부에서 subscribe / unsubscribe 가능
+            auto entries = matches(raw);
+            for (auto& e : *entries) {
+                if (e->serial) {
+                    parent_.enqueue(e, raw, lazy);
+                    continue;
+                }
+                const message::Message* msg = nullptr;
+                const message::MessageView* view = nullptr;
+                if (!e->desc.raw_callback) {
+                    if (e->desc.view_callback) view = lazy.getView();
+                    else if (!(msg = lazy.get(parent_.stats_, parent_.desc_.metrics))) continue;
+                }
+                parent_.invoke(*e, raw, msg, view);
+            }
+            return !entries->empty();
+        }
+
+    private:
+        using Matches = std::shared_ptr<const std::vector<Entry>>;
+
+        // topic id 별 router 매칭 결과 - 구독 변경 시 전부 무효화 (generation 이 바뀌면 저장하지 않음)
+        Matches matches(const RawMessage& raw) {
+            uint64_t generation = 0;
+            if (raw.topic_id != NO_TOPIC) {
+                std::shared_lock<std::shared_mutex> lock(matches_mutex_);
+                if (auto* cached = matches_.find(raw.topic_id); cached && *cached) return *cached;
+                generation = generation_;
+            }
+
+            auto list = std::make_shared<std::vector<Entry>>();
+            router_.match(raw.topic, [&](const Entry& e) { list->push_back(e); });
+            if (raw.topic_id == NO_TOPIC) return list;
+
+            std::unique_lock<std::shared_mutex> lock(matches_mutex_);
+            if (generation == generation_) matches_.get(raw.topic_id) = list;
+            return list;
+        }
+
+        void invalidateMatches() {
+            std::unique_lock<std::shared_mutex> lock(matches_mutex_);
+            matches_.clear();
+            ++generation_;
+        }
+
+        template<typename Pred>
+        bool removeMatching(const std::string& pattern, Pred&& pred) {
+            std::string filter = topic::literalPrefix(pattern);
+            bool last = false;
+            {
+                std::lock_guard<std::mutex> lock(filters_mutex_);
+                size_t removed = router_.remove(pattern, pred);
+                if (!removed) return false;
+                invalidateMatches();
+
+                auto it = filter_refs_.find(filter);
+                if (it != filter_refs_.end() && (it->second -= std::min(it->second, removed)) == 0) {
+                    filter_refs_.erase(it);
+                    last = true;
+                }
+            }
+            if (last) post({OpType::Unsubscribe, std::move(filter)});
+            return true;
+        }
+
         ZmqPollSubscriber& parent_;
+        int wake_fd_ = -1;
+
+        std::mutex ops_mutex_;
+        std::vector<Op> ops_;
+
+        TopicRouter<Entry> router_;
+
+        std::shared_mutex matches_mutex_;
+        TopicSlots<Matches> matches_;
+        uint64_t generation_ = 0;
+
+        // literal prefix 별 구독 pattern 수 (ZMQ filter 참조 계수)
+        std::mutex filters_mutex_;
+        std::unordered_map<std::string, size_t> filter_refs_;
+
+        // poll thread 전용
+        std::vector<zmq_pollitem_t> items_;         // [0] = wake fd
+        std::unordered_set<std::string> filters_;
     };
 
-    void* context_     = nullptr;
-    void* sub_socket_  = nullptr;
+    void invoke(Subscription& sub, const RawMessage& raw, const message::Message* msg,
+                const message::MessageView* view) {
+        if (view && !view->ok()) {
+            stats_.failed++;
+            sub.stats.failed++;
+            LOGW("decode failed topic={} : {}", raw.topic, view->error());
+            return;
+        }
+        auto t0 = desc_.metrics ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+        Result<void> r = sub.desc.raw_callback ? sub.desc.raw_callback(raw)
+                       : view                  ? sub.desc.view_callback(*view)
+                                               : sub.desc.callback(*msg);
+        if (desc_.metrics) desc_.metrics->onCallback(raw.topic_id, elapsedNs(t0));
+        stats_.dispatched++;
+        sub.stats.dispatched++;
+        if (!r) {
+            stats_.failed++;
+            sub.stats.failed++;
+            LOGW("callback failed topic={} : {}", raw.topic, to_string(r));
+        }
+    }
 
-    std::mutex mutex_;
-    std::atomic<bool> running_{false};
-    std::thread thread_;
+    // 수신 thread -> serial executor (같은 key 는 같은 shard 에서 순서대로)
+    // conflate 구독은 topic 당 대기 항목 하나 - 이미 대기 중이면 최신 값으로 교체만 함
+    void enqueue(const Entry& sub, const RawMessage& raw, LazyMessage& lazy) {
+        auto& st = sub->stats;
+        std::shared_ptr<const message::Message> msg;
+        std::shared_ptr<const message::MessageView> view;
+        if (!sub->desc.raw_callback) {
+            if (sub->desc.view_callback) {
+                lazy.getView();
+                view = lazy.view;
+            } else {
+                if (!lazy.get(stats_, desc_.metrics)) return;
+                msg = lazy.msg;
+            }
+        }
+        Pending item{retain(raw), std::move(msg), std::move(view), std::chrono::steady_clock::now()};
+
+        // conflate 는 topic 별 최신 값을 보관하므로 id 가 없으면 여기서 intern (registry 한도 초과면 conflate 하지 않음)
+        TopicId topic = raw.topic_id;
+        if (sub->desc.conflate && topic == NO_TOPIC) topic = internTopic(raw.topic);
+        bool conflate = sub->desc.conflate && topic != NO_TOPIC;
+        if (conflate) {
+            std::lock_guard<std::mutex> lock(sub->latest_mutex);
+            auto [it, inserted] = sub->latest.try_emplace(topic);
+            it->second = std::move(item);
+            if (!inserted) {
+                st.conflated++;
+                stats_.conflated++;
+                return;
+            }
+        }
+
+        size_t pending = st.pending.fetch_add(1, std::memory_order_relaxed) + 1;
+        bool accepted = !sub->max_pending || pending <= sub->max_pending;
+        if (accepted) {
+            size_t peak = st.max_pending.load(std::memory_order_relaxed);
+            while (pending > peak && !st.max_pending.compare_exchange_weak(peak, pending, std::memory_order_relaxed)) { }
+
+            uint64_t key = sub->desc.order_key ? sub->desc.order_key(raw)
+                         : raw.topic_id    ? raw.topic_id
+                                           : std::hash<std::string_view>{}(raw.topic);
+            Result<void> r = OK();
+            if (conflate) {
+                r = executor_->post(key, [this, sub, topic] {
+                    Pending latest;
+                    {
+                        std::lock_guard<std::mutex> lock(sub->latest_mutex);
+                        auto it = sub->latest.find(topic);
+                        if (it == sub->latest.end()) {
+                            sub->stats.pending.fetch_sub(1, std::memory_order_relaxed);
+                            return;
+                        }
+                        latest = std::move(it->second);
+                        sub->latest.erase(it);
+                    }
+                    complete(sub, latest);
+                });
+            } else {
+                r = executor_->post(key, [this, sub, item = std::move(item)] { complete(sub, item); });
+            }
+            accepted = static_cast<bool>(r);
+        }
+        if (!accepted) {
+            if (conflate) {
+                std::lock_guard<std::mutex> lock(sub->latest_mutex);
+                sub->latest.erase(topic);
+            }
+            st.pending.fetch_sub(1, std::memory_order_relaxed);
+            st.dropped++;
+            stats_.dropped++;
+            if (desc_.metrics) desc_.metrics->onQueueDrop(topic);
+            return;
+        }
+        stats_.queued++;
+    }
+
+    // pool thread - callback 실행 후 수신 ~ 완료 지연 기록
+    void complete(const Entry& sub, const Pending& item) {
+        if (sub->active.load(std::memory_order_acquire)) {
+            invoke(*sub, item.raw, item.msg.get(), item.view.get());
+
+            auto us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - item.queued_at).count());
+            auto& st = sub->stats;
+            uint64_t max = st.max_latency_us.load(std::memory_order_relaxed);
+            while (us > max && !st.max_latency_us.compare_exchange_weak(max, us, std::memory_order_relaxed)) { }
+            if (sub->slow_us && us > sub->slow_us) {
+                st.slow++;
+                stats_.slow++;
+            }
+        }
+        sub->stats.pending.fetch_sub(1, std::memory_order_relaxed);
+    }
 
-    std::vector<void*> sockets_;
-    std::vector<zmq_pollitem_t> items_;
+    static uint64_t elapsedNs(std::chrono::steady_clock::time_point t0) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count());
+    }
 
-    std::unordered_map<std::string, std::vector<SubscribeDescriptor>> callbacks_;
-    std::mutex callbacks_mutex_;
+    // owner 가 없는 메시지는 내용을 복사해서 보관
+    static RawMessage retain(const RawMessage& raw) {
+        if (raw.owner) return raw;
+        auto copy = std::make_shared<const std::pair<std::string, std::string>>(raw.topicString(), raw.payloadString());
+        return RawMessage{copy->first, copy->second, copy, raw.seq, raw.topic_id};
+    }
 
-    std::atomic<bool> items_dirty{false};
+    // 같은 topic 이라도 pattern 은 여러 loop 에 흩어져 있으므로 모든 loop 에 전달
+    void dispatchAll(const RawMessage& m) {
+        if (m.topic_id == NO_TOPIC) {
+            RawMessage found = m;
+            found.topic_id = findTopic(m.topic);
+            if (found.topic_id != NO_TOPIC) return dispatchAll(found);
+        }
+        if (desc_.metrics) desc_.metrics->onReceive(m.topic_id, m.payload.size());
+        bool matched = false;
+        for (auto& loop : loops_) matched |= loop->dispatch(m);
+        if (!matched) stats_.unmatched++;
+    }
+
+    // loops_mutex_ 보유 상태에서 호출
+    PollLoop& loopFor(const std::string& topic) {
+        return *loops_[std::hash<std::string>{}(topic) % loops_.size()];
+    }
 
-    WorkerImpl worker_;
+    ZmqSubscriberDescriptor desc_;
+    void* context_ = nullptr;
+
+    // add / remove / unsubscribe / addBus / addLocal 은 shared, init / stop 은 exclusive
+    // (dispatchAll 은 channel / reader 정리 이후에만 loops_ 가 바뀌므로 lock 없이 순회)
+    mutable std::shared_mutex loops_mutex_;
+    std::vector<std::unique_ptr<PollLoop>> loops_;
+    // channels_ / readers_ 변경은 sources_mutex_ (loops_mutex_ 다음 순서)
+    // attach 는 loops_mutex_ 를 shared 로만 잡음 - 전달 중인 callback 이 add 를 호출해도 막히지 않음
+    std::mutex sources_mutex_;
+    std::vector<std::shared_ptr<LocalChannel>> channels_;
+    std::vector<std::unique_ptr<ShmRingReader>> readers_;
+    std::unique_ptr<task::SerialExecutor> executor_;
+    std::atomic<bool> started_{false};
+
+    mutable std::mutex ids_mutex_;
+    std::unordered_map<SubscriptionId, std::shared_ptr<Subscription>> ids_;
+    std::atomic<SubscriptionId> next_id_{1};
+
+    ZmqSubscriberStats stats_;
 };
@@ -11,6 +11,7 @@
 #include "worker.hpp"
 #include "async_task.hpp"
 #include "task_unit.hpp"
+#include "io_reactor.hpp"
 
 namespace task {
 
@@ -20,6 +21,13 @@ namespace task {
 struct AsyncPoolDescriptor {
     size_t async_count = std::thread::hardware_concurrency(); // 동시 수행 가능한 async 개수
     size_t max_queue   = 128;
+
+    // I/O 실행 모드 - core 당 ring 하나, 제출 batch / 완료 시 재개
+    bool io_enabled = false;
+    std::vector<int> io_cores;                           // 비어있으면 전체 코어
+    unsigned io_entries = 256;
+    IoBackendType io_backend = IoBackendType::Auto;
+    unsigned io_blocking_threads = 2;                    // ring 별 epoll fallback 파일 I/O thread
 };
 
 
@@ -44,7 +52,7 @@ public:
 
         auto r = Worker::init(wd);
         if (!r) {
-            LOGE("TaskPool init failed: {}", r.error());
+            LOGE("TaskPool init failed: {}", to_string(r));
         }
     }
 
@@ -74,6 +82,39 @@ public:
         return OK();
     }
 
+    // read/write/fsync/accept 를 reactor 로 넘기고 async 스레드는 점유하지 않음
+    // resume_in_pool == true 이면 on_complete 를 reactor 대신 pool 에서 재개
+    Result<void> submitIo(IoRequest req, bool resume_in_pool = false) {
+        if (!req.on_complete) return Error(ResultCode::InvalidArgument, "IoRequest requires on_complete");
+
+        if (resume_in_pool) {
+            req.on_complete = [this, cb = std::move(req.on_complete)](Result<size_t> r) {
+                if (isStopRequested()) { cb(r); return; }
+
+                TaskDescriptor<void> td;
+                td.name     = "IoResume";
+                td.dispatch = TaskDispatchPolicy::Immediate;
+                td.func     = [cb, r]() { cb(r); return OK(); };
+                if (!submit(td)) cb(r);         // queue full → reactor 에서 바로 재개
+            };
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (reactors_.empty())
+            return Error(ResultCode::InvalidState, "AsyncPool I/O mode disabled");
+
+        // 현재 core 의 ring 우선, 없으면 round-robin
+        IoReactor* reactor = nullptr;
+        int cpu = ::sched_getcpu();
+        auto it = core_to_reactor_.find(cpu);
+        if (it != core_to_reactor_.end()) {
+            reactor = reactors_[it->second].get();
+        } else {
+            reactor = reactors_[next_reactor_++ % reactors_.size()].get();
+        }
+        return reactor->submit(std::move(req));
+    }
+
 
 protected:
     Result<void> run() override {
@@ -176,17 +217,63 @@ protected:
             all_async_ids_.push_back(i);
         }
 
+        if (desc_.io_enabled) {
+            auto res = startReactors();
+            if (!res) {
+                asyncs_.clear();
+                all_async_ids_.clear();
+                return res;
+            }
+        }
+
         return OK();
     }
 
     void onPostStop() override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        asyncs_.clear();
-        all_async_ids_.clear();
-        while (!tasks_.empty()) tasks_.pop();
+        std::vector<std::unique_ptr<IoReactor>> reactors;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            asyncs_.clear();
+            all_async_ids_.clear();
+            while (!tasks_.empty()) tasks_.pop();
+
+            reactors.swap(reactors_);
+            core_to_reactor_.clear();
+        }
+        // 취소된 I/O 완료 콜백이 submit() 을 호출할 수 있으므로 lock 밖에서 정지
+        for (auto& reactor : reactors) reactor->stop();
     }
 
 private:
+    Result<void> startReactors() {
+        std::vector<int> cores = desc_.io_cores;
+        if (cores.empty()) {
+            for (unsigned c = 0; c < std::thread::hardware_concurrency(); ++c)
+                cores.push_back(static_cast<int>(c));
+        }
+
+        LOGI("AsyncPool I/O mode: rings={}, entries={}", cores.size(), desc_.io_entries);
+
+        for (int core : cores) {
+            IoReactorDescriptor rd;
+            rd.core    = core;
+            rd.entries = desc_.io_entries;
+            rd.backend = desc_.io_backend;
+            rd.blocking_threads = desc_.io_blocking_threads;
+
+            auto reactor = std::make_unique<IoReactor>(rd);
+            auto res = reactor->start();
+            if (!res) {
+                reactors_.clear();
+                core_to_reactor_.clear();
+                return res;
+            }
+            core_to_reactor_[core] = reactors_.size();
+            reactors_.push_back(std::move(reactor));
+        }
+        return OK();
+    }
+
     struct TaskItem {
         TaskDescriptor<void> desc;
         int priority;
@@ -215,6 +302,10 @@ private:
     std::unordered_map<size_t, AsyncItem> asyncs_; // key - index, value - async task
     std::vector<size_t> all_async_ids_;
 
+    std::vector<std::unique_ptr<IoReactor>> reactors_;
+    std::unordered_map<int, size_t> core_to_reactor_;   // core → reactors_ index
+    size_t next_reactor_ = 0;
+
     AsyncPoolStats stats_;
 
     const char* LOG_TAG = "AsyncPool";
@@ -0,0 +1,318 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "result.h"
+#include "worker.hpp"
+#include "fiber.hpp"
+
+// NOTE
+// MpscChannel<Frame> ch(256);
+// ch.bindWorker(&processor);            // send 시 processor.event()
+// producer: ch.send(std::move(frame));  // 가득 차면 대기 (backpressure)
+// consumer: ch.drain(batch, 32);        // 한 번에 최대 32개
+
+namespace task {
+
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+namespace detail {
+
+inline size_t roundUpPow2(size_t v) {
+    size_t p = 2;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+// ------------------------------------------------------
+// 공통 blocking / close / Worker 연동 (CRTP)
+// Derived 는 tryPush(U&&) / tryPop(T&) / sizeApprox() 제공
+// ------------------------------------------------------
+template<typename Derived, typename T>
+class ChannelBase {
+public:
+    // Event 타입 Worker 연동 - send 성공 시 worker->event()
+    void bindWorker(Worker* worker) noexcept { worker_.store(worker, std::memory_order_release); }
+
+    bool trySend(const T& value) { return afterSend(self().tryPush(value)); }
+    bool trySend(T&& value)      { return afterSend(self().tryPush(std::move(value))); }
+
+    // 가득 차 있으면 공간이 생길 때까지 대기 (timeout_ms < 0 : 무한)
+    Result<void> send(T value, int timeout_ms = -1) {
+        auto deadline = deadlineOf(timeout_ms);
+        for (;;) {
+            if (closed_.load(std::memory_order_acquire))
+                return Error(ResultCode::Cancelled, "channel closed");
+            if (trySend(std::move(value))) return OK();
+
+            WaitNode node;
+            not_full_.add(&node);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!self().full() || closed_.load(std::memory_order_acquire)) {
+                not_full_.remove(&node);
+                continue;
+            }
+            int left = remaining(deadline, timeout_ms);
+            if (left == 0 || !node.park(left)) {
+                not_full_.remove(&node);
+                if (timeout_ms >= 0 && remaining(deadline, timeout_ms) == 0)
+                    return Error(ResultCode::Timeout, "channel send timeout");
+            }
+        }
+    }
+
+    bool tryReceive(T& out) {
+        if (!self().tryPop(out)) return false;
+        afterReceive(1);
+        return true;
+    }
+
+    Result<void> receive(T& out) { return receiveFor(out, -1); }
+
+    Result<void> receiveFor(T& out, int timeout_ms) {
+        auto deadline = deadlineOf(timeout_ms);
+        for (;;) {
+            if (tryReceive(out)) return OK();
+            if (closed_.load(std::memory_order_acquire))
+                return tryReceive(out) ? OK() : Error(ResultCode::Cancelled, "channel closed");
+
+            WaitNode node;
+            not_empty_.add(&node);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!self().empty() || closed_.load(std::memory_order_acquire)) {
+                not_empty_.remove(&node);
+                continue;
+            }
+            int left = remaining(deadline, timeout_ms);
+            if (left == 0 || !node.park(left)) {
+                not_empty_.remove(&node);
+                if (timeout_ms >= 0 && remaining(deadline, timeout_ms) == 0)
+                    return tryReceive(out) ? OK() : Error(ResultCode::Timeout, "channel receive timeout");
+            }
+        }
+    }
+
+    // 쌓인 항목을 한 번에 꺼냄, 꺼낸 개수 반환 (대기하지 않음)
+    size_t drain(std::vector<T>& out, size_t max = static_cast<size_t>(-1)) {
+        size_t n = 0;
+        T value;
+        while (n < max && self().tryPop(value)) {
+            out.push_back(std::move(value));
+            ++n;
+        }
+        if (n) afterReceive(n);
+        return n;
+    }
+
+    // 이후 send 실패, 대기 중인 send/receive 깨움 (남은 항목은 receive 가능)
+    void close() {
+        closed_.store(true, std::memory_order_seq_cst);
+        not_empty_.notifyAll();
+        not_full_.notifyAll();
+        if (auto* w = worker_.load(std::memory_order_acquire)) w->event();
+    }
+
+    bool isClosed() const noexcept { return closed_.load(std::memory_order_acquire); }
+
+protected:
+    using clock = std::chrono::steady_clock;
+
+    Derived& self() { return static_cast<Derived&>(*this); }
+
+    bool afterSend(bool ok) {
+        if (!ok) return false;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        not_empty_.notifyOne();
+        if (auto* w = worker_.load(std::memory_order_acquire)) w->event();
+        return true;
+    }
+
+    void afterReceive(size_t n) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (n == 1) not_full_.notifyOne();
+        else        not_full_.notifyAll();
+    }
+
+    static clock::time_point deadlineOf(int timeout_ms) {
+        return clock::now() + std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+    }
+
+    // -1: 무한, 0: 만료
+    static int remaining(clock::time_point deadline, int timeout_ms) {
+        if (timeout_ms < 0) return -1;
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now()).count();
+        return left > 0 ? static_cast<int>(left) : 0;
+    }
+
+private:
+    std::atomic<bool> closed_{false};
+    std::atomic<Worker*> worker_{nullptr};
+    WaitQueue not_empty_;
+    WaitQueue not_full_;
+};
+
+} // namespace detail
+
+
+// ------------------------------------------------------
+// SpscChannel - 단일 producer / 단일 consumer, lock-free ring
+// ------------------------------------------------------
+template<typename T>
+class SpscChannel : public detail::ChannelBase<SpscChannel<T>, T> {
+public:
+    explicit SpscChannel(size_t capacity)
+        : capacity_(detail::roundUpPow2(capacity)), mask_(capacity_ - 1),
+          slots_(new Slot[capacity_]) { }
+
+    ~SpscChannel() {
+        T tmp;
+        while (tryPop(tmp)) { }
+    }
+
+    SpscChannel(const SpscChannel&)            = delete;
+    SpscChannel& operator=(const SpscChannel&) = delete;
+
+    size_t capacity() const noexcept { return capacity_; }
+    size_t size() const noexcept {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    bool empty() const noexcept { return size() == 0; }
+    bool full() const noexcept { return size() >= capacity_; }
+
+private:
+    friend class detail::ChannelBase<SpscChannel<T>, T>;
+
+    struct Slot {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        T* ptr() noexcept { return std::launder(reinterpret_cast<T*>(&storage)); }
+    };
+
+    template<typename U>
+    bool tryPush(U&& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ >= capacity_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ >= capacity_) return false;
+        }
+        new (&slots_[tail & mask_].storage) T(std::forward<U>(value));
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& out) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) return false;
+        }
+        T* p = slots_[head & mask_].ptr();
+        out = std::move(*p);
+        p->~T();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // producer / consumer 가 각자 쓰는 index 는 서로 다른 cache line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t head_cache_ = 0;                                     // producer 전용
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t tail_cache_ = 0;                                     // consumer 전용
+    alignas(CACHE_LINE_SIZE) char pad_[1] = {};
+};
+
+
+// ------------------------------------------------------
+// MpscChannel - 다중 producer / 단일 consumer, bounded lock-free ring
+// (slot 별 sequence 로 producer 간 CAS 예약)
+// ------------------------------------------------------
+template<typename T>
+class MpscChannel : public detail::ChannelBase<MpscChannel<T>, T> {
+public:
+    explicit MpscChannel(size_t capacity)
+        : capacity_(detail::roundUpPow2(capacity)), mask_(capacity_ - 1),
+          slots_(new Slot[capacity_]) {
+        for (size_t i = 0; i < capacity_; ++i)
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    ~MpscChannel() {
+        T tmp;
+        while (tryPop(tmp)) { }
+    }
+
+    MpscChannel(const MpscChannel&)            = delete;
+    MpscChannel& operator=(const MpscChannel&) = delete;
+
+    size_t capacity() const noexcept { return capacity_; }
+    size_t size() const noexcept {
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t head = head_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+    bool empty() const noexcept { return size() == 0; }
+    bool full() const noexcept { return size() >= capacity_; }
+
+private:
+    friend class detail::ChannelBase<MpscChannel<T>, T>;
+
+    struct Slot {
+        std::atomic<size_t> seq;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        T* ptr() noexcept { return std::launder(reinterpret_cast<T*>(&storage)); }
+    };
+
+    template<typename U>
+    bool tryPush(U&& value) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    new (&slot.storage) T(std::forward<U>(value));
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;       // full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& out) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[pos & mask_];
+        size_t seq = slot.seq.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) return false;   // empty
+
+        T* p = slot.ptr();
+        out = std::move(*p);
+        p->~T();
+        slot.seq.store(pos + capacity_, std::memory_order_release);
+        head_.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};     // producers
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};     // consumer
+    alignas(CACHE_LINE_SIZE) char pad_[1] = {};
+};
+
+} // namespace task
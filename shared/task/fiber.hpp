@@ -0,0 +1,579 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "result.h"
+#include "logging.hpp"
+#include "futex.hpp"
+#include "thread_task.hpp"
+
+// NOTE
+// FiberScheduler sched({2, {4, 5}});          // carrier 2개, A76 core 고정
+// sched.start();
+// sched.spawn("poll", []() { while (...) { poll(); this_fiber::sleepFor(10); } });
+
+namespace task {
+
+class FiberScheduler;
+
+// ------------------------------------------------------
+// guard page 가 있는 fiber stack (pool 재사용)
+// ------------------------------------------------------
+struct FiberStack {
+    void*  base = nullptr;      // mmap 시작 주소 (guard page 포함)
+    size_t size = 0;            // guard page 포함 전체 크기
+
+    void*  sp() const noexcept { return static_cast<char*>(base) + pageSize(); }
+    size_t usable() const noexcept { return size - pageSize(); }
+
+    static size_t pageSize() noexcept {
+        static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return page;
+    }
+};
+
+class FiberStackPool {
+public:
+    FiberStackPool(size_t stack_size, size_t max_pooled)
+        : max_pooled_(max_pooled) {
+        size_t page = FiberStack::pageSize();
+        stack_size_ = ((stack_size + page - 1) / page) * page + page;   // + guard page
+    }
+
+    ~FiberStackPool() {
+        for (auto& s : free_) ::munmap(s.base, s.size);
+    }
+
+    bool acquire(FiberStack& out) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_.empty()) {
+                out = free_.back();
+                free_.pop_back();
+                return true;
+            }
+        }
+        void* mem = ::mmap(nullptr, stack_size_, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+        if (mem == MAP_FAILED) return false;
+        // stack 은 아래로 자라므로 가장 낮은 page 를 guard 로 사용
+        if (::mprotect(mem, FiberStack::pageSize(), PROT_NONE) != 0) {
+            ::munmap(mem, stack_size_);
+            return false;
+        }
+        out = {mem, stack_size_};
+        return true;
+    }
+
+    void release(FiberStack& s) {
+        if (!s.base) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (free_.size() < max_pooled_) {
+                free_.push_back(s);
+                s = {};
+                return;
+            }
+        }
+        ::munmap(s.base, s.size);
+        s = {};
+    }
+
+private:
+    size_t stack_size_;
+    size_t max_pooled_;
+    std::mutex mutex_;
+    std::vector<FiberStack> free_;
+};
+
+
+// ------------------------------------------------------
+// Fiber
+// ------------------------------------------------------
+struct Fiber {
+    enum State : uint32_t {
+        Ready,
+        Running,
+        Yielding,
+        Parking,        // park 요청, carrier 로 전환 중
+        Parked,
+        Notified,       // 전환 완료 전에 깨움 요청 도착
+        Done,
+    };
+
+    ucontext_t ctx{};
+    ucontext_t* carrier = nullptr;      // 현재 실행 중인 carrier context
+    FiberStack stack;
+    std::function<void()> fn;
+    std::string name;
+    std::atomic<uint32_t> state{Ready};
+    FiberScheduler* sched = nullptr;
+};
+
+
+// ------------------------------------------------------
+// WaitNode - fiber / 일반 스레드 공용 대기 노드
+// fiber 이면 scheduler 로 park, 스레드이면 futex 로 block
+// ------------------------------------------------------
+struct WaitNode {
+    enum : uint32_t { Waiting = 0, Notified = 1, TimedOut = 2 };
+
+    WaitNode();
+
+    std::atomic<uint32_t> state{Waiting};
+    Fiber* fiber = nullptr;
+    std::multimap<std::chrono::steady_clock::time_point, WaitNode*>::iterator timer;
+    bool timer_armed = false;
+
+    // return: 깨움 성공 여부 (이미 timeout / 다른 notify 로 깨어났으면 false)
+    bool notify();
+    // return: notify 로 깨어났으면 true, timeout 이면 false
+    bool park(int timeout_ms = -1);
+};
+
+// ------------------------------------------------------
+// WaitQueue - channel / mutex 등 blocking primitive 의 대기열
+// ------------------------------------------------------
+class WaitQueue {
+public:
+    void add(WaitNode* node) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        nodes_.push_back(node);
+        count_.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    void remove(WaitNode* node) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find(nodes_.begin(), nodes_.end(), node);
+        if (it != nodes_.end()) {
+            nodes_.erase(it);
+            count_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    bool notifyOne() {
+        if (count_.load(std::memory_order_seq_cst) == 0) return false;
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!nodes_.empty()) {
+            WaitNode* node = nodes_.front();
+            nodes_.pop_front();
+            count_.fetch_sub(1, std::memory_order_relaxed);
+            if (node->notify()) return true;
+        }
+        return false;
+    }
+
+    void notifyAll() {
+        if (count_.load(std::memory_order_seq_cst) == 0) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto* node : nodes_) node->notify();
+        nodes_.clear();
+        count_.store(0, std::memory_order_relaxed);
+    }
+
+    bool empty() const noexcept { return count_.load(std::memory_order_seq_cst) == 0; }
+
+private:
+    std::mutex mutex_;
+    std::deque<WaitNode*> nodes_;
+    std::atomic<size_t> count_{0};
+};
+
+
+// ------------------------------------------------------
+// FiberScheduler - 소수의 carrier 스레드 위에서 fiber 를 multiplexing
+// ------------------------------------------------------
+struct FiberSchedulerDescriptor {
+    size_t carrier_count = 2;
+    std::vector<int> core_affinity;         // carrier 별 round-robin pinning
+    size_t stack_size = 64 * 1024;
+    size_t max_pooled_stacks = 1024;
+};
+
+struct FiberSchedulerStats {
+    std::atomic<size_t> spawned{0};
+    std::atomic<size_t> completed{0};
+    std::atomic<size_t> live{0};
+    std::atomic<size_t> switches{0};
+};
+
+class FiberScheduler {
+public:
+    explicit FiberScheduler(const FiberSchedulerDescriptor& desc = {})
+        : desc_(desc), stacks_(desc.stack_size, desc.max_pooled_stacks) { }
+
+    ~FiberScheduler() { stop(); }
+
+    FiberScheduler(const FiberScheduler&)            = delete;
+    FiberScheduler& operator=(const FiberScheduler&) = delete;
+
+    // 기본 scheduler (첫 사용 시 시작)
+    // process 종료 시 해제하지 않음 - 정적 소멸 시점에는 carrier 의 thread_local (log tag 등) 이 이미 해제됨
+    static FiberScheduler& instance() {
+        static FiberScheduler* sched = new FiberScheduler();
+        static bool started = static_cast<bool>(sched->start());
+        (void)started;
+        return *sched;
+    }
+
+    Result<void> start() {
+        std::lock_guard<std::mutex> lock(life_mutex_);
+        if (running_.load(std::memory_order_acquire)) return OK();
+
+        stop_.store(false, std::memory_order_relaxed);
+        size_t count = desc_.carrier_count ? desc_.carrier_count : 1;
+        for (size_t i = 0; i < count; ++i) {
+            auto carrier = std::make_unique<ThreadTask<void>>();
+            auto r = carrier->init();
+            if (!r) { stopCarriers(); return r; }
+
+            TaskDescriptor<void> td;
+            td.name = fmt::format("fiber{}", i);
+            if (!desc_.core_affinity.empty())
+                td.affinity = {desc_.core_affinity[i % desc_.core_affinity.size()]};
+            td.func = [this]() { carrierLoop(); return OK(); };
+
+            r = carrier->execute(td);
+            if (!r) { stopCarriers(); return r; }
+            carriers_.push_back(std::move(carrier));
+        }
+        running_.store(true, std::memory_order_release);
+        LOGI("FiberScheduler started: carriers={}, stack={}KB", count, desc_.stack_size / 1024);
+        return OK();
+    }
+
+    Result<void> stop() {
+        std::lock_guard<std::mutex> lock(life_mutex_);
+        if (!running_.exchange(false)) return OK();
+        stopCarriers();
+
+        // 실행되지 못한 fiber 정리 (park 중인 fiber 는 대기열이 참조하므로 해제하지 않음)
+        std::lock_guard<std::mutex> q(mutex_);
+        for (auto* f : ready_) { destroy(f); stats_.live--; }
+        ready_.clear();
+        if (stats_.live.load() > 0)
+            LOGW("FiberScheduler stopped with {} live fibers", stats_.live.load());
+        return OK();
+    }
+
+    Result<void> spawn(const std::string& name, std::function<void()> fn) {
+        if (!fn) return Error(ResultCode::InvalidArgument, "Invalid func");
+        if (!running_.load(std::memory_order_acquire))
+            return Error(ResultCode::InvalidState, "FiberScheduler not started");
+
+        auto* f = new Fiber();
+        if (!stacks_.acquire(f->stack)) {
+            delete f;
+            return Error(ResultCode::OutOfMemory, "fiber stack allocation failed");
+        }
+        f->fn    = std::move(fn);
+        f->name  = name;
+        f->sched = this;
+
+        ::getcontext(&f->ctx);
+        f->ctx.uc_stack.ss_sp   = f->stack.sp();
+        f->ctx.uc_stack.ss_size = f->stack.usable();
+        f->ctx.uc_link = nullptr;
+        ::makecontext(&f->ctx, &FiberScheduler::trampoline, 0);
+
+        stats_.spawned++;
+        stats_.live++;
+        enqueue(f);
+        return OK();
+    }
+
+    // fiber 깨움 (park 전환 중이면 carrier 가 재등록)
+    void wake(Fiber* f, bool locked = false) {
+        for (;;) {
+            uint32_t s = f->state.load(std::memory_order_acquire);
+            if (s == Fiber::Running || s == Fiber::Parking) {
+                if (f->state.compare_exchange_weak(s, Fiber::Notified, std::memory_order_acq_rel)) return;
+            } else if (s == Fiber::Parked) {
+                if (f->state.compare_exchange_weak(s, Fiber::Ready, std::memory_order_acq_rel)) {
+                    locked ? enqueueLocked(f) : enqueue(f);
+                    return;
+                }
+            } else {
+                return;     // Ready / Notified / Done
+            }
+        }
+    }
+
+    // carrier 간 이동 후 이전 carrier 의 TLS 값을 재사용하지 않도록 inline 금지
+    __attribute__((noinline)) static Fiber* current() noexcept { return current_; }
+
+    // 현재 fiber 를 carrier 로 되돌림
+    static void suspend(Fiber* f, uint32_t state) {
+        f->state.store(state, std::memory_order_release);
+        ::swapcontext(&f->ctx, f->carrier);
+    }
+
+    // 현재 fiber park, wake() 또는 timer 로 재개
+    static void park(Fiber* f) {
+        uint32_t expected = Fiber::Running;
+        if (!f->state.compare_exchange_strong(expected, Fiber::Parking, std::memory_order_acq_rel)) {
+            f->state.store(Fiber::Running, std::memory_order_relaxed);     // 이미 깨움 도착
+            return;
+        }
+        ::swapcontext(&f->ctx, f->carrier);
+    }
+
+    void armTimer(WaitNode* node, std::chrono::steady_clock::time_point deadline) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        node->timer = timers_.emplace(deadline, node);
+        node->timer_armed = true;
+        cond_.notify_one();
+    }
+
+    void cancelTimer(WaitNode* node) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (node->timer_armed) {
+            timers_.erase(node->timer);
+            node->timer_armed = false;
+        }
+    }
+
+    const FiberSchedulerStats& stats() const noexcept { return stats_; }
+
+protected:
+    static constexpr const char* LOG_TAG = "FiberScheduler";
+
+private:
+    void enqueue(Fiber* f) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        enqueueLocked(f);
+    }
+
+    void enqueueLocked(Fiber* f) {
+        f->state.store(Fiber::Ready, std::memory_order_release);
+        ready_.push_back(f);
+        cond_.notify_one();
+    }
+
+    void fireTimersLocked(std::chrono::steady_clock::time_point now) {
+        while (!timers_.empty() && timers_.begin()->first <= now) {
+            WaitNode* node = timers_.begin()->second;
+            timers_.erase(timers_.begin());
+            node->timer_armed = false;
+
+            uint32_t expected = WaitNode::Waiting;
+            if (node->state.compare_exchange_strong(expected, WaitNode::TimedOut, std::memory_order_acq_rel))
+                wake(node->fiber, true);
+        }
+    }
+
+    void carrierLoop() {
+        ucontext_t carrier_ctx;
+        while (!stop_.load(std::memory_order_acquire)) {
+            Fiber* f = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                auto now = std::chrono::steady_clock::now();
+                fireTimersLocked(now);
+                if (ready_.empty()) {
+                    auto until = timers_.empty() ? now + std::chrono::milliseconds(100)
+                                                 : std::min(timers_.begin()->first, now + std::chrono::milliseconds(100));
+                    cond_.wait_until(lock, until);
+                    continue;
+                }
+                f = ready_.front();
+                ready_.pop_front();
+            }
+            runFiber(f, &carrier_ctx);
+        }
+    }
+
+    void runFiber(Fiber* f, ucontext_t* carrier_ctx) {
+        f->carrier = carrier_ctx;
+        f->state.store(Fiber::Running, std::memory_order_release);
+        current_ = f;
+        ::swapcontext(carrier_ctx, &f->ctx);
+        current_ = nullptr;
+        stats_.switches++;
+
+        uint32_t s = f->state.load(std::memory_order_acquire);
+        switch (s) {
+            case Fiber::Yielding:
+                enqueue(f);
+                break;
+            case Fiber::Parking:
+                if (!f->state.compare_exchange_strong(s, Fiber::Parked, std::memory_order_acq_rel))
+                    enqueue(f);     // 전환 중 깨움 도착 (Notified)
+                break;
+            case Fiber::Notified:
+                enqueue(f);
+                break;
+            case Fiber::Done:
+                stats_.completed++;
+                stats_.live--;
+                destroy(f);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void destroy(Fiber* f) {
+        stacks_.release(f->stack);
+        delete f;
+    }
+
+    static void trampoline() {
+        Fiber* f = current_;
+        try {
+            f->fn();
+        } catch (const std::exception& e) {
+            LOG_ERROR(LOG_TAG, "fiber[{}] exception: {}", f->name, e.what());
+        } catch (...) {
+            LOG_ERROR(LOG_TAG, "fiber[{}] unknown exception occurred", f->name);
+        }
+        f->fn = nullptr;
+        suspend(f, Fiber::Done);
+    }
+
+    void stopCarriers() {
+        stop_.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cond_.notify_all();
+        }
+        for (auto& c : carriers_) c->wait();
+        for (auto& c : carriers_) { c->stop(); c->join(); }
+        carriers_.clear();
+    }
+
+private:
+    inline static thread_local Fiber* current_ = nullptr;
+
+    FiberSchedulerDescriptor desc_;
+    FiberStackPool stacks_;
+
+    std::mutex life_mutex_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stop_{false};
+    std::vector<std::unique_ptr<ThreadTask<void>>> carriers_;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<Fiber*> ready_;
+    std::multimap<std::chrono::steady_clock::time_point, WaitNode*> timers_;
+
+    FiberSchedulerStats stats_;
+};
+
+
+// ------------------------------------------------------
+// WaitNode 구현
+// ------------------------------------------------------
+inline WaitNode::WaitNode() : fiber(FiberScheduler::current()) { }
+
+inline bool WaitNode::notify() {
+    Fiber* f = fiber;       // CAS 이후 node 는 소유자에 의해 해제될 수 있음
+    uint32_t expected = Waiting;
+    if (!state.compare_exchange_strong(expected, Notified, std::memory_order_acq_rel))
+        return false;
+    if (f) f->sched->wake(f);
+    else   futexWake(state, 1);
+    return true;
+}
+
+inline bool WaitNode::park(int timeout_ms) {
+    if (!fiber) {
+        futexWaitUntil(state, [](uint32_t s) { return s != Waiting; }, timeout_ms);
+        uint32_t expected = Waiting;
+        if (state.compare_exchange_strong(expected, TimedOut, std::memory_order_acq_rel))
+            return false;
+        return state.load(std::memory_order_acquire) == Notified;
+    }
+
+    if (timeout_ms >= 0)
+        fiber->sched->armTimer(this, std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms));
+
+    while (state.load(std::memory_order_acquire) == Waiting)
+        FiberScheduler::park(fiber);
+
+    if (timeout_ms >= 0) fiber->sched->cancelTimer(this);
+    return state.load(std::memory_order_acquire) == Notified;
+}
+
+
+// ------------------------------------------------------
+// this_fiber - fiber 안에서는 carrier 를 양보, 스레드에서는 OS 대기
+// ------------------------------------------------------
+namespace this_fiber {
+
+inline bool inFiber() noexcept { return FiberScheduler::current() != nullptr; }
+
+inline void yield() {
+    Fiber* f = FiberScheduler::current();
+    if (f) FiberScheduler::suspend(f, Fiber::Yielding);
+    else   std::this_thread::yield();
+}
+
+inline void sleepFor(int msec) {
+    if (!inFiber()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(msec));
+        return;
+    }
+    WaitNode node;
+    node.park(msec);
+}
+
+} // namespace this_fiber
+
+
+// ------------------------------------------------------
+// FiberMutex - 대기 시 carrier 를 점유하지 않음 (std::lock_guard 호환)
+// ------------------------------------------------------
+class FiberMutex {
+public:
+    bool try_lock() noexcept {
+        return !locked_.exchange(true, std::memory_order_acquire);
+    }
+
+    void lock() {
+        if (try_lock()) return;
+
+        WaitNode node;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (try_lock()) return;
+            waiters_.push_back(&node);
+        }
+        node.park();        // unlock() 이 소유권을 직접 넘겨줌
+    }
+
+    void unlock() {
+        WaitNode* next = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (waiters_.empty()) {
+                locked_.store(false, std::memory_order_release);
+                return;
+            }
+            next = waiters_.front();
+            waiters_.pop_front();
+        }
+        next->notify();     // locked_ 유지한 채 hand-off
+    }
+
+private:
+    std::atomic<bool> locked_{false};
+    std::mutex mutex_;
+    std::deque<WaitNode*> waiters_;
+};
+
+} // namespace task
@@ -0,0 +1,180 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <string>
+#include <fmt/ostream.h>
+
+#include "result.h"
+#include "helper.hpp"
+#include "task_unit.hpp"
+#include "fiber.hpp"
+
+namespace task {
+
+// ------------------------------------------------------
+// FiberTask - 대기 위주 작업을 carrier 스레드 위의 fiber 로 수행
+// blocking 은 this_fiber::sleepFor / FiberMutex / channel 등 task 라이브러리 primitive 사용
+// ------------------------------------------------------
+template<typename T>
+class FiberTask : virtual public ResultTaskUnit<T> {
+public:
+    explicit FiberTask(FiberScheduler& sched = FiberScheduler::instance()) : sched_(sched) {
+        id_ = global_id_counter_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~FiberTask() {
+        stop();
+        join();
+        clearTagCache();
+    }
+
+    TaskExcutionMode excutionMode() const noexcept override { return TaskExcutionMode::Fiber; }
+
+    Result<void> init() override {
+        join();
+        stop_.store(false, std::memory_order_relaxed);
+        state_->has_task.store(false, std::memory_order_relaxed);
+        clearTagCache();
+        return sched_.start();
+    }
+
+    Result<T> result() override {
+        join();
+        std::lock_guard<std::mutex> lock(result_mutex_);
+        return last_result_;
+    }
+
+    Result<void> execute(TaskDescriptor<T> desc) override {
+        if (stop_.load(std::memory_order_relaxed)) return Fail();
+        if (!desc.func) return Error(ResultCode::InvalidArgument, "Invalid func");
+        if (state_->has_task.exchange(true)) return Error(ResultCode::ResourceBusy, "Already running fiber task");
+
+        desc_ = std::move(desc);
+        state_->running.store(true, std::memory_order_release);
+
+        // 완료 통지 이후 FiberTask 가 해제될 수 있음 - 마지막 통지는 state 만 사용
+        auto r = sched_.spawn(desc_.name, [this, state = state_]() {
+            Result<T> res;
+            try {
+                res = desc_.func();
+            } catch (const std::exception& e) {
+                LOG_ERROR(logTag(), "Unhandled exception: {}", e.what());
+                res = Result<T>::Fail();
+            } catch (...) {
+                LOG_ERROR(logTag(), "Unknown exception in fiber");
+                res = Result<T>::Fail();
+            }
+            {
+                std::lock_guard<std::mutex> lock(result_mutex_);
+                last_result_ = res;
+            }
+            if (desc_.on_complete)
+                desc_.on_complete(res);
+
+            state->finish();
+        });
+
+        if (!r) {
+            state_->running.store(false, std::memory_order_relaxed);
+            state_->has_task.store(false, std::memory_order_relaxed);
+        }
+        return r;
+    }
+
+    Result<void> stop() noexcept override {
+        stop_.store(true, std::memory_order_seq_cst);
+        return OK();
+    }
+
+    bool isStop() const noexcept override { return stop_.load(std::memory_order_relaxed); }
+    bool isRunning() const noexcept override { return state_->running.load(std::memory_order_relaxed); }
+    bool isIdle() const noexcept override { return !state_->has_task.load(std::memory_order_relaxed); }
+
+    // fiber 안에서 호출하면 carrier 를 양보하며 대기
+    Result<void> wait(int msec = -1) override {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(msec < 0 ? 0 : msec);
+        auto& state = *state_;
+        while (state.running.load(std::memory_order_acquire)) {
+            int left = -1;
+            if (msec >= 0) {
+                left = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count());
+                if (left <= 0) return Error(ResultCode::Timeout, "fiber wait timeout");
+            }
+
+            WaitNode node;
+            state.done.add(&node);
+            if (!state.running.load(std::memory_order_seq_cst)) {
+                state.done.remove(&node);
+                break;
+            }
+            if (!node.park(left)) state.done.remove(&node);
+        }
+        return OK();
+    }
+
+    Result<void> join() override { return wait(-1); }
+
+    Result<void> detach() override {
+        // fiber 는 scheduler 소유 → no-op
+        return OK();
+    }
+
+    Result<void> setAffinity(const std::vector<int>&) override {
+        // affinity 는 carrier 단위 (FiberSchedulerDescriptor::core_affinity)
+        return Error(ResultCode::NotSupported, "FiberTask does not support affinity");
+    }
+
+    std::size_t id() const override { return id_; }
+    int getPolicy() const override { return 0; }
+    int getPriority() const override { return 0; }
+
+protected:
+    static constexpr const char* LOG_TAG = "FiberTask";
+
+private:
+    const char* logTag() const {
+        auto [it, inserted] = tag_cache_.try_emplace(
+        this, fmt::format("{}<{}>#{:016x}", LOG_TAG,
+            demangle(typeid(T).name()),
+            static_cast<unsigned long long>(id_)));
+        return it->second.c_str();
+    }
+
+    void clearTagCache() const {
+        tag_cache_.erase(this);
+    }
+
+    // 완료 상태 - fiber 가 공유 소유 (wait 가 반환된 뒤에도 통지가 끝날 때까지 유지)
+    struct Completion {
+        std::atomic<bool> running{false};
+        std::atomic<bool> has_task{false};
+        WaitQueue done;
+
+        void finish() {
+            running.store(false, std::memory_order_release);
+            has_task.store(false, std::memory_order_release);
+            // store 와 대기자 수 load 의 순서 보장 (wait 의 add -> running 검사와 짝)
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            done.notifyAll();
+        }
+    };
+
+private:
+    inline static thread_local std::unordered_map<const FiberTask<T>*, std::string> tag_cache_;
+    inline static std::atomic<uint64_t> global_id_counter_{0};
+    uint64_t id_;
+
+    FiberScheduler& sched_;
+
+    std::atomic<bool> stop_{false};
+    std::shared_ptr<Completion> state_ = std::make_shared<Completion>();
+
+    TaskDescriptor<T> desc_;
+
+    std::mutex result_mutex_;
+    Result<T> last_result_;
+};
+
+} // namespace task
@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+namespace task {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "futex requires a plain 32-bit atomic word");
+
+// ------------------------------------------------------
+// futex 대기/깨움 - word 가 expected 와 다를 때까지 block
+// ------------------------------------------------------
+
+// return: 0 깨어남(또는 값 변경), ETIMEDOUT 시간초과, EINTR 시그널
+inline int futexWait(std::atomic<uint32_t>& word, uint32_t expected, int timeout_ms = -1,
+                     bool process_shared = false) {
+    timespec ts{};
+    timespec* pts = nullptr;
+    if (timeout_ms >= 0) {
+        ts.tv_sec  = timeout_ms / 1000;
+        ts.tv_nsec = static_cast<long>(timeout_ms % 1000) * 1000000L;
+        pts = &ts;
+    }
+    int op = process_shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE;
+    long rc = ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), op, expected, pts, nullptr, 0);
+    if (rc == 0) return 0;
+    return errno == EAGAIN ? 0 : errno;
+}
+
+inline void futexWake(std::atomic<uint32_t>& word, int count = INT_MAX, bool process_shared = false) {
+    int op = process_shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE;
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), op, count, nullptr, nullptr, 0);
+}
+
+// pred(word) 가 참이 될 때까지 대기, timeout_ms < 0 이면 무한 대기
+// return: pred 만족 여부
+template<typename Pred>
+inline bool futexWaitUntil(std::atomic<uint32_t>& word, Pred pred, int timeout_ms = -1,
+                           bool process_shared = false) {
+    using clock = std::chrono::steady_clock;
+    const auto deadline = clock::now() + std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+
+    for (;;) {
+        uint32_t cur = word.load(std::memory_order_acquire);
+        if (pred(cur)) return true;
+
+        int wait_ms = -1;
+        if (timeout_ms >= 0) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now()).count();
+            if (left <= 0) return pred(word.load(std::memory_order_acquire));
+            wait_ms = static_cast<int>(left);
+        }
+        futexWait(word, cur, wait_ms, process_shared);
+    }
+}
+
+} // namespace task
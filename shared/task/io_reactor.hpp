@@ -0,0 +1,771 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define TASK_HAS_IO_URING 1
+#else
+#define TASK_HAS_IO_URING 0
+#endif
+
+#include "macros.h"
+#include "result.h"
+#include "logging.hpp"
+#include "worker.hpp"
+
+// NOTE
+// IoReactor reactor(0);                      // core 0 에 고정된 ring
+// reactor.submit({IoOp::Read, fd, buf, len, 0, [](Result<size_t> r) { ... }});
+
+namespace task {
+
+enum class IoOp {
+    Read,
+    Write,
+    Fsync,
+    Accept,
+};
+
+enum class IoBackendType {
+    Auto,       // io_uring 우선, 실패 시 epoll
+    Uring,
+    Epoll,
+};
+
+// ------------------------------------------------------
+// I/O 요청 - 완료 시 on_complete 로 재개
+// ------------------------------------------------------
+struct IoRequest {
+    IoOp op = IoOp::Read;
+    int fd = -1;
+    void* buf = nullptr;
+    size_t len = 0;
+    off_t offset = -1;                                   // -1: 현재 파일 위치 / 소켓
+    std::function<void(Result<size_t>)> on_complete;    // Accept: value = accepted fd
+};
+
+struct IoReactorStats {
+    std::atomic<size_t> submitted{0};
+    std::atomic<size_t> completed{0};
+    std::atomic<size_t> failed{0};
+    std::atomic<size_t> batches{0};
+};
+
+inline Result<size_t> ioResult(int res) {
+    if (res >= 0) return Result<size_t>::OK(static_cast<size_t>(res));
+
+    int err = -res;
+    switch (err) {
+        case ECANCELED:   return Result<size_t>::Error(ResultCode::Cancelled, strerror(err));
+        case ETIMEDOUT:   return Result<size_t>::Error(ResultCode::Timeout, strerror(err));
+        case EAGAIN:      return Result<size_t>::Error(ResultCode::ResourceBusy, strerror(err));
+        case EBADF:
+        case EINVAL:      return Result<size_t>::Error(ResultCode::InvalidArgument, strerror(err));
+        case EACCES:
+        case EPERM:       return Result<size_t>::Error(ResultCode::PermissionDenied, strerror(err));
+        case ENOMEM:      return Result<size_t>::Error(ResultCode::OutOfMemory, strerror(err));
+        case ECONNRESET:
+        case EPIPE:       return Result<size_t>::Error(ResultCode::ConnectionLost, strerror(err));
+        default:          return Result<size_t>::Error(ResultCode::Fail, strerror(err));
+    }
+}
+
+// ------------------------------------------------------
+// backend interface
+// ------------------------------------------------------
+class IoBackend {
+public:
+    virtual ~IoBackend() = default;
+
+    virtual Result<void> init(unsigned entries) = 0;
+    // 요청 소유권은 backend 로 이동, 완료 후 backend 가 해제
+    virtual Result<void> submit(std::vector<std::unique_ptr<IoRequest>>& batch) = 0;
+    // 완료된 요청의 콜백을 수행하고 처리 개수 반환 (timeout_ms < 0 : 무한 대기)
+    // backend 해제 시 완료되지 않은 요청은 ECANCELED (ResultCode::Cancelled) 로 완료
+    virtual int reap(int timeout_ms) = 0;
+    virtual void wakeup() = 0;
+    virtual const char* name() const noexcept = 0;
+};
+
+#if TASK_HAS_IO_URING
+// ------------------------------------------------------
+// io_uring backend (raw syscall, liburing 불필요)
+// ------------------------------------------------------
+class UringBackend : public IoBackend {
+public:
+    ~UringBackend() override { close(); }
+
+    Result<void> init(unsigned entries) override {
+        io_uring_params params{};
+        ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (ring_fd_ < 0) {
+            ring_fd_ = -1;
+            return Error(ResultCode::NotSupported, fmt::format("io_uring_setup: {}", strerror(errno)));
+        }
+
+        sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        single_mmap_ = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap_) sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+
+        sq_ptr_ = ::mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring_fd_, IORING_OFF_SQ_RING);
+        if (sq_ptr_ == MAP_FAILED) { sq_ptr_ = nullptr; close(); return Error(ResultCode::OutOfMemory, "mmap sq ring"); }
+
+        cq_ptr_ = single_mmap_ ? sq_ptr_
+                               : ::mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                        ring_fd_, IORING_OFF_CQ_RING);
+        if (cq_ptr_ == MAP_FAILED) { cq_ptr_ = nullptr; close(); return Error(ResultCode::OutOfMemory, "mmap cq ring"); }
+
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                                                  MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES));
+        if (sqes_ == MAP_FAILED) { sqes_ = nullptr; close(); return Error(ResultCode::OutOfMemory, "mmap sqes"); }
+
+        auto* sq = static_cast<char*>(sq_ptr_);
+        sq_head_  = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail_  = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_  = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sq_entries_ = params.sq_entries;
+
+        auto* cq = static_cast<char*>(cq_ptr_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_    = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        wake_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (wake_fd_ < 0) { close(); return Error(ResultCode::InternalError, "eventfd"); }
+        armWakeup();
+        return OK();
+    }
+
+    Result<void> submit(std::vector<std::unique_ptr<IoRequest>>& batch) override {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            io_uring_sqe* sqe = nextSqe();
+            if (!sqe) {
+                enter(pending_, 0, 0);
+                sqe = nextSqe();
+            }
+            if (!sqe) {
+                // 제출된 요청은 ring 소유, 남은 요청만 호출자에게 반환
+                batch.erase(batch.begin(), batch.begin() + i);
+                return Error(ResultCode::ResourceBusy, "io_uring submission queue full");
+            }
+            prepare(sqe, *batch[i]);
+            IoRequest* req = batch[i].release();
+            sqe->user_data = reinterpret_cast<uint64_t>(req);
+            inflight_.insert(req);
+        }
+        batch.clear();
+        if (pending_ > 0) enter(pending_, 0, 0);
+        return OK();
+    }
+
+    int reap(int timeout_ms) override {
+        if (!hasCompletion() && timeout_ms != 0) {
+            if (timeout_ms < 0) enter(pending_, 1, IORING_ENTER_GETEVENTS);
+            else                waitCompletion(timeout_ms);
+        }
+
+        int count = 0;
+        unsigned head = *cq_head_;
+        while (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+            io_uring_cqe* cqe = &cqes_[head & cq_mask_];
+            uint64_t data = cqe->user_data;
+            int res = cqe->res;
+            ++head;
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+            if (data == WAKE_TAG) {
+                uint64_t v;
+                while (::read(wake_fd_, &v, sizeof(v)) > 0) { }
+                armWakeup();
+                continue;
+            }
+            if (data == CANCEL_TAG) continue;
+
+            std::unique_ptr<IoRequest> req(reinterpret_cast<IoRequest*>(data));
+            inflight_.erase(req.get());
+            if (req->on_complete) req->on_complete(ioResult(res));
+            ++count;
+        }
+        if (pending_ > 0) enter(pending_, 0, 0);
+        return count;
+    }
+
+    void wakeup() override {
+        uint64_t one = 1;
+        if (wake_fd_ >= 0) (void)::write(wake_fd_, &one, sizeof(one));
+    }
+
+    const char* name() const noexcept override { return "io_uring"; }
+
+private:
+    static constexpr uint64_t WAKE_TAG   = 0;
+    static constexpr uint64_t CANCEL_TAG = 1;        // ASYNC_CANCEL 자체의 완료 (요청 pointer 와 겹치지 않음)
+    static constexpr int CANCEL_WAIT_MS  = 1000;
+
+    bool hasCompletion() const {
+        return *cq_head_ != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    }
+
+    io_uring_sqe* nextSqe() {
+        unsigned tail = *sq_tail_;
+        unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        if (tail - head >= sq_entries_) return nullptr;
+
+        unsigned index = tail & sq_mask_;
+        io_uring_sqe* sqe = &sqes_[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        ++pending_;
+        return sqe;
+    }
+
+    void prepare(io_uring_sqe* sqe, const IoRequest& req) {
+        sqe->fd = req.fd;
+        switch (req.op) {
+            case IoOp::Read:
+                sqe->opcode = IORING_OP_READ;
+                sqe->addr = reinterpret_cast<uint64_t>(req.buf);
+                sqe->len = static_cast<uint32_t>(req.len);
+                sqe->off = static_cast<uint64_t>(req.offset);
+                break;
+            case IoOp::Write:
+                sqe->opcode = IORING_OP_WRITE;
+                sqe->addr = reinterpret_cast<uint64_t>(req.buf);
+                sqe->len = static_cast<uint32_t>(req.len);
+                sqe->off = static_cast<uint64_t>(req.offset);
+                break;
+            case IoOp::Fsync:
+                sqe->opcode = IORING_OP_FSYNC;
+                break;
+            case IoOp::Accept:
+                sqe->opcode = IORING_OP_ACCEPT;
+                sqe->accept_flags = SOCK_CLOEXEC;
+                break;
+        }
+    }
+
+    // 제출 대기분을 넘긴 뒤 ring fd 의 완료 알림을 timeout 만큼 대기
+    void waitCompletion(int timeout_ms) {
+        if (pending_ > 0) enter(pending_, 0, 0);
+        if (hasCompletion()) return;
+        pollfd pfd{ring_fd_, POLLIN, 0};
+        (void)::poll(&pfd, 1, timeout_ms);
+    }
+
+    // 진행 중인 요청을 ASYNC_CANCEL 로 취소하고 완료를 회수 (최대 CANCEL_WAIT_MS)
+    // 취소되지 않고 남은 요청은 close 에서 ECANCELED 로 완료
+    void cancelInflight() {
+        for (auto* req : inflight_) {
+            io_uring_sqe* sqe = nextSqe();
+            if (!sqe) {
+                enter(pending_, 0, 0);
+                sqe = nextSqe();
+            }
+            if (!sqe) break;
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->addr = reinterpret_cast<uint64_t>(req);
+            sqe->user_data = CANCEL_TAG;
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CANCEL_WAIT_MS);
+        while (!inflight_.empty()) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0) break;
+            reap(static_cast<int>(left));
+        }
+    }
+
+    void armWakeup() {
+        io_uring_sqe* sqe = nextSqe();
+        if (!sqe) return;
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = wake_fd_;
+        sqe->poll_events = POLLIN;
+        sqe->user_data = WAKE_TAG;
+    }
+
+    void enter(unsigned to_submit, unsigned min_complete, unsigned flags) {
+        int rc = static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, nullptr, 0));
+        if (rc >= 0) {
+            pending_ -= std::min<unsigned>(pending_, static_cast<unsigned>(rc));
+        } else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            LOG_WARN(LOG_TAG, "io_uring_enter failed: {}", strerror(errno));
+        }
+    }
+
+    void close() {
+        if (sq_ptr_ && cq_ptr_ && sqes_ && !inflight_.empty()) cancelInflight();
+        auto left = std::move(inflight_);
+        inflight_.clear();
+
+        if (sqes_) ::munmap(sqes_, sqes_size_);
+        if (cq_ptr_ && !single_mmap_) ::munmap(cq_ptr_, cq_size_);
+        if (sq_ptr_) ::munmap(sq_ptr_, sq_size_);
+        SAFE_CLOSE(wake_fd_);
+        SAFE_CLOSE(ring_fd_);
+        sqes_ = nullptr; cq_ptr_ = nullptr; sq_ptr_ = nullptr;
+
+        // ring 을 닫은 뒤라 kernel 은 더 이상 요청을 참조하지 않음
+        for (auto* raw : left) {
+            std::unique_ptr<IoRequest> req(raw);
+            if (req->on_complete) req->on_complete(ioResult(-ECANCELED));
+        }
+    }
+
+    static constexpr const char* LOG_TAG = "UringBackend";
+
+    int ring_fd_ = -1;
+    int wake_fd_ = -1;
+    bool single_mmap_ = false;
+    unsigned pending_ = 0;
+
+    void* sq_ptr_ = nullptr;
+    void* cq_ptr_ = nullptr;
+    size_t sq_size_ = 0;
+    size_t cq_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+
+    std::unordered_set<IoRequest*> inflight_;       // ring 에 제출되어 완료되지 않은 요청 (reactor 스레드 전용)
+};
+#endif // TASK_HAS_IO_URING
+
+// ------------------------------------------------------
+// epoll fallback backend
+// 소켓/파이프는 readiness 기반, 일반 파일(epoll 불가)과 fsync 는 blocking helper thread 에서 수행
+//  - 느린 fsync / 디스크 read 가 같은 reactor 의 소켓 완료를 막지 않음 (완료 콜백은 reactor 스레드)
+//  - fd 별로 같은 helper 에 배정 - 같은 fd 의 요청 순서 유지 (offset -1 의 현재 위치 read / write)
+//  - blocking_threads == 0 이면 reactor 스레드에서 직접 수행 (파일 I/O 와 소켓 I/O 가 직렬화됨)
+// ------------------------------------------------------
+class EpollBackend : public IoBackend {
+public:
+    explicit EpollBackend(unsigned blocking_threads = 2) : blocking_threads_(blocking_threads) { }
+
+    ~EpollBackend() override {
+        // 수행 중인 syscall 은 끝날 때까지 대기, 시작하지 않은 요청은 취소
+        std::vector<IoRequest*> cancelled;
+        for (auto& lane : lanes_) {
+            {
+                std::lock_guard<std::mutex> lock(lane->mutex);
+                lane->stop = true;
+                cancelled.insert(cancelled.end(), lane->queue.begin(), lane->queue.end());
+                lane->queue.clear();
+            }
+            lane->cv.notify_one();
+        }
+        for (auto& lane : lanes_) {
+            if (lane->thread.joinable()) lane->thread.join();
+        }
+        drainBlocking();
+        drainInline();
+        for (auto* req : cancelled) complete(req, -ECANCELED);
+        for (auto& [fd, st] : fds_) {
+            for (auto* q : {&st.readers, &st.writers})
+                for (auto* req : *q) {
+                    if (req->on_complete) req->on_complete(ioResult(-ECANCELED));
+                    delete req;
+                }
+        }
+        SAFE_CLOSE(wake_fd_);
+        SAFE_CLOSE(epoll_fd_);
+    }
+
+    Result<void> init(unsigned entries) override {
+        events_.resize(entries ? entries : 64);
+        epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd_ < 0) return Error(ResultCode::InternalError, "epoll_create1");
+
+        wake_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (wake_fd_ < 0) return Error(ResultCode::InternalError, "eventfd");
+
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = wake_fd_;
+        if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev) != 0)
+            return Error(ResultCode::InternalError, "epoll_ctl wake fd");
+        return OK();
+    }
+
+    Result<void> submit(std::vector<std::unique_ptr<IoRequest>>& batch) override {
+        for (auto& req : batch) {
+            int fd = req->fd;
+            if (req->op == IoOp::Fsync) {
+                postBlocking(req.release());
+                continue;
+            }
+
+            auto& st = fds_[fd];
+            if (req->op == IoOp::Write) st.writers.push_back(req.release());
+            else                        st.readers.push_back(req.release());
+
+            if (!updateInterest(fd, st)) {
+                // 일반 파일 등 epoll 등록 불가 → blocking helper 에서 수행
+                for (auto* q : {&st.readers, &st.writers}) {
+                    for (auto* r : *q) postBlocking(r);
+                    q->clear();
+                }
+                fds_.erase(fd);
+            }
+        }
+        batch.clear();
+        return OK();
+    }
+
+    int reap(int timeout_ms) override {
+        int count = 0;
+        if (!inline_done_.empty()) timeout_ms = 0;
+        int n = ::epoll_wait(epoll_fd_, events_.data(), static_cast<int>(events_.size()), timeout_ms);
+        for (int i = 0; i < n; ++i) {
+            int fd = events_[i].data.fd;
+            if (fd == wake_fd_) {
+                uint64_t v;
+                while (::read(wake_fd_, &v, sizeof(v)) > 0) { }
+                continue;
+            }
+
+            auto it = fds_.find(fd);
+            if (it == fds_.end()) continue;
+            auto& st = it->second;
+            uint32_t ev = events_[i].events;
+
+            if ((ev & (EPOLLIN | EPOLLERR | EPOLLHUP)) && !st.readers.empty()) {
+                auto* req = st.readers.front();
+                int res = perform(*req);
+                if (res != -EAGAIN) { st.readers.pop_front(); complete(req, res); ++count; }
+            }
+            if ((ev & (EPOLLOUT | EPOLLERR | EPOLLHUP)) && !st.writers.empty()) {
+                auto* req = st.writers.front();
+                int res = perform(*req);
+                if (res != -EAGAIN) { st.writers.pop_front(); complete(req, res); ++count; }
+            }
+
+            if (st.readers.empty() && st.writers.empty()) {
+                ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+                fds_.erase(it);
+            } else {
+                updateInterest(fd, st);
+            }
+        }
+        return count + drainBlocking() + drainInline();
+    }
+
+    void wakeup() override {
+        uint64_t one = 1;
+        if (wake_fd_ >= 0) (void)::write(wake_fd_, &one, sizeof(one));
+    }
+
+    const char* name() const noexcept override { return "epoll"; }
+
+private:
+    struct FdState {
+        bool registered = false;
+        std::deque<IoRequest*> readers;   // Read, Accept
+        std::deque<IoRequest*> writers;   // Write
+    };
+
+    // blocking helper thread 하나 - 배정된 fd 의 요청을 순서대로 수행
+    struct Lane {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<IoRequest*> queue;
+        bool stop = false;
+        std::thread thread;
+    };
+
+    bool updateInterest(int fd, FdState& st) {
+        epoll_event ev{};
+        ev.events = (st.readers.empty() ? 0u : static_cast<uint32_t>(EPOLLIN))
+                  | (st.writers.empty() ? 0u : static_cast<uint32_t>(EPOLLOUT));
+        ev.data.fd = fd;
+        int rc = ::epoll_ctl(epoll_fd_, st.registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &ev);
+        if (rc == 0) st.registered = true;
+        return rc == 0;
+    }
+
+    // reactor 스레드에서 호출 - helper 는 첫 파일 요청에서 생성
+    void postBlocking(IoRequest* req) {
+        if (lanes_.empty() && blocking_threads_ > 0) startLanes();
+        if (lanes_.empty()) {
+            inline_done_.push_back({req, perform(*req)});
+            return;
+        }
+        auto& lane = *lanes_[static_cast<unsigned>(req->fd) % lanes_.size()];
+        {
+            std::lock_guard<std::mutex> lock(lane.mutex);
+            lane.queue.push_back(req);
+        }
+        lane.cv.notify_one();
+    }
+
+    void startLanes() {
+        try {
+            for (unsigned i = 0; i < blocking_threads_; ++i) {
+                auto lane = std::make_unique<Lane>();
+                lane->thread = std::thread([this, l = lane.get()] { runLane(*l); });
+                lanes_.push_back(std::move(lane));
+            }
+        } catch (const std::system_error& e) {
+            LOGW("epoll backend: blocking helper start failed ({}), file I/O on reactor thread", e.what());
+            if (lanes_.empty()) blocking_threads_ = 0;
+        }
+    }
+
+    void runLane(Lane& lane) {
+        for (;;) {
+            IoRequest* req = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(lane.mutex);
+                lane.cv.wait(lock, [&] { return lane.stop || !lane.queue.empty(); });
+                if (lane.stop) return;
+                req = lane.queue.front();
+                lane.queue.pop_front();
+            }
+            int res = perform(*req);
+            {
+                std::lock_guard<std::mutex> lock(blocking_mutex_);
+                blocking_done_.push_back({req, res});
+            }
+            wakeup();
+        }
+    }
+
+    int drainBlocking() {
+        std::vector<std::pair<IoRequest*, int>> done;
+        {
+            std::lock_guard<std::mutex> lock(blocking_mutex_);
+            done.swap(blocking_done_);
+        }
+        for (auto& [req, res] : done) complete(req, res);
+        return static_cast<int>(done.size());
+    }
+
+    int drainInline() {
+        int count = 0;
+        auto done = std::move(inline_done_);
+        inline_done_.clear();
+        for (auto& [req, res] : done) { complete(req, res); ++count; }
+        return count;
+    }
+
+    static int perform(const IoRequest& req) {
+        ssize_t rc = -1;
+        switch (req.op) {
+            case IoOp::Read:
+                rc = req.offset >= 0 ? ::pread(req.fd, req.buf, req.len, req.offset)
+                                     : ::read(req.fd, req.buf, req.len);
+                break;
+            case IoOp::Write:
+                rc = req.offset >= 0 ? ::pwrite(req.fd, req.buf, req.len, req.offset)
+                                     : ::write(req.fd, req.buf, req.len);
+                break;
+            case IoOp::Accept:
+                rc = ::accept4(req.fd, nullptr, nullptr, SOCK_CLOEXEC);
+                break;
+            case IoOp::Fsync:
+                rc = ::fsync(req.fd);
+                break;
+        }
+        if (rc < 0) return errno == EWOULDBLOCK ? -EAGAIN : -errno;
+        return static_cast<int>(rc);
+    }
+
+    static void complete(IoRequest* raw, int res) {
+        std::unique_ptr<IoRequest> req(raw);
+        if (req->on_complete) req->on_complete(ioResult(res));
+    }
+
+    static constexpr const char* LOG_TAG = "IoReactor";
+
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    std::vector<epoll_event> events_;
+    std::unordered_map<int, FdState> fds_;
+    std::vector<std::pair<IoRequest*, int>> inline_done_;   // blocking_threads == 0 (reactor 스레드에서 수행)
+
+    unsigned blocking_threads_;
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    std::mutex blocking_mutex_;
+    std::vector<std::pair<IoRequest*, int>> blocking_done_;
+};
+
+
+// ------------------------------------------------------
+// IoReactor - core 하나에 고정된 ring, 제출은 batch 로 모아 한 번에 enter
+// ------------------------------------------------------
+struct IoReactorDescriptor {
+    int core = -1;                              // -1: affinity 미지정
+    unsigned entries = 256;
+    IoBackendType backend = IoBackendType::Auto;
+    unsigned blocking_threads = 2;              // epoll fallback 의 일반 파일 / fsync 용 thread (0: reactor 스레드에서 수행)
+};
+
+class IoReactor : public Worker {
+public:
+    explicit IoReactor(const IoReactorDescriptor& desc) : desc_(desc) {
+        WorkerDescriptor wd;
+        wd.name = desc.core >= 0 ? fmt::format("IoReactor{}", desc.core) : "IoReactor";
+        wd.type = WorkerType::Single;
+        if (desc.core >= 0) wd.affinity = {desc.core};
+
+        auto r = Worker::init(wd);
+        if (!r) {
+            LOGE("IoReactor init failed: {}", to_string(r));
+        }
+    }
+
+    ~IoReactor() override {
+        stop();
+    }
+
+    Result<void> submit(IoRequest req) {
+        if (!req.on_complete) return Error(ResultCode::InvalidArgument, "IoRequest requires on_complete");
+        if (req.fd < 0) return Error(ResultCode::InvalidArgument, "Invalid fd");
+
+        bool was_empty = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!backend_) return Error(ResultCode::InvalidState, "IoReactor not started");
+            was_empty = pending_.empty();
+            pending_.push_back(std::make_unique<IoRequest>(std::move(req)));
+            if (was_empty) backend_->wakeup();
+        }
+        stats_.submitted++;
+        return OK();
+    }
+
+    const char* backendName() const noexcept {
+        return backend_ ? backend_->name() : "none";
+    }
+
+    const IoReactorStats& stats() const noexcept { return stats_; }
+
+protected:
+    static constexpr const char* LOG_TAG = "IoReactor";
+
+    Result<void> run() override {
+        std::vector<std::unique_ptr<IoRequest>> batch;
+        while (!isStopRequested()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                batch.swap(pending_);
+            }
+            if (!batch.empty()) {
+                stats_.batches++;
+                auto r = backend_->submit(batch);
+                if (!r) {
+                    LOGW("IoReactor: submit failed: {}", to_string(r));
+                    for (auto& req : batch) {
+                        stats_.failed++;
+                        if (req->on_complete) req->on_complete(Result<size_t>::Error(r.code(), r.error()));
+                    }
+                    batch.clear();
+                }
+            }
+
+            bool has_more = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                has_more = !pending_.empty();
+            }
+            stats_.completed += backend_->reap(has_more ? 0 : -1);
+        }
+        return OK();
+    }
+
+    Result<void> onPreStart() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        backend_ = createBackend();
+        if (!backend_) return Error(ResultCode::NotSupported, "no I/O backend available");
+        LOGI("IoReactor core={} backend={}", desc_.core, backend_->name());
+        return OK();
+    }
+
+    void onPreStop() override {
+        if (backend_) backend_->wakeup();
+    }
+
+    // 완료 콜백이 submit() 을 다시 호출할 수 있으므로 lock 밖에서 취소 / backend 해제
+    void onPostStop() override {
+        std::vector<std::unique_ptr<IoRequest>> pending;
+        std::unique_ptr<IoBackend> backend;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending.swap(pending_);
+            backend.swap(backend_);
+        }
+        for (auto& req : pending) {
+            if (req->on_complete) req->on_complete(Result<size_t>::Error(ResultCode::Cancelled, "IoReactor stopped"));
+        }
+        backend.reset();
+    }
+
+private:
+    std::unique_ptr<IoBackend> createBackend() {
+#if TASK_HAS_IO_URING
+        if (desc_.backend != IoBackendType::Epoll) {
+            auto uring = std::make_unique<UringBackend>();
+            auto r = uring->init(desc_.entries);
+            if (r) return uring;
+            LOGW("io_uring unavailable ({}), fallback to epoll", to_string(r));
+            if (desc_.backend == IoBackendType::Uring) return nullptr;
+        }
+#endif
+        auto epoll = std::make_unique<EpollBackend>(desc_.blocking_threads);
+        auto r = epoll->init(desc_.entries);
+        if (!r) {
+            LOGE("epoll backend init failed: {}", to_string(r));
+            return nullptr;
+        }
+        return epoll;
+    }
+
+    IoReactorDescriptor desc_;
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<IoRequest>> pending_;
+    std::unique_ptr<IoBackend> backend_;
+
+    IoReactorStats stats_;
+};
+
+} // namespace task
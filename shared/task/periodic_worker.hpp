@@ -0,0 +1,53 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "result.h"
+#include "logging.hpp"
+#include "worker.hpp"
+
+// NOTE
+// PeriodicWorker ticker("Flush", [&] { batcher.flushExpired(send); }, 1);
+// ticker.start();
+// ...
+// ticker.stop();                       // 소멸자에서도 정지
+
+namespace task {
+
+// ------------------------------------------------------
+// PeriodicWorker - fn 을 period_ms 마다 호출하는 Loop worker
+//  fn 이 오래 걸리면 그만큼 다음 호출이 밀림 (고정 간격 sleep)
+// ------------------------------------------------------
+class PeriodicWorker : public Worker {
+public:
+    PeriodicWorker(std::string name, std::function<void()> fn, int period_ms) : fn_(std::move(fn)) {
+        WorkerDescriptor wd;
+        wd.name = std::move(name);
+        wd.type = WorkerType::Loop;
+        wd.loop_sleep_ms = std::max(1, period_ms);
+
+        auto r = Worker::init(wd);
+        if (!r) {
+            LOGE("periodic worker init failed: {}", to_string(r));
+        }
+    }
+
+    ~PeriodicWorker() override {
+        stop();
+    }
+
+protected:
+    static constexpr const char* LOG_TAG = "PeriodicWorker";
+
+    Result<void> run() override {
+        fn_();
+        return OK();
+    }
+
+private:
+    std::function<void()> fn_;
+};
+
+} // namespace task
@@ -0,0 +1,463 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "result.h"
+#include "logging.hpp"
+#include "worker.hpp"
+#include "channel.hpp"
+#include "futex.hpp"
+
+// NOTE
+// PipelineDescriptor pd;
+// pd.name     = "media";
+// pd.affinity = subsystem_info.affinity;          // manifest affinity: [2,3]
+//
+// auto pipeline = Pipeline<Frame>::builder(pd)
+//     .stage<Tensor>({"decode", 2}, [](Frame f) { return decode(f); })
+//     .stage<Result>({"infer", 1, {}, 8}, [](Tensor t) { return infer(t); })
+//     .sink({"publish"}, [](Result r) { publish(r); });
+// pipeline->start();
+// pipeline->push(frame);
+
+namespace task {
+
+// ------------------------------------------------------
+// stage 설정
+// ------------------------------------------------------
+struct StageDescriptor {
+    std::string name;
+    size_t parallelism = 1;             // stage 당 worker 수
+    std::vector<int> affinity;          // 비어있으면 pipeline affinity 에서 자동 배치
+    size_t batch_size = 1;              // 한 번에 꺼내 처리할 최대 개수
+    size_t queue_capacity = 256;        // worker 별 입력 channel 크기
+    int policy = 0;
+    int priority = 0;
+};
+
+struct PipelineDescriptor {
+    std::string name = "Pipeline";
+    std::vector<int> affinity;          // 보통 manifest 의 subsystem affinity
+    int send_timeout_ms = -1;           // backpressure 대기 시간 (-1: 무한)
+};
+
+// ------------------------------------------------------
+// 통계 정보
+// ------------------------------------------------------
+struct StageStats {
+    std::atomic<size_t> processed{0};
+    std::atomic<size_t> batches{0};
+    std::atomic<size_t> failed{0};
+    std::atomic<size_t> backpressure{0};     // 하위 stage 가 가득 차 대기한 횟수
+    std::atomic<size_t> dropped{0};          // 대기 시간 초과로 버린 개수
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+};
+
+struct StageStatsSnapshot {
+    std::string name;
+    size_t parallelism = 0;
+    size_t processed = 0;
+    size_t batches = 0;
+    size_t failed = 0;
+    size_t backpressure = 0;
+    size_t dropped = 0;
+    size_t queue_depth = 0;
+    double throughput = 0.0;            // items / sec (start 이후)
+    double avg_latency_us = 0.0;
+    double max_latency_us = 0.0;
+};
+
+namespace detail {
+
+class StageBase {
+public:
+    virtual ~StageBase() = default;
+    virtual Result<void> start() = 0;
+    virtual void closeInput() = 0;
+    virtual void join() = 0;            // 입력 소진 후 worker 종료 대기
+    virtual StageStatsSnapshot snapshot() const = 0;
+};
+
+template<typename In>
+class StageInput : public StageBase {
+public:
+    virtual Result<void> push(In value, int timeout_ms) = 0;
+    virtual bool tryPush(In value) = 0;
+};
+
+template<typename Out>
+class StageOutput {
+public:
+    virtual ~StageOutput() = default;
+    virtual void connect(StageInput<Out>* next, int send_timeout_ms) = 0;
+};
+
+// sink stage (Out = void) 의 출력 자리 - connect 는 호출되지 않음
+struct NoOutput { };
+
+// ------------------------------------------------------
+// FunctionStage - replica 별 MPSC 입력 channel + Worker
+// ------------------------------------------------------
+template<typename In, typename Out>
+class FunctionStage : public StageInput<In>,
+                      public StageOutput<std::conditional_t<std::is_void_v<Out>, NoOutput, Out>> {
+public:
+    using Func = std::function<Out(In)>;
+    using Next = std::conditional_t<std::is_void_v<Out>, NoOutput, Out>;
+
+    FunctionStage(const StageDescriptor& desc, Func fn, std::vector<int> replica_cores)
+        : desc_(desc), fn_(std::move(fn)) {
+        size_t count = desc.parallelism ? desc.parallelism : 1;
+        for (size_t i = 0; i < count; ++i) {
+            std::vector<int> affinity = desc.affinity;
+            if (affinity.empty() && i < replica_cores.size() && replica_cores[i] >= 0)
+                affinity = {replica_cores[i]};
+            replicas_.push_back(std::make_unique<Replica>(*this, i, affinity));
+        }
+    }
+
+    ~FunctionStage() override {
+        closeInput();
+        for (auto& r : replicas_) r->stop();
+    }
+
+    void connect(StageInput<Next>* next, int send_timeout_ms) override {
+        next_ = next;
+        send_timeout_ms_ = send_timeout_ms;
+    }
+
+    // 실패 시 앞서 시작한 replica 는 그대로 - closeInput() + join() 으로 정리
+    Result<void> start() override {
+        started_ns_.store(nowNs(), std::memory_order_relaxed);
+        for (auto& r : replicas_) {
+            auto res = r->start();
+            if (!res) return res;
+            r->started.store(true, std::memory_order_release);
+        }
+        return OK();
+    }
+
+    // 비어 있는 replica 우선, 모두 가득 차면 다음 replica 에서 대기 (backpressure)
+    Result<void> push(In value, int timeout_ms) override {
+        size_t n = replicas_.size();
+        size_t start = next_replica_.fetch_add(1, std::memory_order_relaxed);
+        for (size_t i = 0; i < n; ++i) {
+            if (replicas_[(start + i) % n]->input.trySend(std::move(value))) return OK();
+        }
+        stats_.backpressure++;
+        return replicas_[start % n]->input.send(std::move(value), timeout_ms);
+    }
+
+    bool tryPush(In value) override {
+        size_t n = replicas_.size();
+        size_t start = next_replica_.fetch_add(1, std::memory_order_relaxed);
+        for (size_t i = 0; i < n; ++i) {
+            if (replicas_[(start + i) % n]->input.trySend(std::move(value))) return true;
+        }
+        return false;
+    }
+
+    void closeInput() override {
+        for (auto& r : replicas_) r->input.close();
+    }
+
+    // 시작하지 않은 replica 는 done 이 설정되지 않으므로 기다리지 않음
+    void join() override {
+        for (auto& r : replicas_) {
+            if (r->started.load(std::memory_order_acquire))
+                futexWaitUntil(r->done, [](uint32_t v) { return v != 0; });
+            r->stop();
+        }
+    }
+
+    StageStatsSnapshot snapshot() const override {
+        StageStatsSnapshot s;
+        s.name         = desc_.name;
+        s.parallelism  = replicas_.size();
+        s.processed    = stats_.processed.load(std::memory_order_relaxed);
+        s.batches      = stats_.batches.load(std::memory_order_relaxed);
+        s.failed       = stats_.failed.load(std::memory_order_relaxed);
+        s.backpressure = stats_.backpressure.load(std::memory_order_relaxed);
+        s.dropped      = stats_.dropped.load(std::memory_order_relaxed);
+        for (auto& r : replicas_) s.queue_depth += r->input.size();
+
+        double elapsed = (nowNs() - started_ns_.load(std::memory_order_relaxed)) / 1e9;
+        if (elapsed > 0) s.throughput = s.processed / elapsed;
+        if (s.processed) s.avg_latency_us = stats_.total_ns.load(std::memory_order_relaxed) / 1000.0 / s.processed;
+        s.max_latency_us = stats_.max_ns.load(std::memory_order_relaxed) / 1000.0;
+        return s;
+    }
+
+protected:
+    static constexpr const char* LOG_TAG = "PipelineStage";
+
+private:
+    class Replica : public Worker {
+    public:
+        Replica(FunctionStage& stage, size_t index, const std::vector<int>& affinity)
+            : input(stage.desc_.queue_capacity), stage_(stage) {
+            WorkerDescriptor wd;
+            wd.name     = fmt::format("{}#{}", stage.desc_.name, index);
+            wd.type     = WorkerType::Event;         // input send / close 시 event()
+            wd.affinity = affinity;
+            wd.policy   = stage.desc_.policy;
+            wd.priority = stage.desc_.priority;
+
+            auto r = Worker::init(wd);
+            if (!r) {
+                LOGE("Stage worker init failed: {}", to_string(r));
+            }
+            input.bindWorker(this);
+        }
+
+        ~Replica() override {
+            input.close();
+            stop();
+        }
+
+        MpscChannel<In> input;
+        std::atomic<bool> started{false};
+        std::atomic<uint32_t> done{0};
+
+    protected:
+        // event 마다 쌓인 입력을 batch 단위로 모두 처리 - 비면 다음 event 까지 대기 (polling 없음)
+        Result<void> run() override {
+            const size_t batch_size = stage_.desc_.batch_size ? stage_.desc_.batch_size : 1;
+            batch_.reserve(batch_size);
+
+            while (!isStopRequested() && drainBatch(batch_size)) { }
+
+            // closed & empty - close 직전에 들어온 항목까지 처리 후 완료 표시
+            if (input.isClosed() && !done.load(std::memory_order_relaxed)) {
+                while (drainBatch(batch_size)) { }
+                done.store(1, std::memory_order_release);
+                futexWake(done);
+            }
+            return OK();
+        }
+
+        static constexpr const char* LOG_TAG = "PipelineStage";
+
+    private:
+        bool drainBatch(size_t batch_size) {
+            batch_.clear();
+            if (!input.drain(batch_, batch_size)) return false;
+            for (auto& item : batch_) stage_.process(std::move(item));
+            stage_.stats_.batches++;
+            return true;
+        }
+
+        FunctionStage& stage_;
+        std::vector<In> batch_;
+    };
+
+    // latency 는 stage 함수 수행 시간 (하위 stage 대기 시간 제외)
+    void process(In&& item) {
+        auto t0 = std::chrono::steady_clock::now();
+        try {
+            if constexpr (std::is_void_v<Out>) {
+                fn_(std::move(item));
+                record(t0);
+            } else {
+                Out out = fn_(std::move(item));
+                record(t0);
+                if (next_) {
+                    auto r = next_->push(std::move(out), send_timeout_ms_);
+                    if (!r) stats_.dropped++;
+                }
+            }
+        } catch (const std::exception& e) {
+            stats_.failed++;
+            LOGW("stage[{}] exception: {}", desc_.name, e.what());
+        } catch (...) {
+            stats_.failed++;
+            LOGW("stage[{}] unknown exception occurred", desc_.name);
+        }
+    }
+
+    void record(std::chrono::steady_clock::time_point t0) {
+        auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count());
+
+        stats_.processed++;
+        stats_.total_ns += ns;
+        uint64_t max = stats_.max_ns.load(std::memory_order_relaxed);
+        while (ns > max && !stats_.max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) { }
+    }
+
+    StageDescriptor desc_;
+    Func fn_;
+    std::vector<std::unique_ptr<Replica>> replicas_;
+    std::atomic<size_t> next_replica_{0};
+
+    StageInput<Next>* next_ = nullptr;
+    int send_timeout_ms_ = -1;
+
+    static int64_t nowNs() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    StageStats stats_;
+    std::atomic<int64_t> started_ns_{nowNs()};      // snapshot() 은 다른 thread 에서 호출
+};
+
+struct PipelineState {
+    PipelineDescriptor desc;
+    std::vector<std::unique_ptr<StageBase>> stages;
+    size_t next_core = 0;
+
+    // stage affinity 미지정 시 pipeline affinity core 를 replica 단위로 순환 배치
+    std::vector<int> placeReplicas(const StageDescriptor& sd) {
+        std::vector<int> cores;
+        if (!sd.affinity.empty() || desc.affinity.empty()) return cores;
+        size_t count = sd.parallelism ? sd.parallelism : 1;
+        for (size_t i = 0; i < count; ++i)
+            cores.push_back(desc.affinity[next_core++ % desc.affinity.size()]);
+        return cores;
+    }
+};
+
+} // namespace detail
+
+
+template<typename In, typename Cur>
+class PipelineBuilder;
+
+// ------------------------------------------------------
+// Pipeline - 입력 타입 In 을 받는 다단계 stage 묶음
+// ------------------------------------------------------
+template<typename In>
+class Pipeline {
+public:
+    static PipelineBuilder<In, In> builder(const PipelineDescriptor& desc) {
+        auto state = std::make_unique<detail::PipelineState>();
+        state->desc = desc;
+        return PipelineBuilder<In, In>(std::move(state), nullptr, nullptr);
+    }
+
+    ~Pipeline() { stop(); }
+
+    Result<void> start() {
+        if (!entry_) return Error(ResultCode::InvalidState, "empty pipeline");
+        // 하위 stage 부터 시작해 상위 출력이 바로 소비되도록 함
+        for (auto it = state_->stages.rbegin(); it != state_->stages.rend(); ++it) {
+            auto r = (*it)->start();
+            if (!r) {
+                // 일부만 시작된 상태 - 시작한 replica 만 정리
+                LOG_ERROR(LOG_TAG, "pipeline[{}] start failed: {}", state_->desc.name, to_string(r));
+                shutdown();
+                return r;
+            }
+        }
+        running_.store(true, std::memory_order_release);
+        LOG_INFO(LOG_TAG, "pipeline[{}] started: stages={}", state_->desc.name, state_->stages.size());
+        return OK();
+    }
+
+    Result<void> push(In value) {
+        if (!running_.load(std::memory_order_acquire)) return Error(ResultCode::InvalidState, "pipeline not running");
+        return entry_->push(std::move(value), state_->desc.send_timeout_ms);
+    }
+
+    bool tryPush(In value) {
+        if (!running_.load(std::memory_order_acquire)) return false;
+        return entry_->tryPush(std::move(value));
+    }
+
+    // 입력을 닫고 상위 stage 부터 남은 항목을 모두 처리한 뒤 정지
+    Result<void> stop() {
+        if (!running_.exchange(false)) return OK();
+        shutdown();
+        LOG_INFO(LOG_TAG, "pipeline[{}] stopped", state_->desc.name);
+        return OK();
+    }
+
+    std::vector<StageStatsSnapshot> stats() const {
+        std::vector<StageStatsSnapshot> out;
+        for (auto& stage : state_->stages) out.push_back(stage->snapshot());
+        return out;
+    }
+
+private:
+    template<typename, typename> friend class PipelineBuilder;
+
+    Pipeline(std::unique_ptr<detail::PipelineState> state, detail::StageInput<In>* entry)
+        : state_(std::move(state)), entry_(entry) { }
+
+    static constexpr const char* LOG_TAG = "Pipeline";
+
+    void shutdown() {
+        for (auto& stage : state_->stages) {
+            stage->closeInput();
+            stage->join();
+        }
+    }
+
+    std::unique_ptr<detail::PipelineState> state_;
+    detail::StageInput<In>* entry_ = nullptr;
+    std::atomic<bool> running_{false};
+};
+
+
+// ------------------------------------------------------
+// PipelineBuilder - Cur 는 현재 마지막 stage 의 출력 타입
+// ------------------------------------------------------
+template<typename In, typename Cur>
+class PipelineBuilder {
+public:
+    template<typename Out, typename F>
+    PipelineBuilder<In, Out> stage(const StageDescriptor& desc, F fn) {
+        auto cores = state_->placeReplicas(desc);
+        auto stage = std::make_unique<detail::FunctionStage<Cur, Out>>(
+            desc, std::function<Out(Cur)>(std::move(fn)), cores);
+        auto* raw = stage.get();
+        attach(raw);
+        state_->stages.push_back(std::move(stage));
+        return PipelineBuilder<In, Out>(std::move(state_), entryFor(raw), raw);
+    }
+
+    template<typename F>
+    std::unique_ptr<Pipeline<In>> sink(const StageDescriptor& desc, F fn) {
+        auto cores = state_->placeReplicas(desc);
+        auto stage = std::make_unique<detail::FunctionStage<Cur, void>>(
+            desc, std::function<void(Cur)>(std::move(fn)), cores);
+        auto* raw = stage.get();
+        attach(raw);
+        state_->stages.push_back(std::move(stage));
+        auto* entry = entryFor(raw);
+        return std::unique_ptr<Pipeline<In>>(new Pipeline<In>(std::move(state_), entry));
+    }
+
+private:
+    template<typename, typename> friend class PipelineBuilder;
+    template<typename> friend class Pipeline;
+
+    PipelineBuilder(std::unique_ptr<detail::PipelineState> state,
+                    detail::StageInput<In>* entry,
+                    detail::StageOutput<Cur>* tail)
+        : state_(std::move(state)), entry_(entry), tail_(tail) { }
+
+    void attach(detail::StageInput<Cur>* next) {
+        if (tail_) tail_->connect(next, state_->desc.send_timeout_ms);
+    }
+
+    template<typename Stage>
+    detail::StageInput<In>* entryFor(Stage* first) {
+        if (entry_) return entry_;
+        if constexpr (std::is_same_v<Cur, In>) return first;
+        else return nullptr;
+    }
+
+    std::unique_ptr<detail::PipelineState> state_;
+    detail::StageInput<In>* entry_ = nullptr;
+    detail::StageOutput<Cur>* tail_ = nullptr;
+};
+
+} // namespace task
@@ -0,0 +1,279 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "result.h"
+#include "logging.hpp"
+#include "thread_pool.hpp"
+
+// NOTE
+// ThreadPool pool({4});
+// pool.start();
+//
+// SerialExecutor serial(pool, {"Sub", 16});
+// serial.post(std::hash<std::string>{}("event.a"), [] { ... });   // 같은 key 는 post 순서대로 실행
+// serial.post(std::hash<std::string>{}("event.b"), [] { ... });   // 다른 key 는 다른 thread 에서 병렬 실행 가능
+// ...
+// serial.close();                                                   // pool 보다 먼저 정리
+
+namespace task {
+
+struct SerialExecutorDescriptor {
+    std::string name = "Serial";
+    size_t shards = 16;                 // key % shards 로 배정, shard 안에서만 순서 보장
+    size_t max_depth = 1024;            // shard 당 대기 작업 상한 (0 = 무제한)
+    size_t drain_batch = 32;            // pool thread 하나에서 연속 실행할 최대 작업 수
+    int priority = 0;                   // ThreadPool::submit priority
+};
+
+// ------------------------------------------------------
+// 통계 정보
+// ------------------------------------------------------
+struct SerialExecutorStats {
+    std::atomic<size_t> posted{0};
+    std::atomic<size_t> executed{0};
+    std::atomic<size_t> rejected{0};        // shard 가득 참 / pool 제출 실패 / close 이후
+    std::atomic<size_t> discarded{0};       // close 시 실행되지 않고 버려진 작업
+    std::atomic<size_t> rescheduled{0};     // drain 이 진행되지 않아 다시 제출한 횟수
+};
+
+
+// ------------------------------------------------------
+// SerialExecutor - key 별 직렬 실행을 ThreadPool 위에서 제공
+//  - shard 마다 queue 하나, queue 가 비어 있지 않은 동안 drain task 하나만 pool 에 존재
+//  - drain 은 drain_batch 개를 실행하고 pool 에 대기 task 가 있으면 다시 제출 (다른 shard 에 thread 양보)
+//  - ThreadPool 은 queue 가 가득 차면 제출된 task 를 버릴 수 있으므로
+//    drain 이 STALL_MS 이상 진행되지 않으면 다음 post 에서 다시 제출 (실행은 run_mutex 로 하나만)
+// ------------------------------------------------------
+class SerialExecutor {
+public:
+    using Fn = std::function<void()>;
+
+    static constexpr int64_t STALL_MS = 1000;
+
+    SerialExecutor(ThreadPool& pool, SerialExecutorDescriptor desc = {})
+        : state_(std::make_shared<State>(pool, std::move(desc))) { }
+
+    ~SerialExecutor() {
+        close();
+    }
+
+    SerialExecutor(const SerialExecutor&)            = delete;
+    SerialExecutor& operator=(const SerialExecutor&) = delete;
+
+    // return: ResourceBusy (shard 가득 참 / pool 제출 실패), InvalidState (close 이후)
+    Result<void> post(uint64_t key, Fn fn) {
+        auto& s = *state_;
+        if (s.closed.load(std::memory_order_acquire)) {
+            s.stats.rejected++;
+            return Error(ResultCode::InvalidState, "serial executor closed");
+        }
+
+        size_t index = key % s.shards.size();
+        auto& shard = *s.shards[index];
+        uint64_t seq = 0;
+        bool first = false, stalled = false;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (s.desc.max_depth && shard.queue.size() >= s.desc.max_depth) {
+                s.stats.rejected++;
+                return Error(ResultCode::ResourceBusy, "serial shard queue full");
+            }
+            seq = ++shard.next_seq;
+            shard.queue.push_back({seq, std::move(fn)});
+
+            auto now = Clock::now();
+            first   = !shard.scheduled;
+            // 실행 중인 drain 이 느린 경우에도 들어오지만 run_mutex 로 하나만 실행됨
+            stalled = !first && now - shard.progress > std::chrono::milliseconds(STALL_MS);
+            if (first || stalled) {
+                shard.scheduled = true;
+                shard.progress  = now;
+            }
+        }
+        s.stats.posted++;
+        if (stalled) s.stats.rescheduled++;
+
+        if ((first || stalled) && !submit(state_, index) && first) {
+            // 다시 제출 실패는 기존 drain 에 맡기고, 처음 제출 실패는 방금 넣은 작업을 되돌림
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = std::find_if(shard.queue.begin(), shard.queue.end(),
+                                   [seq](const Item& item) { return item.seq == seq; });
+            if (it != shard.queue.end()) {
+                shard.queue.erase(it);
+                if (shard.queue.empty() && !shard.running) shard.scheduled = false;
+                else shard.progress = {};           // 남은 작업은 다음 post 에서 바로 다시 제출
+                s.stats.posted--;
+                s.stats.rejected++;
+                return Error(ResultCode::ResourceBusy, "thread pool rejected serial drain");
+            }
+        }
+        return OK();
+    }
+
+    // 대기 중인 작업을 버리고 실행 중인 drain 이 끝날 때까지 대기
+    // 작업 안에서 호출하면 대기하지 않음
+    void close() {
+        auto& s = *state_;
+        if (s.closed.exchange(true, std::memory_order_acq_rel)) return;
+
+        for (auto& shard : s.shards) {
+            std::deque<Item> dropped;
+            {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                dropped.swap(shard->queue);
+                shard->scheduled = false;
+            }
+            s.stats.discarded += dropped.size();
+        }
+
+        if (current() == &s) return;
+        std::unique_lock<std::mutex> lock(s.idle_mutex);
+        s.idle_cv.wait(lock, [&] { return s.active == 0; });
+    }
+
+    size_t pending() const {
+        size_t n = 0;
+        for (auto& shard : state_->shards) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            n += shard->queue.size();
+        }
+        return n;
+    }
+
+    size_t shardCount() const noexcept { return state_->shards.size(); }
+    const SerialExecutorStats& stats() const noexcept { return state_->stats; }
+
+protected:
+    static constexpr const char* LOG_TAG = "SerialExecutor";
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Item {
+        uint64_t seq;
+        Fn fn;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::deque<Item> queue;
+        uint64_t next_seq = 0;
+        bool scheduled = false;             // drain task 가 pool 에 있거나 실행 중
+        bool running   = false;
+        Clock::time_point progress;         // 마지막 제출 / 작업 완료 시각
+        std::mutex run_mutex;               // 같은 shard 의 drain 은 하나만 실행
+    };
+
+    // drain task 가 executor 보다 늦게 실행될 수 있으므로 shared_ptr 로 공유
+    struct State {
+        State(ThreadPool& p, SerialExecutorDescriptor d) : pool(p), desc(std::move(d)) {
+            size_t count = desc.shards ? desc.shards : 1;
+            shards.reserve(count);
+            for (size_t i = 0; i < count; ++i) shards.push_back(std::make_unique<Shard>());
+            if (!desc.drain_batch) desc.drain_batch = 1;
+        }
+
+        ThreadPool& pool;
+        SerialExecutorDescriptor desc;
+        std::vector<std::unique_ptr<Shard>> shards;
+        std::atomic<bool> closed{false};
+        SerialExecutorStats stats;
+
+        std::mutex idle_mutex;
+        std::condition_variable idle_cv;
+        size_t active = 0;                  // 실행 중인 drain 수
+    };
+
+    static const State*& current() {
+        static thread_local const State* state = nullptr;
+        return state;
+    }
+
+    static bool submit(const std::shared_ptr<State>& state, size_t index) {
+        TaskDescriptor<void> td;
+        td.name     = state->desc.name;
+        td.dispatch = TaskDispatchPolicy::Immediate;
+        td.throttle_time_ms = 0;
+        td.func     = [state, index]() -> Result<void> {
+            drain(state, index);
+            return OK();
+        };
+        return static_cast<bool>(state->pool.submit(td, state->desc.priority));
+    }
+
+    static void drain(const std::shared_ptr<State>& state, size_t index) {
+        auto& s = *state;
+        auto& shard = *s.shards[index];
+
+        std::unique_lock<std::mutex> run(shard.run_mutex, std::try_to_lock);
+        if (!run.owns_lock()) return;       // 다시 제출된 drain - 이미 실행 중인 쪽이 처리
+
+        {
+            std::lock_guard<std::mutex> lock(s.idle_mutex);
+            if (s.closed.load(std::memory_order_acquire)) return;
+            ++s.active;
+        }
+        const State* prev = current();
+        current() = &s;
+
+        for (;;) {
+            bool idle = false;
+            for (size_t done = 0; done < s.desc.drain_batch && !idle; ++done) {
+                Fn fn;
+                {
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    if (shard.queue.empty() || s.closed.load(std::memory_order_acquire)) {
+                        shard.scheduled = false;
+                        shard.running   = false;
+                        idle = true;
+                        continue;
+                    }
+                    fn = std::move(shard.queue.front().fn);
+                    shard.queue.pop_front();
+                    shard.running = true;
+                }
+
+                try {
+                    fn();
+                } catch (const std::exception& e) {
+                    LOG_ERROR(LOG_TAG, "{} task exception: {}", s.desc.name, e.what());
+                } catch (...) {
+                    LOG_ERROR(LOG_TAG, "{} task unknown exception", s.desc.name);
+                }
+                s.stats.executed++;
+
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.progress = Clock::now();
+            }
+            if (idle) break;
+
+            // batch 소진 - 기다리는 task 가 있으면 pool 에 다시 제출 (실패하면 이 thread 에서 계속 진행)
+            if (s.pool.queued() == 0) continue;
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.running = false;
+            }
+            run.unlock();
+            if (submit(state, index)) break;
+            run.lock();
+        }
+
+        current() = prev;
+        std::lock_guard<std::mutex> lock(s.idle_mutex);
+        if (--s.active == 0) s.idle_cv.notify_all();
+    }
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace task
@@ -22,6 +22,7 @@ enum class TaskExcutionMode
     Sync,
     Async,
     Thread,
+    Fiber,
 };
 
 enum class TaskDispatchPolicy
@@ -103,7 +104,7 @@ public:
     virtual bool isIdle() const = 0;
 
     virtual Result<void> setAffinity(const std::vector<int>& cores) = 0;
-    virtual std::vector<int> getAffinity() const;
+    virtual std::vector<int> getAffinity() const { return {}; }
 
     virtual std::size_t id() const = 0;
     virtual int getPolicy() const = 0;
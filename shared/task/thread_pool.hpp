@@ -1,5 +1,6 @@
 #pragma once
 #include <queue>
+#include <set>
 #include <unordered_map>
 #include <condition_variable>
 #include <atomic>
@@ -44,7 +45,7 @@ public:
 
         auto r = Worker::init(wd);
         if (!r) {
-            LOGE("ThreadPool init failed: {}", r.error());
+            LOGE("ThreadPool init failed: {}", to_string(r));
         }
     }
 
@@ -75,6 +76,12 @@ public:
         return OK();
     }
 
+    // 아직 thread 에 배정되지 않은 task 수
+    size_t queued() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tasks_.size();
+    }
+
 protected:
     Result<void> run() override {
         constexpr int MAX_RETRY = 3;
@@ -198,7 +205,7 @@ protected:
                 auto set_res = thread_unit->setAffinity({core});
                 if (!set_res) {
                     LOGW("Failed to set affinity for thread core{}({}) msg={}",
-                         core, i, set_res.error());
+                         core, i, to_string(set_res));
                 } else {
                     pinned_core = core;
                     core_to_threads_[core].insert(i);
@@ -267,7 +274,7 @@ private:
     std::vector<size_t> all_thread_ids_;
     TaskPoolStats stats_;
 
-    const char* LOG_TAG = "TaskPool";
+    static constexpr const char* LOG_TAG = "TaskPool";
 };
 
 
@@ -108,7 +108,9 @@ public:
 
     bool isStop() const noexcept override { return stop_.load(std::memory_order_relaxed); }
     bool isRunning() const noexcept override { return running_.load(std::memory_order_relaxed); }
-    bool isIdle() const noexcept override { return !has_task_.load(std::memory_order_relaxed); }
+    bool isIdle() const noexcept override {
+        return !has_task_.load(std::memory_order_relaxed) && !task_running_.load(std::memory_order_relaxed);
+    }
 
     Result<void> wait(int msec = -1) override {
         std::unique_lock<std::mutex> lock(task_mutex_);
@@ -279,9 +281,9 @@ private:
                     task.on_complete(result);
             }
             {
+                // has_task_ 는 꺼낼 때 이미 해제 - 여기서 지우면 실행 중 받은 다음 task 가 사라짐
                 std::lock_guard<std::mutex> lock(task_mutex_);
                 task_running_.store(false, std::memory_order_relaxed);
-                has_task_.store(false, std::memory_order_relaxed);
                 cond_task_.notify_all();
             }
         }
@@ -18,16 +18,24 @@ Worker::~Worker() {
 Result<void> Worker::init(WorkerDescriptor desc)
 {
     LOG_DEBUG(logTag(), "init");
-    {
-        std::lock_guard<std::mutex> lock(worker_mutex_);
-        if (state_ != WorkerState::Init && state_ != WorkerState::Stopped)
-            return Error(ResultCode::AlreadyExists, "already initialized");
-        
-        desc_ = desc;
-        type_ = desc.type;
-        state_ = WorkerState::Ready;
-    }    
-    resetFlags();
+    uint32_t w = word_.load(std::memory_order_acquire);
+    auto state = stateOf(w);
+    if (state != WorkerState::Init && state != WorkerState::Stopped)
+        return Error(ResultCode::AlreadyExists, "already initialized");
+
+    // flag 초기화와 함께 Ready 로 전환
+    if (!word_.compare_exchange_strong(w, static_cast<uint32_t>(WorkerState::Ready),
+                                       std::memory_order_acq_rel))
+        return Error(ResultCode::AlreadyExists, "already initialized");
+
+    desc_ = desc;
+    type_ = desc.type;
+
+    // 스스로 종료된 이전 스레드 정리 (재시작)
+    if (state == WorkerState::Stopped) {
+        thread_.stop();
+        thread_.join();
+    }
 
     auto r = thread_.init();
     if (!r) {
@@ -42,12 +50,8 @@ Result<void> Worker::init(WorkerDescriptor desc)
 Result<void> Worker::start()
 {
     LOG_DEBUG(logTag(), "start");
-    {
-        std::lock_guard<std::mutex> lock(worker_mutex_);
-        
-        if (state_ == WorkerState::Running)
-            return Fail();
-    }
+    if (stateOf(word_.load(std::memory_order_acquire)) == WorkerState::Running)
+        return Fail();
 
     auto pre = onPreStart();
     if (pre.hasError())
@@ -68,11 +72,7 @@ Result<void> Worker::start()
     auto exec_result = thread_.execute(td);
     if (!exec_result) return exec_result;
     
-    {
-        std::lock_guard<std::mutex> lock(worker_mutex_);
-        state_ = WorkerState::Running;
-        cond_.notify_all();
-    }
+    setState(WorkerState::Running);
     onPostStart();
 
     return OK();
@@ -81,17 +81,30 @@ Result<void> Worker::start()
 Result<void> Worker::stop()
 {
     LOG_DEBUG(logTag(), "stop");
-    {
-        std::unique_lock<std::mutex> lock(worker_mutex_);
-        if (state_ != WorkerState::Running && state_ != WorkerState::Stopping)
+    uint32_t w = word_.load(std::memory_order_acquire);
+    uint32_t next;
+    // notify() 의 waiters_ load 와 seq_cst 로 짝 - 등록 중인 대기자의 wakeup 유실 방지 (setFlags 와 동일)
+    do {
+        auto state = stateOf(w);
+        if (state != WorkerState::Running && state != WorkerState::Stopping)
             return OK();
+        next = (w & ~(STATE_MASK | PAUSE_BIT | SLEEP_BIT))
+             | static_cast<uint32_t>(WorkerState::Stopping) | STOP_BIT;
+    } while (!word_.compare_exchange_weak(w, next, std::memory_order_seq_cst));
+    notify();
+
+    // run() 내부에서 stop() 호출 시 자기 자신을 join 하지 않음
+    if (isWorkerThread()) {
+        LOG_DEBUG(logTag(), "stop requested from worker thread");
+        return OK();
+    }
 
-        state_ = WorkerState::Stopping;
-        stop_requested_ = true;
-        paused_ = false;
-        sleeping_ = false;
-        cond_.notify_all();
+    // 이미 다른 호출자가 정지 중이면 완료까지 대기
+    if (stateOf(w) == WorkerState::Stopping) {
+        waitFor([](uint32_t v) { return stateOf(v) == WorkerState::Stopped; });
+        return OK();
     }
+
     LOG_DEBUG(logTag(), "stopping...");
     onPreStop();
     try {
@@ -101,10 +114,7 @@ Result<void> Worker::stop()
         LOG_ERROR(logTag(), "Exception during thread join: {}", e.what());
     }
     LOG_DEBUG(logTag(), "stopped.");
-    {
-        std::unique_lock<std::mutex> lock(worker_mutex_);
-        state_ = WorkerState::Stopped;
-    }
+    setState(WorkerState::Stopped);
     
     resetFlags();
     onPostStop();
@@ -115,45 +125,39 @@ Result<void> Worker::stop()
 // 
 Result<void> Worker::pause() {
     LOG_DEBUG(logTag(), "pause");
-    std::lock_guard<std::mutex> lock(worker_mutex_);
     if (desc_.type != WorkerType::Loop)
         return Error(ResultCode::NotSupported, "pause() only available in Loop type Worker");
-    paused_ = true;
+    word_.fetch_or(PAUSE_BIT, std::memory_order_acq_rel);
     return OK();
 }
 
 Result<void> Worker::resume() {
     LOG_DEBUG(logTag(), "resume");
-    std::lock_guard<std::mutex> lock(worker_mutex_);
     if (desc_.type != WorkerType::Loop)
         return Error(ResultCode::NotSupported, "resume() only available in Loop type Worker");
-    paused_  = false;
-    cond_.notify_all();
+    setFlags(0, PAUSE_BIT);
     return OK();
 }
 
 Result<void> Worker::sleep(int msec)
 {
-    std::unique_lock<std::mutex> lock(worker_mutex_);
-    sleeping_ = true;
-    cond_.wait_for(lock, std::chrono::milliseconds(msec), [this]() { return !sleeping_ || stop_requested_; });
-    sleeping_  = false;
+    word_.fetch_or(SLEEP_BIT, std::memory_order_acq_rel);
+    waitFor([](uint32_t w) { return !(w & SLEEP_BIT) || (w & STOP_BIT); }, msec);
+    word_.fetch_and(~SLEEP_BIT, std::memory_order_acq_rel);
     return OK();
 }
 
 Result<void> Worker::wakeup()
 {
-    std::lock_guard<std::mutex> lock(worker_mutex_);
-    sleeping_ = false;
-    cond_.notify_all();
+    setFlags(0, SLEEP_BIT);
     return OK();
 }
 
 Result<void> Worker::event()
 {
-    std::lock_guard<std::mutex> lock(event_mutex_);
-    event_ = true;
-    cond_event_.notify_all();
+    // 이미 pending 이면 깨울 필요 없음
+    uint32_t prev = word_.fetch_or(EVENT_BIT, std::memory_order_seq_cst);
+    if (!(prev & EVENT_BIT)) notify();
     return OK();
 }
 
@@ -161,27 +165,21 @@ Result<void> Worker::threadLoopEntry() {
     LOG_INFO(logTag(), "Loop[{}] loop start", desc_.name);
     Result<void> result;
     try {
-        { // start wait
-            std::unique_lock<std::mutex> lock(worker_mutex_);
-            cond_.wait(lock, [this]() { return state_ == WorkerState::Running || stop_requested_; });
-            if (stop_requested_) return OK(); 
-        }
-        while (!stop_requested_) {
-            { // pause wait
-                std::unique_lock<std::mutex> lock(worker_mutex_);
-                cond_.wait(lock, [this]() { return !paused_ || stop_requested_; });
-                if (stop_requested_ || state_ != WorkerState::Running) break;
-            }
+        if (!waitStart()) return OK();
+
+        while (!isStopRequested()) {
+            // pause wait
+            waitFor([](uint32_t w) { return !(w & PAUSE_BIT) || (w & STOP_BIT); });
+            uint32_t w = word_.load(std::memory_order_acquire);
+            if ((w & STOP_BIT) || stateOf(w) != WorkerState::Running) break;
+
             result = run();
-            if(onCompleted) onCompleted(result);
+            onCompleted(result);
             if (!result) {
-                std::lock_guard<std::mutex> lock(worker_mutex_);
-                state_ = WorkerState::Stopped;
-                stop_requested_ = true; 
-                cond_.notify_all();
+                setFlags(STOP_BIT);
                 break;
             }
-            if (stop_requested_) break;
+            if (isStopRequested()) break;
             sleep(desc_.loop_sleep_ms);
         }
     } catch (const std::exception& e) {
@@ -191,10 +189,7 @@ Result<void> Worker::threadLoopEntry() {
         LOG_ERROR(logTag(), "loop[{}] unknown exception occurred", desc_.name);
         result = Fail();
     }
-    {
-        std::lock_guard<std::mutex> lock(worker_mutex_);
-        state_ = WorkerState::Stopped;
-    }
+    setState(WorkerState::Stopped);
     return result;
 }
 
@@ -202,29 +197,21 @@ Result<void> Worker::threadEventEntry() {
     LOG_INFO(logTag(), "event[{}] loop start", desc_.name);
     Result<void> result;
     try {
-        { // start wait
-            std::unique_lock<std::mutex> lock(worker_mutex_);
-            cond_.wait(lock, [this]() { return state_ == WorkerState::Running || stop_requested_; });
-            if (stop_requested_) return OK(); 
-        }
-        while (!stop_requested_) {
-            { // event wait
-                std::unique_lock<std::mutex> event_lock(event_mutex_);
-                cond_event_.wait(event_lock, [this]() { return event_ || stop_requested_; });
-                if (stop_requested_ || state_ != WorkerState::Running) break;
-                event_ = false;
-            }
+        if (!waitStart()) return OK();
+
+        while (!isStopRequested()) {
+            // event wait
+            waitFor([](uint32_t w) { return (w & EVENT_BIT) || (w & STOP_BIT); });
+            uint32_t w = word_.fetch_and(~EVENT_BIT, std::memory_order_acq_rel);
+            if ((w & STOP_BIT) || stateOf(w) != WorkerState::Running) break;
+
             result = run();
-            if(onCompleted) onCompleted(result);
+            onCompleted(result);
             if (!result) {
-                std::lock_guard<std::mutex> lock(worker_mutex_);
-                state_ = WorkerState::Stopped;
-                stop_requested_ = true; 
-                cond_.notify_all();
+                setFlags(STOP_BIT);
                 break;
             }
-            if (stop_requested_) break;
-            //sleep(desc_.loop_sleep_ms);
+            if (isStopRequested()) break;
         }
     } catch (const std::exception& e) {
         LOG_ERROR(logTag(), "event[{}] exception: {}", desc_.name, e.what());
@@ -233,25 +220,17 @@ Result<void> Worker::threadEventEntry() {
         LOG_ERROR(logTag(), "event[{}] unknown exception occurred", desc_.name);
         result = Fail();
     }
-    {
-        std::lock_guard<std::mutex> lock(worker_mutex_);
-        state_ = WorkerState::Stopped;
-    }
+    setState(WorkerState::Stopped);
     return result;
 }
 
 Result<void> Worker::threadSingleEntry() {
     Result<void> result;
     try {
-        { // wait
-            std::unique_lock<std::mutex> lock(worker_mutex_);
-            cond_.wait(lock, [this]() { return state_ == WorkerState::Running || stop_requested_; });
-            if (stop_requested_) return OK(); 
-        }
+        if (!waitStart()) return OK();
+
         result = run();
-        if(onCompleted) {
-            onCompleted(result);
-        }
+        onCompleted(result);
     } catch (const std::exception& e) {
         LOG_ERROR(logTag(), "single[{}] exception: {}", desc_.name, e.what());
         result = Fail();
@@ -259,22 +238,50 @@ Result<void> Worker::threadSingleEntry() {
         LOG_ERROR(logTag(), "single[{}] unknown exception occurred", desc_.name);
         result = Fail();
     }
-    {
-        std::lock_guard<std::mutex> lock(worker_mutex_);
-        state_ = WorkerState::Stopped;
-    }
+    setState(WorkerState::Stopped);
     return result;
 }
 
 
+bool Worker::waitStart() {
+    waitFor([](uint32_t w) { return stateOf(w) == WorkerState::Running || (w & STOP_BIT); });
+    return !isStopRequested();
+}
+
+void Worker::setState(WorkerState state) noexcept {
+    setFlags(static_cast<uint32_t>(state), STATE_MASK);
+}
+
+void Worker::setFlags(uint32_t set, uint32_t clear) noexcept {
+    uint32_t w = word_.load(std::memory_order_relaxed);
+    uint32_t next;
+    do {
+        next = (w & ~clear) | set;
+    } while (!word_.compare_exchange_weak(w, next, std::memory_order_seq_cst));
+    if (next != w) notify();
+}
+
+void Worker::notify() noexcept {
+    // 대기자가 없으면 syscall 생략
+    if (waiters_.load(std::memory_order_seq_cst) > 0)
+        futexWake(word_);
+}
+
+template<typename Pred>
+bool Worker::waitFor(Pred pred, int msec) noexcept {
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    bool ok = futexWaitUntil(word_, pred, msec);
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+    return ok;
+}
+
+bool Worker::isWorkerThread() const noexcept {
+    return thread_.id() == std::hash<std::thread::id>{}(std::this_thread::get_id());
+}
 
 void Worker::resetFlags() {
-    std::lock_guard<std::mutex> lock(worker_mutex_);
-    paused_ = false;
-    sleeping_ = false;
-    stop_requested_ = false;
-    event_ = false;
+    word_.fetch_and(~FLAG_MASK, std::memory_order_acq_rel);
 }
 
 
-} // namespace worker
\ No newline at end of file
+} // namespace worker
@@ -1,8 +1,8 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <atomic>
 #include <mutex>
-#include <condition_variable>
 #include <chrono>
 #include <fmt/ostream.h>
 #include <unordered_map>
@@ -10,6 +10,7 @@
 #include "result.h"
 #include "logging.hpp"
 #include "thread_task.hpp"
+#include "futex.hpp"
 
 namespace task {
     
@@ -49,7 +50,7 @@ struct WorkerStatus {
 class Worker
 {
 public:
-    Worker() : state_(WorkerState::Init), type_(WorkerType::Single) { }
+    Worker() : word_(static_cast<uint32_t>(WorkerState::Init)), type_(WorkerType::Single) { }
     virtual ~Worker();
 
     // 복사 대입 금지 
@@ -72,18 +73,17 @@ public:
     Result<void> event();
 
     bool isInitialized() const noexcept {
-        return status().state == WorkerState::Ready ||
-            status().state == WorkerState::Running;
+        auto state = stateOf(word_.load(std::memory_order_relaxed));
+        return state == WorkerState::Ready || state == WorkerState::Running;
     }
 
     bool isStopRequested() const noexcept {
-        std::lock_guard<std::mutex> lock(worker_mutex_);
-        return stop_requested_;
+        return word_.load(std::memory_order_relaxed) & STOP_BIT;
     }
 
     WorkerStatus status() const noexcept {
-        std::lock_guard<std::mutex> lock(worker_mutex_);
-        return {state_, type_, paused_, sleeping_, stop_requested_};
+        uint32_t w = word_.load(std::memory_order_relaxed);
+        return {stateOf(w), type_, (w & PAUSE_BIT) != 0, (w & SLEEP_BIT) != 0, (w & STOP_BIT) != 0};
     };
 
 protected:
@@ -100,9 +100,31 @@ protected:
     static constexpr const char* LOG_TAG = "Worker";
 
 private:
+    // ------------------------------------------------------
+    // state word : [0..3] WorkerState | pause | sleep | stop | event
+    // ------------------------------------------------------
+    static constexpr uint32_t STATE_MASK = 0x0F;
+    static constexpr uint32_t PAUSE_BIT  = 1u << 4;
+    static constexpr uint32_t SLEEP_BIT  = 1u << 5;
+    static constexpr uint32_t STOP_BIT   = 1u << 6;
+    static constexpr uint32_t EVENT_BIT  = 1u << 7;
+    static constexpr uint32_t FLAG_MASK  = PAUSE_BIT | SLEEP_BIT | STOP_BIT | EVENT_BIT;
+
+    static constexpr WorkerState stateOf(uint32_t w) noexcept {
+        return static_cast<WorkerState>(w & STATE_MASK);
+    }
+
+    void setState(WorkerState state) noexcept;
+    void setFlags(uint32_t set, uint32_t clear = 0) noexcept;
+    void notify() noexcept;
+    template<typename Pred>
+    bool waitFor(Pred pred, int msec = -1) noexcept;
+    bool isWorkerThread() const noexcept;
+
     Result<void> threadSingleEntry();
     Result<void> threadLoopEntry();
     Result<void> threadEventEntry();
+    bool waitStart();
     void resetFlags();
     const char* logTag() const {
         auto [it, inserted] = tag_cache_.try_emplace(
@@ -116,21 +138,12 @@ private:
 private:
     static thread_local std::unordered_map<const Worker*, std::string> tag_cache_;
 
-    mutable std::mutex worker_mutex_;
-    mutable std::mutex event_mutex_;
-
-    std::condition_variable cond_;
-    std::condition_variable cond_event_;
-    bool event_ = false;
-    bool sleeping_ = false;
-    bool paused_  = false;
-    bool stop_requested_ = false;
-    WorkerState   state_;
+    std::atomic<uint32_t> word_;
+    std::atomic<uint32_t> waiters_{0};
     WorkerType    type_;
 
     task::ThreadTask<void> thread_;
     WorkerDescriptor desc_;
 };
 
-
 }
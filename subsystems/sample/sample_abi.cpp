@@ -1,5 +1,6 @@
 #include "common_type.h"
 #include "subsystem_abi.h"
+#include "zmq_context.hpp"
 #include <string>
 #include <vector>
 #include <new>
@@ -53,7 +54,7 @@ static int sample_query(void *h, uint32_t code, const void *in, void *out)
 
 static const SubsystemVTable A_VTABLE = {
     /* .size = */ (uint32_t)sizeof(SubsystemVTable),
-    /* .abi_version = */ 1,
+    /* .abi_version = */ SUBSYS_ABI_VERSION,
     /* .init =  */ &sample_init,
     /* .start = */ &sample_start,
     /* .stop  = */ &sample_stop,
@@ -79,6 +80,13 @@ static int sample_create(const SubsystemParams *params, SubsystemHandle **out)
             obj->manifest_type = params->manifest_type;
         if (params->manifest_path)
             obj->manifest_path = params->manifest_path;
+        // host 와 같은 zmq context 사용 (inproc / Direct 연결)
+        if (params->bus_context &&
+            !ZmqContext::adopt(static_cast<ZmqContext *>(params->bus_context)))
+        {
+            delete obj;
+            return SUBSYS_ERR;
+        }
     }
 
     *out = obj;
@@ -113,7 +121,7 @@ extern "C" __attribute__((visibility("default")))
 const SubsystemDescriptor *subsystem_descriptor(void)
 {
     static const SubsystemDescriptor DESC = {
-        /* .abi_version     = */ 1,
+        /* .abi_version     = */ SUBSYS_ABI_VERSION,
         /* .name            = */ "Sample",
         /* .version_str     = */ SUBSYS_SAMPLE_VERSION,
         /* .vtable          = */ &A_VTABLE,
@@ -0,0 +1,312 @@
+// ------------------------------------------------------
+// generated by tools/generator/gen_command_types.py from sample_command.yaml
+// DO NOT EDIT - manifest 를 수정하고 다시 생성
+// ------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "result.h"
+#include "message.hpp"
+#include "typed_codec.hpp"
+
+namespace sample::msg {
+
+// ========================= commands =========================
+
+// ------------------------------------------------------
+// SampleCommand - sample command
+// ------------------------------------------------------
+struct SampleCommand {
+    static constexpr std::string_view NAME  = "SampleCommand";
+    static constexpr uint32_t SCHEMA_ID = 0xa69b4761u;
+
+    std::string_view sample;
+    int32_t op = 0;
+
+    // 고정 영역 offset
+    static constexpr size_t OFF_SAMPLE = 0;
+    static constexpr size_t OFF_OP = 8;
+    static constexpr size_t FIXED_SIZE = 12;
+
+    void encode(std::string& out) const {
+        typed::Writer w(out, SCHEMA_ID, FIXED_SIZE);
+        w.putString(OFF_SAMPLE, sample);
+        w.put<int32_t>(OFF_OP, op);
+    }
+
+    // string 은 buf 를 그대로 가리킴 (buf 가 살아있는 동안 유효)
+    static Result<SampleCommand> decode(std::string_view buf) {
+        typed::Reader r(buf, SCHEMA_ID, FIXED_SIZE);
+        if (!r.ok()) return r.fail<SampleCommand>();
+        SampleCommand v;
+        if (!r.getString(OFF_SAMPLE, v.sample)) return r.fail<SampleCommand>();
+        v.op = r.get<int32_t>(OFF_OP);
+        return Result<SampleCommand>::OK(v);
+    }
+
+    void toMessage(message::Message& m) const {
+        static const message::Key k_sample = message::key("sample");
+        static const message::Key k_op = message::key("op");
+        m.set(k_sample, sample);
+        m.set(k_op, op);
+    }
+
+    // string 은 m 을 그대로 가리킴 (m 이 살아있는 동안 유효)
+    static Result<SampleCommand> fromMessage(const message::Message& m) {
+        SampleCommand v;
+        auto sample = m.get<std::string_view>("sample");
+        if (!sample) return Result<SampleCommand>::Error(ResultCode::InvalidArgument, "Missing or invalid argument: sample");
+        v.sample = *sample;
+        auto op = m.get<int32_t>("op");
+        if (!op) return Result<SampleCommand>::Error(ResultCode::InvalidArgument, "Missing or invalid argument: op");
+        v.op = *op;
+        return Result<SampleCommand>::OK(v);
+    }
+};
+
+// ------------------------------------------------------
+// UploadLog - Upload diagnostic logs to remote server
+// ------------------------------------------------------
+struct UploadLog {
+    static constexpr std::string_view NAME  = "UploadLog";
+    static constexpr uint32_t SCHEMA_ID = 0xfd111d17u;
+
+    std::string_view log;
+
+    // 고정 영역 offset
+    static constexpr size_t OFF_LOG = 0;
+    static constexpr size_t FIXED_SIZE = 8;
+
+    void encode(std::string& out) const {
+        typed::Writer w(out, SCHEMA_ID, FIXED_SIZE);
+        w.putString(OFF_LOG, log);
+    }
+
+    // string 은 buf 를 그대로 가리킴 (buf 가 살아있는 동안 유효)
+    static Result<UploadLog> decode(std::string_view buf) {
+        typed::Reader r(buf, SCHEMA_ID, FIXED_SIZE);
+        if (!r.ok()) return r.fail<UploadLog>();
+        UploadLog v;
+        if (!r.getString(OFF_LOG, v.log)) return r.fail<UploadLog>();
+        return Result<UploadLog>::OK(v);
+    }
+
+    void toMessage(message::Message& m) const {
+        static const message::Key k_log = message::key("log");
+        m.set(k_log, log);
+    }
+
+    // string 은 m 을 그대로 가리킴 (m 이 살아있는 동안 유효)
+    static Result<UploadLog> fromMessage(const message::Message& m) {
+        UploadLog v;
+        auto log = m.get<std::string_view>("log");
+        if (!log) return Result<UploadLog>::Error(ResultCode::InvalidArgument, "Missing or invalid argument: log");
+        v.log = *log;
+        return Result<UploadLog>::OK(v);
+    }
+};
+
+// ------------------------------------------------------
+// GetStatus - Get current system status
+// ------------------------------------------------------
+struct GetStatus {
+    static constexpr std::string_view NAME  = "GetStatus";
+    static constexpr uint32_t SCHEMA_ID = 0xf3a7a3d9u;
+
+    // 고정 영역 offset
+    static constexpr size_t FIXED_SIZE = 0;
+
+    void encode(std::string& out) const {
+        typed::Writer w(out, SCHEMA_ID, FIXED_SIZE);
+        (void)w;
+    }
+
+    // string 은 buf 를 그대로 가리킴 (buf 가 살아있는 동안 유효)
+    static Result<GetStatus> decode(std::string_view buf) {
+        typed::Reader r(buf, SCHEMA_ID, FIXED_SIZE);
+        if (!r.ok()) return r.fail<GetStatus>();
+        GetStatus v;
+        return Result<GetStatus>::OK(v);
+    }
+
+    void toMessage(message::Message& m) const {
+        (void)m;
+    }
+
+    // string 은 m 을 그대로 가리킴 (m 이 살아있는 동안 유효)
+    static Result<GetStatus> fromMessage(const message::Message& m) {
+        GetStatus v;
+        (void)m;
+        return Result<GetStatus>::OK(v);
+    }
+};
+
+// ========================= events =========================
+
+// ------------------------------------------------------
+// SampleAcceptedEvent
+// ------------------------------------------------------
+struct SampleAcceptedEvent {
+    static constexpr std::string_view TOPIC = "event.sample.accepted";
+    static constexpr uint32_t SCHEMA_ID = 0x11ff54e9u;
+
+    // 고정 영역 offset
+    static constexpr size_t FIXED_SIZE = 0;
+
+    void encode(std::string& out) const {
+        typed::Writer w(out, SCHEMA_ID, FIXED_SIZE);
+        (void)w;
+    }
+
+    // string 은 buf 를 그대로 가리킴 (buf 가 살아있는 동안 유효)
+    static Result<SampleAcceptedEvent> decode(std::string_view buf) {
+        typed::Reader r(buf, SCHEMA_ID, FIXED_SIZE);
+        if (!r.ok()) return r.fail<SampleAcceptedEvent>();
+        SampleAcceptedEvent v;
+        return Result<SampleAcceptedEvent>::OK(v);
+    }
+
+    void toMessage(message::Message& m) const {
+        (void)m;
+    }
+
+    // string 은 m 을 그대로 가리킴 (m 이 살아있는 동안 유효)
+    static Result<SampleAcceptedEvent> fromMessage(const message::Message& m) {
+        SampleAcceptedEvent v;
+        (void)m;
+        return Result<SampleAcceptedEvent>::OK(v);
+    }
+};
+
+// ------------------------------------------------------
+// SampleCompletedEvent
+// ------------------------------------------------------
+struct SampleCompletedEvent {
+    static constexpr std::string_view TOPIC = "event.sample.completed";
+    static constexpr uint32_t SCHEMA_ID = 0xe7d8e6e9u;
+
+    std::string_view sample;
+    int32_t result = 0;
+
+    // 고정 영역 offset
+    static constexpr size_t OFF_SAMPLE = 0;
+    static constexpr size_t OFF_RESULT = 8;
+    static constexpr size_t FIXED_SIZE = 12;
+
+    void encode(std::string& out) const {
+        typed::Writer w(out, SCHEMA_ID, FIXED_SIZE);
+        w.putString(OFF_SAMPLE, sample);
+        w.put<int32_t>(OFF_RESULT, result);
+    }
+
+    // string 은 buf 를 그대로 가리킴 (buf 가 살아있는 동안 유효)
+    static Result<SampleCompletedEvent> decode(std::string_view buf) {
+        typed::Reader r(buf, SCHEMA_ID, FIXED_SIZE);
+        if (!r.ok()) return r.fail<SampleCompletedEvent>();
+        SampleCompletedEvent v;
+        if (!r.getString(OFF_SAMPLE, v.sample)) return r.fail<SampleCompletedEvent>();
+        v.result = r.get<int32_t>(OFF_RESULT);
+        return Result<SampleCompletedEvent>::OK(v);
+    }
+
+    void toMessage(message::Message& m) const {
+        static const message::Key k_sample = message::key("sample");
+        static const message::Key k_result = message::key("result");
+        m.set(k_sample, sample);
+        m.set(k_result, result);
+    }
+
+    // string 은 m 을 그대로 가리킴 (m 이 살아있는 동안 유효)
+    static Result<SampleCompletedEvent> fromMessage(const message::Message& m) {
+        SampleCompletedEvent v;
+        auto sample = m.get<std::string_view>("sample");
+        if (!sample) return Result<SampleCompletedEvent>::Error(ResultCode::InvalidArgument, "Missing or invalid argument: sample");
+        v.sample = *sample;
+        auto result = m.get<int32_t>("result");
+        if (!result) return Result<SampleCompletedEvent>::Error(ResultCode::InvalidArgument, "Missing or invalid argument: result");
+        v.result = *result;
+        return Result<SampleCompletedEvent>::OK(v);
+    }
+};
+
+// ------------------------------------------------------
+// LogUploadedEvent
+// ------------------------------------------------------
+struct LogUploadedEvent {
+    static constexpr std::string_view TOPIC = "event.log.uploaded";
+    static constexpr uint32_t SCHEMA_ID = 0xaabcb57bu;
+
+    // 고정 영역 offset
+    static constexpr size_t FIXED_SIZE = 0;
+
+    void encode(std::string& out) const {
+        typed::Writer w(out, SCHEMA_ID, FIXED_SIZE);
+        (void)w;
+    }
+
+    // string 은 buf 를 그대로 가리킴 (buf 가 살아있는 동안 유효)
+    static Result<LogUploadedEvent> decode(std::string_view buf) {
+        typed::Reader r(buf, SCHEMA_ID, FIXED_SIZE);
+        if (!r.ok()) return r.fail<LogUploadedEvent>();
+        LogUploadedEvent v;
+        return Result<LogUploadedEvent>::OK(v);
+    }
+
+    void toMessage(message::Message& m) const {
+        (void)m;
+    }
+
+    // string 은 m 을 그대로 가리킴 (m 이 살아있는 동안 유효)
+    static Result<LogUploadedEvent> fromMessage(const message::Message& m) {
+        LogUploadedEvent v;
+        (void)m;
+        return Result<LogUploadedEvent>::OK(v);
+    }
+};
+
+// ------------------------------------------------------
+// LogFailedEvent
+// ------------------------------------------------------
+struct LogFailedEvent {
+    static constexpr std::string_view TOPIC = "event.log.failed";
+    static constexpr uint32_t SCHEMA_ID = 0x1a3c2fdcu;
+
+    std::string_view reason;
+
+    // 고정 영역 offset
+    static constexpr size_t OFF_REASON = 0;
+    static constexpr size_t FIXED_SIZE = 8;
+
+    void encode(std::string& out) const {
+        typed::Writer w(out, SCHEMA_ID, FIXED_SIZE);
+        w.putString(OFF_REASON, reason);
+    }
+
+    // string 은 buf 를 그대로 가리킴 (buf 가 살아있는 동안 유효)
+    static Result<LogFailedEvent> decode(std::string_view buf) {
+        typed::Reader r(buf, SCHEMA_ID, FIXED_SIZE);
+        if (!r.ok()) return r.fail<LogFailedEvent>();
+        LogFailedEvent v;
+        if (!r.getString(OFF_REASON, v.reason)) return r.fail<LogFailedEvent>();
+        return Result<LogFailedEvent>::OK(v);
+    }
+
+    void toMessage(message::Message& m) const {
+        static const message::Key k_reason = message::key("reason");
+        m.set(k_reason, reason);
+    }
+
+    // string 은 m 을 그대로 가리킴 (m 이 살아있는 동안 유효)
+    static Result<LogFailedEvent> fromMessage(const message::Message& m) {
+        LogFailedEvent v;
+        auto reason = m.get<std::string_view>("reason");
+        if (!reason) return Result<LogFailedEvent>::Error(ResultCode::InvalidArgument, "Missing or invalid argument: reason");
+        v.reason = *reason;
+        return Result<LogFailedEvent>::OK(v);
+    }
+};
+
+} // namespace sample::msg
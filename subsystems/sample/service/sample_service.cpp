@@ -10,20 +10,20 @@ SampleService::SampleService() = default;
 SampleService::~SampleService() = default;
 
 
-Result<void> SampleService::cmdSample(const message::Message& args)
+Result<void> SampleService::cmdSample(const msg::SampleCommand& args)
 {
     auto domain = Resolve<SampleDomain>();
     return OK();
 }    
 
 
-Result<void> SampleService::cmdUploadLog(const message::Message& args)
+Result<void> SampleService::cmdUploadLog(const msg::UploadLog& args)
 {
     return OK();
 }
 
 
-Result<void> SampleService::cmdGetStatus(const message::Message& args)
+Result<void> SampleService::cmdGetStatus(const msg::GetStatus& args)
 {
     return OK();
 }
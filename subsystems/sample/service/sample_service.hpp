@@ -6,6 +6,7 @@
 
 #include "result.h"
 #include "message.hpp"
+#include "sample_messages.hpp"
 #include "ioc.hpp"
 #include "system_service.hpp"
 
@@ -31,7 +32,7 @@ public:
      * @emit: SampleAccepted, event.sample.completed
      * @description: sample command
     */
-   Result<void> cmdSample(const message::Message& args);        
+   Result<void> cmdSample(const msg::SampleCommand& args);        
 
     /**
      * @type: command
@@ -41,7 +42,7 @@ public:
      * @emit: event.log.uploaded, event.log.failed
      * @description: Upload diagnostic logs to remote server
      */
-    Result<void> cmdUploadLog(const message::Message& args);
+    Result<void> cmdUploadLog(const msg::UploadLog& args);
 
     /**
      * @type: command
@@ -50,7 +51,7 @@ public:
      * @emit:
      * @description: Get current system status
      */
-    Result<void> cmdGetStatus(const message::Message& args);
+    Result<void> cmdGetStatus(const msg::GetStatus& args);
 
 protected:
     void registerCommand() {
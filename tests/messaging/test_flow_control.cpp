@@ -0,0 +1,173 @@
+// test_flow_control.cpp
+// SendWindow credit (ACK / timeout / Reservation / peer 만료) 와 ReliableReceiver gap 복구
+//  receiver 의 control 요청은 SendWindow::handle 로 바로 연결 (transport 없음)
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flow_control.hpp"
+#include "test_util.hpp"
+
+namespace {
+
+SendWindowDescriptor windowDesc(const std::string& pattern, size_t window, int block_ms = 50) {
+    SendWindowDescriptor d;
+    d.topics = {pattern};
+    d.window = window;
+    d.block_ms = block_ms;
+    return d;
+}
+
+// acquire + append (publish 한 번)
+uint64_t publish(SendWindow& w, TopicId id, const std::string& payload) {
+    if (!w.acquire(id)) return 0;
+    SendWindow::Reservation credit(w, id);
+    uint64_t seq = w.append(id, payload);
+    credit.commit();
+    return seq;
+}
+
+RawMessage live(TopicId id, uint64_t seq, const std::string& payload) {
+    auto copy = std::make_shared<const std::string>(payload);
+    return RawMessage{topicName(id), *copy, copy, seq, id};
+}
+
+} // namespace
+
+TEST_CASE(credit_blocks_until_ack) {
+    SendWindow w(windowDesc("ft.credit.#", 4));
+    TopicId id = internTopic("ft.credit.a");
+
+    // 구독자가 ACK 하기 전에는 제한 없음
+    for (int i = 0; i < 10; ++i) CHECK(publish(w, id, "x") != 0);
+    CHECK(!w.handle(flow::encodeAck("peer", "ft.credit.a", 10)).empty());
+
+    for (int i = 0; i < 4; ++i) CHECK(publish(w, id, "y") != 0);
+    auto r = w.acquire(id);
+    CHECK(!r && r.code() == ResultCode::ResourceBusy);
+    CHECK_EQ(w.stats().credit_timeouts.load(), 1u);
+
+    // 대기 중인 acquire 는 ACK 로 깨어남
+    SendWindow slow(windowDesc("ft.credit.#", 1, 2000));
+    TopicId s = internTopic("ft.credit.slow");
+    publish(slow, s, "1");
+    slow.handle(flow::encodeAck("peer", "ft.credit.slow", 1));
+    publish(slow, s, "2");
+
+    std::atomic<bool> acquired{false};
+    std::thread waiter([&] { acquired = static_cast<bool>(slow.acquire(s)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(!acquired);
+    slow.handle(flow::encodeAck("peer", "ft.credit.slow", 2));
+    waiter.join();
+    CHECK(acquired);
+}
+
+TEST_CASE(reservation_returns_unused_credit) {
+    SendWindow w(windowDesc("ft.reserve", 2));
+    TopicId id = internTopic("ft.reserve");
+    publish(w, id, "0");
+    w.handle(flow::encodeAck("peer", "ft.reserve", 1));
+
+    // append 없이 scope 를 벗어나면 credit 반납 - window 가 줄지 않음
+    for (int i = 0; i < 10; ++i) {
+        CHECK(w.acquire(id));
+        SendWindow::Reservation credit(w, id);
+    }
+    CHECK(publish(w, id, "1") != 0);
+    CHECK(publish(w, id, "2") != 0);
+    CHECK(!w.acquire(id));
+}
+
+TEST_CASE(non_lossless_topic_is_untracked) {
+    SendWindow w(windowDesc("ft.only.#", 1));
+    TopicId other = internTopic("ft.other");
+    for (int i = 0; i < 5; ++i) {
+        CHECK(w.acquire(other));
+        CHECK_EQ(w.append(other, "x"), 0u);
+    }
+    CHECK(w.handle(flow::encodeAck("peer", "ft.other", 1)).empty());
+    CHECK(w.handle("").empty());
+    CHECK(w.handle(std::string(1, char(flow::ControlType::Nack))).empty());     // 잘린 요청
+}
+
+TEST_CASE(silent_peer_is_evicted) {
+    SendWindowDescriptor d = windowDesc("ft.evict", 1, 200);
+    d.peer_timeout_ms = 50;
+    SendWindow w(d);
+    TopicId id = internTopic("ft.evict");
+    publish(w, id, "0");
+    w.handle(flow::encodeAck("peer", "ft.evict", 1));
+    publish(w, id, "1");
+
+    // ACK 가 없는 구독자는 peer_timeout_ms 이후 credit 계산에서 제외
+    CHECK(w.acquire(id));
+    CHECK_EQ(w.stats().evicted.load(), 1u);
+    CHECK_EQ(w.stats().peers.load(), 0u);
+}
+
+TEST_CASE(receiver_recovers_gap_and_tail) {
+    SendWindow window(windowDesc("ft.rx.#", 64));
+    TopicId id = internTopic("ft.rx.a");
+
+    std::vector<std::string> got;
+    ReliableStats stats;
+    ReliableReceiverDescriptor rd;
+    rd.ack_every = 1;
+    auto rx = std::make_shared<ReliableReceiver>(rd,
+        [&](const RawMessage& m) { got.push_back(m.payloadString()); },
+        [&](std::string req, ReliableReceiver::Reply reply) -> Result<void> {
+            reply(Result<std::string>::OK(window.handle(req)));
+            return OK();
+        },
+        stats);
+
+    for (int i = 1; i <= 10; ++i) publish(window, id, std::to_string(i));
+
+    // 4, 5 가 빠지고 8 이후는 live 로 오지 않음
+    for (uint64_t seq : {1, 2, 3, 6, 7}) rx->live(live(id, seq, std::to_string(seq)));
+    CHECK(got == (std::vector<std::string>{"1", "2", "3", "4", "5", "6", "7"}));
+    CHECK_EQ(stats.gaps.load(), 1u);
+    CHECK_EQ(stats.recovered.load(), 2u);
+
+    // 재전송과 겹친 live 는 중복
+    rx->live(live(id, 5, "5"));
+    CHECK_EQ(stats.duplicates.load(), 1u);
+
+    // ACK 응답의 head 로 끝부분 유실 감지 - 두 번째 tick 에서 NACK
+    rx->tick();
+    rx->tick();
+    CHECK_EQ(got.size(), 10u);
+    CHECK(!got.empty() && got.back() == "10");
+    CHECK_EQ(stats.lost.load(), 0u);
+}
+
+TEST_CASE(receiver_skips_beyond_window) {
+    SendWindow window(windowDesc("ft.lost", 2));
+    TopicId id = internTopic("ft.lost");
+
+    std::vector<std::string> got;
+    ReliableStats stats;
+    auto rx = std::make_shared<ReliableReceiver>(ReliableReceiverDescriptor{},
+        [&](const RawMessage& m) { got.push_back(m.payloadString()); },
+        [&](std::string req, ReliableReceiver::Reply reply) -> Result<void> {
+            reply(Result<std::string>::OK(window.handle(req)));
+            return OK();
+        },
+        stats);
+
+    // 구독자가 ACK 하기 전이라 window (2) 를 넘어 보냄 - 2..4 는 이미 window 밖
+    for (int i = 1; i <= 6; ++i) publish(window, id, std::to_string(i));
+    rx->live(live(id, 1, "1"));
+    rx->live(live(id, 6, "6"));
+
+    CHECK_EQ(stats.lost.load(), 3u);
+    CHECK(got == (std::vector<std::string>{"1", "5", "6"}));
+    CHECK(window.stats().unrecoverable.load() >= 3u);
+}
+
+int main() { return test::runAll(); }
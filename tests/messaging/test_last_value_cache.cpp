@@ -0,0 +1,167 @@
+// test_last_value_cache.cpp
+// LastValueCache seq / snapshot 과 SnapshotStitcher 의 snapshot + live 연결 (중복 / gap / 보관)
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "last_value_cache.hpp"
+#include "test_util.hpp"
+
+namespace {
+
+struct Delivered {
+    std::string topic;
+    uint64_t seq;
+    std::string payload;
+};
+
+RawMessage live(const std::string& topic, uint64_t seq, const std::string& payload) {
+    auto copy = std::make_shared<const std::pair<std::string, std::string>>(topic, payload);
+    return RawMessage{copy->first, copy->second, copy, seq, NO_TOPIC};
+}
+
+std::map<std::string, std::pair<uint64_t, std::string>> parse(const std::string& blob, bool& ok) {
+    std::map<std::string, std::pair<uint64_t, std::string>> out;
+    ok = lvc::forEachSnapshot(blob, [&](std::string_view topic, uint64_t seq, std::string_view payload) {
+        out[std::string(topic)] = {seq, std::string(payload)};
+    });
+    return out;
+}
+
+} // namespace
+
+TEST_CASE(seq_frame_round_trip) {
+    char frame[lvc::SEQ_FRAME_SIZE];
+    lvc::encodeSeq(0x0102030405060708ull, frame);
+    CHECK_EQ(lvc::decodeSeq(std::string_view(frame, sizeof(frame))), 0x0102030405060708ull);
+    CHECK_EQ(lvc::decodeSeq(std::string_view(frame, sizeof(frame) - 1)), 0u);
+    frame[0] = 0;
+    CHECK_EQ(lvc::decodeSeq(std::string_view(frame, sizeof(frame))), 0u);
+}
+
+TEST_CASE(cache_seq_and_snapshot) {
+    LastValueCacheDescriptor d;
+    d.topics = {"lt.state.#"};
+    LastValueCache cache(d);
+
+    TopicId a = internTopic("lt.state.a");
+    TopicId b = internTopic("lt.state.b");
+    TopicId x = internTopic("lt.other");
+
+    CHECK_EQ(cache.update(a, "a1"), 1u);
+    CHECK_EQ(cache.update(a, "a2"), 2u);
+    CHECK_EQ(cache.update(b, "b1"), 1u);
+    CHECK_EQ(cache.update(x, "x1"), 0u);         // cache 대상 아님
+    CHECK_EQ(cache.update(b, "b2", 40), 40u);    // lossless seq 가 있으면 그대로 사용
+    CHECK_EQ(cache.stats().topics.load(), 2u);
+
+    auto all = cache.snapshot("");
+    CHECK(all);
+    bool ok = false;
+    auto values = parse(all.value(), ok);
+    CHECK(ok);
+    CHECK_EQ(values.size(), 2u);
+    CHECK(values["lt.state.a"] == std::make_pair(uint64_t(2), std::string("a2")));
+    CHECK(values["lt.state.b"] == std::make_pair(uint64_t(40), std::string("b2")));
+
+    auto only_a = cache.snapshot("lt.state.a");
+    values = parse(only_a.value(), ok);
+    CHECK(ok && values.size() == 1 && values.count("lt.state.a"));
+
+    CHECK(!cache.snapshot("lt.#.a"));
+
+    // 잘린 snapshot 은 형식 오류
+    std::string cut = all.value().substr(0, all.value().size() - 1);
+    parse(cut, ok);
+    CHECK(!ok);
+}
+
+TEST_CASE(stitcher_orders_snapshot_and_live) {
+    std::vector<Delivered> got;
+    SnapshotStitcher stitcher([&](const RawMessage& m) {
+        got.push_back({m.topicString(), m.seq, m.payloadString()});
+    });
+
+    // snapshot 전 live 는 보관
+    stitcher.live(live("lt.s.a", 5, "a5"));
+    stitcher.live(live("lt.s.a", 6, "a6"));
+    stitcher.live(live("lt.s.b", 2, "b2"));
+    stitcher.live(live("lt.s.c", 0, "plain"));      // seq 없음 - 비교 없이 전달
+    CHECK(got.empty());
+    CHECK_EQ(stitcher.stats().buffered.load(), 4u);
+
+    LastValueCacheDescriptor d;
+    d.topics = {"lt.s.#"};
+    LastValueCache cache(d);
+    TopicId a = internTopic("lt.s.a");
+    TopicId b = internTopic("lt.s.b");
+    for (int i = 0; i < 5; ++i) cache.update(a, "a" + std::to_string(i + 1));      // a 는 seq 5 까지
+    cache.update(b, "b0");                                                         // b 는 seq 1
+
+    CHECK(stitcher.deliverSnapshot(std::make_shared<const std::string>(cache.snapshot("lt.s.#").value())));
+
+    // snapshot 값 -> 보관한 live (a5 는 snapshot 과 중복이라 버림)
+    std::vector<std::string> order;
+    for (auto& g : got) order.push_back(g.payload);
+    CHECK(order == (std::vector<std::string>{"a5", "b0", "a6", "b2", "plain"}));
+    CHECK_EQ(stitcher.stats().snapshot.load(), 2u);
+    CHECK_EQ(stitcher.stats().duplicates.load(), 1u);
+
+    // 이후 live 는 바로 전달, 오래된 seq 는 버림
+    got.clear();
+    stitcher.live(live("lt.s.a", 6, "a6-again"));
+    stitcher.live(live("lt.s.a", 7, "a7"));
+    CHECK_EQ(got.size(), 1u);
+    CHECK(!got.empty() && got[0].payload == "a7");
+}
+
+TEST_CASE(stitcher_counts_gap_after_snapshot) {
+    SnapshotStitcher stitcher([](const RawMessage&) { });
+
+    LastValueCacheDescriptor d;
+    d.topics = {"lt.gap"};
+    LastValueCache cache(d);
+    cache.update(internTopic("lt.gap"), "v1");
+
+    CHECK(stitcher.deliverSnapshot(std::make_shared<const std::string>(cache.snapshot("").value())));
+    stitcher.live(live("lt.gap", 3, "v3"));          // seq 2 가 빠짐
+    CHECK_EQ(stitcher.stats().gaps.load(), 1u);
+}
+
+TEST_CASE(snapshot_message_outlives_blob) {
+    std::vector<RawMessage> kept;
+    SnapshotStitcher stitcher([&](const RawMessage& m) { kept.push_back(m); });
+
+    LastValueCacheDescriptor d;
+    d.topics = {"lt.keep.#"};
+    LastValueCache cache(d);
+    cache.update(internTopic("lt.keep.a"), std::string(256, 'k'));
+
+    {
+        auto blob = std::make_shared<const std::string>(cache.snapshot("").value());
+        CHECK(stitcher.deliverSnapshot(blob));
+    }
+    // blob 은 전달한 RawMessage 가 owner 로 보관
+    CHECK_EQ(kept.size(), 1u);
+    CHECK(!kept.empty() && kept[0].owner != nullptr);
+    CHECK(!kept.empty() && kept[0].topicString() == "lt.keep.a");
+    CHECK(!kept.empty() && kept[0].payloadString() == std::string(256, 'k'));
+}
+
+TEST_CASE(failed_snapshot_releases_live) {
+    std::vector<std::string> got;
+    SnapshotStitcher stitcher([&](const RawMessage& m) { got.push_back(m.payloadString()); });
+    stitcher.live(live("lt.fail", 1, "l1"));
+
+    // snapshot 요청 실패 - 보관한 live 만 전달
+    CHECK(stitcher.deliverSnapshot(nullptr));
+    CHECK(got == (std::vector<std::string>{"l1"}));
+
+    // 형식 오류 blob
+    SnapshotStitcher broken([](const RawMessage&) { });
+    CHECK(!broken.deliverSnapshot(std::make_shared<const std::string>("not a snapshot")));
+}
+
+int main() { return test::runAll(); }
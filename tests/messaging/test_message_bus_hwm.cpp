@@ -0,0 +1,80 @@
+// test_message_bus_hwm.cpp
+// PUB HWM - HWM 에 걸린 (멈춘) 구독자가 있어도 다른 구독자는 계속 받음, lossless topic 은 NACK 로 복구
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <zmq.h>
+
+#include "zmq_message_bus.hpp"
+#include "test_util.hpp"
+
+namespace {
+
+const char* ENDPOINT = "inproc://test.bus.hwm";
+
+ZmqMessageBusDescriptor publisherDesc() {
+    ZmqMessageBusDescriptor d;
+    d.pub_endpoint    = ENDPOINT;
+    d.sub_endpoints   = {};
+    d.local_transport = LocalTransport::None;
+    d.pub_hwm         = 16;
+    return d;
+}
+
+// raw SUB socket - rcv_hwm 0 이면 무제한
+void* connectSub(int rcv_hwm, const std::string& prefix) {
+    void* s = zmq_socket(ZmqContext::instance().get(), ZMQ_SUB);
+    zmq_setsockopt(s, ZMQ_RCVHWM, &rcv_hwm, sizeof(rcv_hwm));
+    zmq_setsockopt(s, ZMQ_SUBSCRIBE, prefix.data(), prefix.size());
+    zmq_connect(s, ENDPOINT);
+    return s;
+}
+
+// 남은 multipart 를 버리고 topic frame 만 반환
+bool recvTopic(void* s, std::string& topic, int timeout_ms) {
+    zmq_pollitem_t item{s, 0, ZMQ_POLLIN, 0};
+    if (zmq_poll(&item, 1, timeout_ms) <= 0) return false;
+    char buf[256];
+    int n = zmq_recv(s, buf, sizeof(buf), 0);
+    if (n < 0) return false;
+    topic.assign(buf, std::min<size_t>(n, sizeof(buf)));
+    int more = 1;
+    size_t len = sizeof(more);
+    while (zmq_getsockopt(s, ZMQ_RCVMORE, &more, &len) == 0 && more) zmq_recv(s, buf, sizeof(buf), 0);
+    return true;
+}
+
+} // namespace
+
+TEST_CASE(stalled_subscriber_does_not_block_others) {
+    ZmqMessageBus bus(publisherDesc());
+    CHECK(bus.publish("hwm.warmup", std::string("x")));         // PUB socket bind
+
+    void* stalled = connectSub(1, "");          // 읽지 않음 - pipe 가 곧 HWM
+    void* active  = connectSub(0, "hwm.");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));  // 구독 전파
+
+    const int N = 2000;
+    int failed = 0;
+    for (int i = 0; i < N; ++i) {
+        if (!bus.publish("hwm.telemetry", std::string(64, 'x'))) failed++;
+    }
+    CHECK_EQ(failed, 0);
+
+    // stalled 구독자가 HWM 이어도 active 구독자는 전부 받음
+    int received = 0;
+    std::string topic;
+    while (received < N && recvTopic(active, topic, 500)) {
+        if (topic == "hwm.telemetry") received++;
+    }
+    CHECK_EQ(received, N);
+    CHECK_EQ(bus.pubStats().sent.load(), size_t(N) + 1);
+
+    zmq_close(stalled);
+    zmq_close(active);
+}
+
+int main() { return test::runAll(); }
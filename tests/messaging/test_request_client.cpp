@@ -0,0 +1,146 @@
+// test_request_client.cpp
+// ZmqRequestClient::request - 스레드에서는 blocking, FiberTask 안에서는 fiber 만 park (carrier 는 다른 fiber 수행)
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zmq.h>
+
+#include "zmq_request_client.hpp"
+#include "fiber_task.hpp"
+#include "test_util.hpp"
+
+using namespace task;
+
+namespace {
+
+// ROUTER echo server - "wait" 요청은 release 가 설정될 때까지 응답 보류
+class EchoServer {
+public:
+    // inproc endpoint 는 close 후에도 바로 재사용되지 않으므로 test 마다 다른 이름 사용
+    explicit EchoServer(const std::string& endpoint) : endpoint(endpoint) {
+        socket_ = zmq_socket(ZmqContext::instance().get(), ZMQ_ROUTER);
+        zmq_bind(socket_, endpoint.c_str());
+        thread_ = std::thread([this] { loop(); });
+    }
+
+    ~EchoServer() {
+        stop_ = true;
+        thread_.join();
+        zmq_close(socket_);
+    }
+
+    const std::string endpoint;
+    std::atomic<bool> received_wait{false};
+    std::atomic<bool> release{false};
+
+private:
+    void loop() {
+        std::vector<std::vector<std::string>> held;
+        while (!stop_) {
+            zmq_pollitem_t item{socket_, 0, ZMQ_POLLIN, 0};
+            if (zmq_poll(&item, 1, 10) > 0) {
+                auto frames = recvAll();
+                if (frames.size() == 4 && frames[3] == "wait") {
+                    received_wait = true;
+                    held.push_back(std::move(frames));
+                } else if (!frames.empty()) {
+                    sendAll(frames);
+                }
+            }
+            if (release && !held.empty()) {
+                for (auto& f : held) { f[3] = "released"; sendAll(f); }
+                held.clear();
+            }
+        }
+    }
+
+    // [identity][id][empty][payload]
+    std::vector<std::string> recvAll() {
+        std::vector<std::string> frames;
+        int more = 1;
+        while (more) {
+            zmq_msg_t msg;
+            zmq_msg_init(&msg);
+            if (zmq_msg_recv(&msg, socket_, 0) < 0) { zmq_msg_close(&msg); break; }
+            frames.emplace_back(static_cast<char*>(zmq_msg_data(&msg)), zmq_msg_size(&msg));
+            more = zmq_msg_more(&msg);
+            zmq_msg_close(&msg);
+        }
+        return frames;
+    }
+
+    void sendAll(const std::vector<std::string>& frames) {
+        for (size_t i = 0; i < frames.size(); ++i)
+            zmq_send(socket_, frames[i].data(), frames[i].size(), i + 1 < frames.size() ? ZMQ_SNDMORE : 0);
+    }
+
+    void* socket_ = nullptr;
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
+
+bool waitFor(const std::atomic<bool>& flag, int timeout_ms) {
+    for (int i = 0; i < timeout_ms && !flag.load(); ++i) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return flag.load();
+}
+
+} // namespace
+
+TEST_CASE(thread_request_reply_and_timeout) {
+    EchoServer server("inproc://test.request.thread");
+    ZmqRequestClient client;
+    CHECK(client.start());
+
+    auto r = client.request(server.endpoint, "ping", 2000);
+    CHECK(r && r.value() == "ping");
+
+    // 응답이 보류되면 deadline 에 Timeout
+    auto t = client.request(server.endpoint, "wait", 50);
+    CHECK(!t && t.code() == ResultCode::Timeout);
+    CHECK_EQ(client.stats().timeouts.load(), 1u);
+
+    client.stop();
+}
+
+TEST_CASE(fiber_request_parks_only_the_fiber) {
+    EchoServer server("inproc://test.request.fiber");
+    ZmqRequestClient client;
+    CHECK(client.start());
+
+    FiberSchedulerDescriptor sd;
+    sd.carrier_count = 1;                       // carrier 가 막히면 두 번째 fiber 는 실행될 수 없음
+    FiberScheduler sched(sd);
+    CHECK(sched.start());
+
+    Result<std::string> reply;
+    FiberTask<void> requester(sched);
+    CHECK(requester.init());
+    TaskDescriptor<void> rd;
+    rd.name = "requester";
+    rd.func = [&]() {
+        reply = client.request(server.endpoint, "wait", 2000);
+        return OK();
+    };
+    CHECK(requester.execute(rd));
+
+    // 요청이 server 에 도착한 뒤(첫 fiber 가 응답 대기 중) 같은 carrier 에서 응답을 풀어주는 fiber 실행
+    CHECK(waitFor(server.received_wait, 2000));
+    FiberTask<void> releaser(sched);
+    CHECK(releaser.init());
+    TaskDescriptor<void> ld;
+    ld.name = "releaser";
+    ld.func = [&]() { server.release = true; return OK(); };
+    CHECK(releaser.execute(ld));
+
+    CHECK(requester.join());
+    CHECK(releaser.join());
+    CHECK(reply && reply.value() == "released");
+
+    sched.stop();
+    client.stop();
+}
+
+int main() { return test::runAll(); }
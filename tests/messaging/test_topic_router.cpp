@@ -0,0 +1,89 @@
+// test_topic_router.cpp
+// TopicRouter - exact / '*' / '#' 매칭, remove, pattern 검증, literal prefix
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "topic_router.hpp"
+#include "test_util.hpp"
+
+namespace {
+
+std::vector<int> matchAll(const TopicRouter<int>& router, std::string_view topic) {
+    std::vector<int> out;
+    router.match(topic, [&](const int& v) { out.push_back(v); });
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+} // namespace
+
+TEST_CASE(exact_and_wildcards) {
+    TopicRouter<int> router;
+    router.add("event.sample.completed", 1);
+    router.add("event.*.completed", 2);
+    router.add("event.#", 3);
+    router.add("#", 4);
+    router.add("event.*", 5);
+
+    CHECK(matchAll(router, "event.sample.completed") == (std::vector<int>{1, 2, 3, 4}));
+    CHECK(matchAll(router, "event.other.completed") == (std::vector<int>{2, 3, 4}));
+    CHECK(matchAll(router, "event.sample") == (std::vector<int>{3, 4, 5}));
+    CHECK(matchAll(router, "event") == (std::vector<int>{3, 4}));        // '#' 는 0 개 segment 도 일치
+    CHECK(matchAll(router, "event.a.b.completed") == (std::vector<int>{3, 4}));   // '*' 는 segment 하나
+    CHECK(matchAll(router, "state.x") == (std::vector<int>{4}));
+    CHECK(matchAll(router, "eventx.sample") == (std::vector<int>{4}));    // prefix 가 아니라 segment 단위
+}
+
+TEST_CASE(duplicate_and_remove) {
+    TopicRouter<int> router;
+    router.add("a.b", 1);
+    router.add("a.b", 2);
+    router.add("a.*", 3);
+    CHECK_EQ(router.match("a.b", [](const int&) { }), 3u);
+
+    CHECK_EQ(router.remove("a.b", [](const int& v) { return v == 1; }), 1u);
+    CHECK(matchAll(router, "a.b") == (std::vector<int>{2, 3}));
+
+    CHECK_EQ(router.removeAll("a.*"), 1u);
+    CHECK_EQ(router.removeAll("a.*"), 0u);
+    CHECK(matchAll(router, "a.c").empty());
+
+    CHECK_EQ(router.removeAll("a.b"), 1u);
+    CHECK(router.snapshot()->empty());
+}
+
+TEST_CASE(snapshot_survives_update) {
+    TopicRouter<int> router;
+    router.add("x.y", 1);
+
+    // match 중 add / remove 는 이번 match 에 영향 없음
+    size_t n = router.match("x.y", [&](const int&) {
+        router.add("x.*", 2);
+        router.removeAll("x.y");
+    });
+    CHECK_EQ(n, 1u);
+    CHECK(matchAll(router, "x.y") == (std::vector<int>{2}));
+}
+
+TEST_CASE(validate_patterns) {
+    CHECK(topic::validate("a.b.c"));
+    CHECK(topic::validate("a.*.c"));
+    CHECK(topic::validate("a.#"));
+    CHECK(topic::validate("#"));
+    CHECK(!topic::validate("a.#.c"));       // '#' 는 마지막만
+    CHECK(!topic::validate("a.b*"));        // wildcard 는 segment 전체
+    CHECK(!topic::validate("a.#x"));
+}
+
+TEST_CASE(literal_prefix) {
+    CHECK(topic::literalPrefix("event.*.completed") == "event.");
+    CHECK(topic::literalPrefix("event.sample.#") == "event.sample");
+    CHECK(topic::literalPrefix("#") == "");
+    CHECK(topic::literalPrefix("a.b") == "a.b");
+    CHECK(topic::hasWildcard("a.*"));
+    CHECK(!topic::hasWildcard("a.b"));
+}
+
+int main() { return test::runAll(); }
@@ -0,0 +1,152 @@
+// test_wire_format.cpp
+// binary wire format - varint / zigzag, WireWriter -> WireReader, message_helper round trip, 잘린 입력
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "wire_format.hpp"
+#include "message_helper.hpp"
+#include "test_util.hpp"
+
+TEST_CASE(varint_round_trip) {
+    const std::vector<uint64_t> values = {0, 1, 127, 128, 300, 16383, 16384, (1ull << 32) + 5,
+                                          std::numeric_limits<uint64_t>::max()};
+    std::string out;
+    for (auto v : values) wire::putVarint(out, v);
+    CHECK(out.size() > values.size());
+
+    auto* p   = reinterpret_cast<const uint8_t*>(out.data());
+    auto* end = p + out.size();
+    for (auto v : values) {
+        uint64_t got = 0;
+        CHECK(wire::getVarint(p, end, got));
+        CHECK_EQ(got, v);
+    }
+    CHECK(p == end);
+
+    // 끝이 잘린 varint
+    std::string cut;
+    wire::putVarint(cut, 1ull << 40);
+    cut.pop_back();
+    p   = reinterpret_cast<const uint8_t*>(cut.data());
+    end = p + cut.size();
+    uint64_t v = 0;
+    CHECK(!wire::getVarint(p, end, v));
+}
+
+TEST_CASE(zigzag_round_trip) {
+    for (int64_t v : {int64_t(0), int64_t(-1), int64_t(1), int64_t(-64), int64_t(63),
+                      std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()}) {
+        CHECK_EQ(wire::zigzagDecode(wire::zigzagEncode(v)), v);
+    }
+    // 작은 음수는 작은 varint
+    CHECK_EQ(wire::zigzagEncode(-1), 1u);
+    CHECK_EQ(wire::zigzagEncode(1), 2u);
+}
+
+TEST_CASE(writer_reader_all_types) {
+    CHECK(wire::FieldTable::instance().add(901, "test.known"));
+
+    std::string buf;
+    {
+        wire::WireWriter w(buf, 6);
+        w.putInt("test.known", -42);
+        w.putDouble("d", 3.25);
+        w.putBool("t", true);
+        w.putBool("f", false);
+        w.putString("s", "hello");
+        const uint8_t raw[] = {0, 1, 2, 255};
+        w.putBytes("b", raw, sizeof(raw));
+    }
+    CHECK(wire::WireReader::isBinary(buf));
+
+    wire::WireReader r(buf);
+    CHECK_EQ(r.count(), 6u);
+    wire::WireField f;
+
+    CHECK(r.next(f));
+    CHECK_EQ(f.id, 901u);                   // 등록된 key 는 id 로 기록
+    CHECK(f.name == "test.known");
+    CHECK(f.type == wire::WireType::Int && f.i == -42);
+
+    CHECK(r.next(f));
+    CHECK(f.id == 0 && f.name == "d");      // 등록되지 않은 key 는 이름으로 기록
+    CHECK(f.type == wire::WireType::Double && f.d == 3.25);
+
+    CHECK(r.next(f));
+    CHECK(f.type == wire::WireType::True && f.boolean());
+    CHECK(r.next(f));
+    CHECK(f.type == wire::WireType::False && !f.boolean());
+
+    CHECK(r.next(f));
+    CHECK(f.type == wire::WireType::String && f.bytes == "hello");
+
+    CHECK(r.next(f));
+    CHECK(f.type == wire::WireType::Bytes && f.bytes.size() == 4 && uint8_t(f.bytes[3]) == 255);
+
+    CHECK(!r.next(f));
+    CHECK(r.ok());
+}
+
+TEST_CASE(reader_rejects_malformed) {
+    std::string buf;
+    {
+        wire::WireWriter w(buf, 1);
+        w.putString("s", "0123456789");
+    }
+
+    // 모든 길이로 잘라도 crash 없이 오류
+    for (size_t n = 0; n < buf.size(); ++n) {
+        wire::WireReader r(std::string_view(buf.data(), n));
+        wire::WireField f;
+        while (r.next(f)) { }
+        CHECK(!r.ok());
+    }
+
+    std::string bad_version = buf;
+    bad_version[1] = char(wire::VERSION + 1);
+    CHECK(!wire::WireReader(bad_version).ok());
+
+    // 등록되지 않은 field id
+    std::string unknown;
+    unknown.push_back(char(wire::MAGIC));
+    unknown.push_back(char(wire::VERSION));
+    wire::putVarint(unknown, 1);
+    wire::putVarint(unknown, (uint64_t(wire::FieldTable::MAX_ID) << 3) | uint8_t(wire::WireType::Int));
+    wire::putVarint(unknown, 0);
+    wire::WireReader r(unknown);
+    wire::WireField f;
+    CHECK(!r.next(f));
+    CHECK(!r.ok());
+}
+
+TEST_CASE(message_binary_round_trip) {
+    message::Message m;
+    m.topic = "test.wire";
+    m.set("op", 7);
+    m.set("name", "sample");
+    m.set("ratio", 0.5);
+    m.set("on", true);
+
+    std::string payload = message::serialize(m, message::Codec::Binary);
+    auto out = message::deserialize("test.wire", payload);
+    CHECK(out.topic == "test.wire");
+    CHECK_EQ(out.size(), 4u);
+    CHECK_EQ(out.getOr<int>("op", 0), 7);
+    CHECK(out.getOr<std::string>("name", "") == "sample");
+    CHECK_EQ(out.getOr<double>("ratio", 0.0), 0.5);
+    CHECK_EQ(out.getOr<bool>("on", false), true);
+
+    // 잘린 payload 는 예외
+    bool threw = false;
+    try {
+        message::deserialize("test.wire", std::string_view(payload.data(), payload.size() - 1));
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+int main() { return test::runAll(); }
@@ -0,0 +1,137 @@
+// test_channel.cpp
+// SpscChannel / MpscChannel - 순서, 용량, close, blocking send / receive
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "channel.hpp"
+#include "test_util.hpp"
+
+using namespace task;
+
+TEST_CASE(spsc_fifo_and_capacity) {
+    SpscChannel<int> ch(5);
+    CHECK_EQ(ch.capacity(), 8u);            // 2 의 거듭제곱으로 올림
+
+    for (int i = 0; i < 8; ++i) CHECK(ch.trySend(i));
+    CHECK(ch.full());
+    CHECK(!ch.trySend(99));
+
+    int v = -1;
+    for (int i = 0; i < 8; ++i) {
+        CHECK(ch.tryReceive(v));
+        CHECK_EQ(v, i);
+    }
+    CHECK(ch.empty());
+    CHECK(!ch.tryReceive(v));
+}
+
+TEST_CASE(spsc_move_only_and_destroy) {
+    auto alive = std::make_shared<int>(0);
+    {
+        SpscChannel<std::shared_ptr<int>> ch(4);
+        CHECK(ch.trySend(alive));
+        CHECK(ch.trySend(alive));
+        CHECK_EQ(alive.use_count(), 3);
+    }
+    // 남아 있던 항목은 channel 소멸 시 해제
+    CHECK_EQ(alive.use_count(), 1);
+
+    SpscChannel<std::unique_ptr<std::string>> ch(2);
+    CHECK(ch.trySend(std::make_unique<std::string>("a")));
+    std::unique_ptr<std::string> out;
+    CHECK(ch.tryReceive(out));
+    CHECK(out && *out == "a");
+}
+
+TEST_CASE(spsc_threaded_order) {
+    constexpr int N = 200000;
+    SpscChannel<int> ch(64);
+    std::thread producer([&] {
+        for (int i = 0; i < N; ++i) ch.send(i);
+    });
+
+    int expected = 0;
+    bool ordered = true;
+    int v = 0;
+    while (expected < N) {
+        if (!ch.receive(v)) break;
+        if (v != expected) ordered = false;
+        expected++;
+    }
+    producer.join();
+    CHECK(ordered);
+    CHECK_EQ(expected, N);
+}
+
+TEST_CASE(mpsc_all_producers_delivered) {
+    constexpr int P = 4;
+    constexpr int N = 50000;
+    MpscChannel<uint64_t> ch(128);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < P; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < N; ++i) ch.send((uint64_t(p) << 32) | uint32_t(i));
+        });
+    }
+
+    // producer 별로는 보낸 순서 유지
+    std::vector<int64_t> last(P, -1);
+    bool ordered = true;
+    size_t received = 0;
+    std::vector<uint64_t> batch;
+    while (received < size_t(P) * N) {
+        batch.clear();
+        if (ch.drain(batch, 32) == 0) {
+            uint64_t v;
+            if (!ch.receiveFor(v, 1000)) break;
+            batch.push_back(v);
+        }
+        for (auto v : batch) {
+            int p = int(v >> 32);
+            int64_t i = int64_t(v & 0xffffffffu);
+            if (i <= last[p]) ordered = false;
+            last[p] = i;
+            received++;
+        }
+    }
+    for (auto& t : producers) t.join();
+
+    CHECK(ordered);
+    CHECK_EQ(received, size_t(P) * N);
+    for (int p = 0; p < P; ++p) CHECK_EQ(last[p], N - 1);
+}
+
+TEST_CASE(channel_timeout_and_close) {
+    MpscChannel<int> ch(2);
+    CHECK(ch.trySend(1));
+    CHECK(ch.trySend(2));
+
+    auto r = ch.send(3, 20);
+    CHECK(!r && r.code() == ResultCode::Timeout);
+
+    int v = 0;
+    CHECK(ch.tryReceive(v));
+    CHECK(ch.tryReceive(v));
+    auto e = ch.receiveFor(v, 20);
+    CHECK(!e && e.code() == ResultCode::Timeout);
+
+    // close 는 대기 중인 receive 를 깨움
+    std::thread waiter([&] {
+        auto c = ch.receive(v);
+        CHECK(!c && c.code() == ResultCode::Cancelled);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ch.close();
+    waiter.join();
+
+    CHECK(ch.isClosed());
+    auto s = ch.send(4);
+    CHECK(!s && s.code() == ResultCode::Cancelled);
+}
+
+int main() { return test::runAll(); }
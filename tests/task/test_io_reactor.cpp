@@ -0,0 +1,138 @@
+// test_io_reactor.cpp
+// IoReactor epoll backend - 일반 파일 read / write / fsync 는 helper thread 에서, 소켓은 readiness 기반
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "io_reactor.hpp"
+#include "test_util.hpp"
+
+using namespace task;
+
+namespace {
+
+struct TempFile {
+    std::string path = "/tmp/test_io_reactor.XXXXXX";
+    int fd = -1;
+
+    TempFile() { fd = ::mkstemp(&path[0]); }
+    ~TempFile() {
+        if (fd >= 0) ::close(fd);
+        ::unlink(path.c_str());
+    }
+};
+
+std::unique_ptr<IoReactor> startEpoll(unsigned blocking_threads) {
+    IoReactorDescriptor d;
+    d.backend          = IoBackendType::Epoll;
+    d.blocking_threads = blocking_threads;
+    auto reactor = std::make_unique<IoReactor>(d);
+    CHECK(reactor->start());
+    return reactor;
+}
+
+// 완료될 때까지 대기 - 실패 / timeout 이면 -1
+long submitWait(IoReactor& reactor, IoOp op, int fd, void* buf, size_t len, off_t offset) {
+    auto done = std::make_shared<std::promise<long>>();
+    auto f = done->get_future();
+    auto r = reactor.submit({op, fd, buf, len, offset, [done](Result<size_t> res) {
+        done->set_value(res ? static_cast<long>(res.value()) : -1);
+    }});
+    if (!r) return -1;
+    if (f.wait_for(std::chrono::seconds(5)) != std::future_status::ready) return -1;
+    return f.get();
+}
+
+void fileRoundTrip(unsigned blocking_threads) {
+    TempFile file;
+    CHECK(file.fd >= 0);
+    auto reactor = startEpoll(blocking_threads);
+    CHECK(std::string(reactor->backendName()) == "epoll");
+
+    std::string a = "hello ", b = "reactor";
+    CHECK_EQ(submitWait(*reactor, IoOp::Write, file.fd, &b[0], b.size(), 6), long(b.size()));
+    CHECK_EQ(submitWait(*reactor, IoOp::Write, file.fd, &a[0], a.size(), 0), long(a.size()));
+    CHECK_EQ(submitWait(*reactor, IoOp::Fsync, file.fd, nullptr, 0, 0), 0L);
+
+    std::string out(13, '\0');
+    CHECK_EQ(submitWait(*reactor, IoOp::Read, file.fd, &out[0], out.size(), 0), 13L);
+    CHECK(out == "hello reactor");
+    reactor->stop();
+}
+
+} // namespace
+
+TEST_CASE(file_io_on_helper_threads) {
+    fileRoundTrip(2);
+}
+
+TEST_CASE(file_io_on_reactor_thread) {
+    fileRoundTrip(0);
+}
+
+TEST_CASE(current_position_writes_keep_order) {
+    TempFile file;
+    auto reactor = startEpoll(3);
+
+    // offset -1 - 같은 fd 는 같은 helper 에서 제출 순서대로 수행
+    const int N = 64;
+    std::vector<char> digits(N);
+    std::atomic<int> completed{0};
+    for (int i = 0; i < N; ++i) {
+        digits[i] = static_cast<char>('0' + i % 10);
+        reactor->submit({IoOp::Write, file.fd, &digits[i], 1, -1, [&](Result<size_t> r) {
+            if (r) completed++;
+        }});
+    }
+    for (int i = 0; i < 500 && completed.load() < N; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK_EQ(completed.load(), N);
+
+    std::string out(N, '\0');
+    CHECK_EQ(::pread(file.fd, &out[0], N, 0), ssize_t(N));
+    CHECK(out == std::string(digits.begin(), digits.end()));
+    reactor->stop();
+}
+
+TEST_CASE(socket_completes_alongside_file_io) {
+    TempFile file;
+    int sv[2];
+    CHECK(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sv) == 0);
+    auto reactor = startEpoll(2);
+
+    // 소켓 read 대기 중에 파일 write / fsync 가 계속 들어와도 소켓 완료가 전달됨
+    char in[4] = {};
+    auto got = std::make_shared<std::promise<long>>();
+    auto f = got->get_future();
+    CHECK(reactor->submit({IoOp::Read, sv[0], in, sizeof(in), -1, [got](Result<size_t> r) {
+        got->set_value(r ? static_cast<long>(r.value()) : -1);
+    }}));
+
+    std::atomic<int> file_done{0};
+    std::string block(4096, 'f');
+    for (int i = 0; i < 32; ++i) {
+        reactor->submit({IoOp::Write, file.fd, &block[0], block.size(), off_t(i) * 4096, [&](Result<size_t>) { file_done++; }});
+        reactor->submit({IoOp::Fsync, file.fd, nullptr, 0, 0, [&](Result<size_t>) { file_done++; }});
+    }
+    CHECK_EQ(::write(sv[1], "ping", 4), ssize_t(4));
+
+    CHECK(f.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    CHECK_EQ(f.get(), 4L);
+    CHECK(std::string(in, 4) == "ping");
+
+    for (int i = 0; i < 500 && file_done.load() < 64; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK_EQ(file_done.load(), 64);
+
+    reactor->stop();
+    ::close(sv[0]);
+    ::close(sv[1]);
+}
+
+int main() { return test::runAll(); }
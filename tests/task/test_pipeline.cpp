@@ -0,0 +1,100 @@
+// test_pipeline.cpp
+// Pipeline - stage 연결 / 병렬 replica / batch, stop 시 남은 항목 처리, 유휴 상태의 전달 지연
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pipeline.hpp"
+#include "test_util.hpp"
+
+using namespace task;
+
+namespace {
+
+StageDescriptor stage(const std::string& name, size_t parallelism = 1, size_t batch_size = 1) {
+    StageDescriptor d;
+    d.name        = name;
+    d.parallelism = parallelism;
+    d.batch_size  = batch_size;
+    return d;
+}
+
+} // namespace
+
+TEST_CASE(stages_transform_every_item) {
+    std::atomic<long> sum{0};
+    std::atomic<int> count{0};
+
+    PipelineDescriptor pd;
+    pd.name = "sum";
+    auto pipeline = Pipeline<int>::builder(pd)
+        .stage<long>(stage("double", 3), [](int v) { return long(v) * 2; })
+        .stage<std::string>(stage("format", 2, 8), [](long v) { return std::to_string(v); })
+        .sink(stage("collect"), [&](std::string s) {
+            sum += std::stol(s);
+            count++;
+        });
+
+    CHECK(!pipeline->push(1));                  // start 전
+    CHECK(pipeline->start());
+    for (int i = 1; i <= 1000; ++i) CHECK(pipeline->push(i));
+
+    // stop 은 입력을 닫고 남은 항목을 모두 처리한 뒤 반환
+    CHECK(pipeline->stop());
+    CHECK_EQ(count.load(), 1000);
+    CHECK_EQ(sum.load(), 1000L * 1001);
+    CHECK(!pipeline->push(1));
+
+    auto stats = pipeline->stats();
+    CHECK_EQ(stats.size(), 3u);
+    CHECK_EQ(stats[0].parallelism, 3u);
+    CHECK_EQ(stats[0].processed, 1000u);
+    CHECK(stats[1].batches <= stats[1].processed);
+    CHECK_EQ(stats[2].queue_depth, 0u);
+}
+
+TEST_CASE(exceptions_are_counted) {
+    std::atomic<int> delivered{0};
+    auto pipeline = Pipeline<int>::builder({})
+        .stage<int>(stage("odd"), [](int v) {
+            if (v % 2) throw std::runtime_error("odd");
+            return v;
+        })
+        .sink(stage("count"), [&](int) { delivered++; });
+
+    CHECK(pipeline->start());
+    for (int i = 0; i < 10; ++i) pipeline->push(i);
+    pipeline->stop();
+    CHECK_EQ(delivered.load(), 5);
+    CHECK_EQ(pipeline->stats()[0].failed, 5u);
+}
+
+TEST_CASE(idle_stage_wakes_on_push) {
+    using Clock = std::chrono::steady_clock;
+    std::mutex mutex;
+    std::vector<Clock::duration> latency;
+
+    auto pipeline = Pipeline<Clock::time_point>::builder({})
+        .stage<Clock::time_point>(stage("pass"), [](Clock::time_point t) { return t; })
+        .sink(stage("measure"), [&](Clock::time_point t) {
+            std::lock_guard<std::mutex> lock(mutex);
+            latency.push_back(Clock::now() - t);
+        });
+    CHECK(pipeline->start());
+
+    // 입력이 없는 동안 대기한 뒤에도 polling 주기 없이 바로 처리
+    for (int i = 0; i < 5; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        pipeline->push(Clock::now());
+    }
+    pipeline->stop();
+
+    CHECK_EQ(latency.size(), 5u);
+    for (auto& l : latency) CHECK(l < std::chrono::milliseconds(20));
+}
+
+int main() { return test::runAll(); }
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+// NOTE
+// 외부 test framework 없이 실행 파일 하나 = test 묶음 하나 (ctest 가 종료 코드로 판정)
+//
+// TEST_CASE(spsc_fifo) {
+//     CHECK(ch.trySend(1));
+//     CHECK_EQ(v, 1);
+// }
+// int main() { return test::runAll(); }
+
+namespace test {
+
+struct Case {
+    const char* name;
+    std::function<void()> fn;
+};
+
+inline std::vector<Case>& cases() {
+    static std::vector<Case> list;
+    return list;
+}
+
+inline int& failures() {
+    static int n = 0;
+    return n;
+}
+
+struct Register {
+    Register(const char* name, std::function<void()> fn) { cases().push_back({name, std::move(fn)}); }
+};
+
+inline void fail(const char* file, int line, const std::string& what) {
+    std::fprintf(stderr, "  FAIL %s:%d: %s\n", file, line, what.c_str());
+    failures()++;
+}
+
+// return: 실패한 check 수 (0 = 성공)
+inline int runAll() {
+    for (auto& c : cases()) {
+        int before = failures();
+        c.fn();
+        std::printf("[%s] %s\n", failures() == before ? " OK " : "FAIL", c.name);
+    }
+    std::printf("%zu case(s), %d failure(s)\n", cases().size(), failures());
+    return failures() == 0 ? 0 : 1;
+}
+
+} // namespace test
+
+#define TEST_CASE(name)                                                     \
+    static void test_##name();                                              \
+    static test::Register register_##name(#name, &test_##name);             \
+    static void test_##name()
+
+#define CHECK(expr)                                                         \
+    do {                                                                    \
+        if (!(expr)) test::fail(__FILE__, __LINE__, #expr);                 \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                      \
+    do {                                                                    \
+        if (!((a) == (b))) test::fail(__FILE__, __LINE__, #a " == " #b);    \
+    } while (0)
@@ -0,0 +1,263 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+"""
+command manifest (예: sample_command.yaml) 로부터 command / event 별 C++ struct 와
+typed codec (typed_codec.hpp) 기반 encode / decode 코드를 생성
+
+  commands[].args          -> struct <CommandName>
+  commands[].emit          -> struct <...>Event (events 섹션에 args 가 없으면 빈 struct)
+  events[].topic / args    -> event payload 정의 (선택)
+
+  args 타입: string, int, int64, float, bool, bytes
+"""
+
+import argparse
+import re
+import zlib
+from pathlib import Path
+
+import yaml
+
+# manifest 타입 -> (C++ 타입, 고정 영역 크기, 기본값)
+TYPES = {
+    "string": ("std::string_view", 8, ""),
+    "bytes":  ("std::string_view", 8, ""),
+    "int":    ("int32_t", 4, " = 0"),
+    "int64":  ("int64_t", 8, " = 0"),
+    "float":  ("double", 8, " = 0.0"),
+    "bool":   ("bool", 1, " = false"),
+}
+
+
+def to_snake_case(name: str) -> str:
+    s1 = re.sub('(.)([A-Z][a-z]+)', r'\1_\2', name)
+    s2 = re.sub('([a-z0-9])([A-Z])', r'\1_\2', s1)
+    return re.sub(r'[\s\-]+', '_', s2).lower()
+
+
+def to_pascal_case(name: str) -> str:
+    return "".join(p[:1].upper() + p[1:] for p in re.split(r'[._\-\s]+', name) if p)
+
+
+def event_struct_name(topic: str) -> str:
+    parts = topic.split(".")
+    if parts and parts[0] == "event":
+        parts = parts[1:]
+    return to_pascal_case("_".join(parts)) + "Event"
+
+
+def normalize_type(t: str, where: str) -> str:
+    key = str(t).strip().lower()
+    if key not in TYPES:
+        raise SystemExit(f"[ERROR] {where}: unsupported arg type '{t}' (supported: {', '.join(TYPES)})")
+    return key
+
+
+def layout(fields):
+    """고정 영역 offset 계산 - 큰 field 부터 배치 (선언 순서는 struct 멤버에 유지)"""
+    order = sorted(range(len(fields)), key=lambda i: -TYPES[fields[i][1]][1])
+    offsets = {}
+    pos = 0
+    for i in order:
+        name, t = fields[i]
+        offsets[name] = pos
+        pos += TYPES[t][1]
+    return offsets, pos
+
+
+def schema_id(struct_name: str, fields) -> int:
+    sig = struct_name + ":" + ",".join(f"{n}:{t}" for n, t in fields)
+    return zlib.crc32(sig.encode("utf-8")) & 0xFFFFFFFF
+
+
+def gen_struct(struct_name: str, fields, description: str, name_const: str, topic_const: str) -> str:
+    offsets, fixed = layout(fields)
+    sid = schema_id(struct_name, fields)
+    R = f"Result<{struct_name}>"
+    L = []
+
+    L.append("// ------------------------------------------------------")
+    L.append(f"// {struct_name}" + (f" - {description}" if description else ""))
+    L.append("// ------------------------------------------------------")
+    L.append(f"struct {struct_name} {{")
+    if name_const:
+        L.append(f'    static constexpr std::string_view NAME  = "{name_const}";')
+    if topic_const:
+        L.append(f'    static constexpr std::string_view TOPIC = "{topic_const}";')
+    L.append(f"    static constexpr uint32_t SCHEMA_ID = 0x{sid:08x}u;")
+    L.append("")
+
+    for n, t in fields:
+        ctype, _, default = TYPES[t]
+        L.append(f"    {ctype} {n}{default};")
+    if fields:
+        L.append("")
+
+    L.append("    // 고정 영역 offset")
+    for n, t in fields:
+        L.append(f"    static constexpr size_t OFF_{n.upper()} = {offsets[n]};")
+    L.append(f"    static constexpr size_t FIXED_SIZE = {fixed};")
+    L.append("")
+
+    # encode
+    L.append("    void encode(std::string& out) const {")
+    L.append("        typed::Writer w(out, SCHEMA_ID, FIXED_SIZE);")
+    for n, t in fields:
+        off = f"OFF_{n.upper()}"
+        if t in ("string", "bytes"):
+            L.append(f"        w.putString({off}, {n});")
+        elif t == "bool":
+            L.append(f"        w.put<uint8_t>({off}, {n} ? 1 : 0);")
+        else:
+            L.append(f"        w.put<{TYPES[t][0]}>({off}, {n});")
+    if not fields:
+        L.append("        (void)w;")
+    L.append("    }")
+    L.append("")
+
+    # decode
+    L.append("    // string 은 buf 를 그대로 가리킴 (buf 가 살아있는 동안 유효)")
+    L.append(f"    static {R} decode(std::string_view buf) {{")
+    L.append("        typed::Reader r(buf, SCHEMA_ID, FIXED_SIZE);")
+    L.append(f"        if (!r.ok()) return r.fail<{struct_name}>();")
+    L.append(f"        {struct_name} v;")
+    for n, t in fields:
+        off = f"OFF_{n.upper()}"
+        if t in ("string", "bytes"):
+            L.append(f"        if (!r.getString({off}, v.{n})) return r.fail<{struct_name}>();")
+        elif t == "bool":
+            L.append(f"        v.{n} = r.get<uint8_t>({off}) != 0;")
+        else:
+            L.append(f"        v.{n} = r.get<{TYPES[t][0]}>({off});")
+    L.append(f"        return {R}::OK(v);")
+    L.append("    }")
+    L.append("")
+
+    # Message 변환 (기존 Message 경로 호환)
+    L.append("    void toMessage(message::Message& m) const {")
+    for n, t in fields:
+        L.append(f'        static const message::Key k_{n} = message::key("{n}");')
+    for n, t in fields:
+        if t == "bytes":
+            L.append(f"        m.set(k_{n}, message::Bytes{{reinterpret_cast<const uint8_t*>({n}.data()), {n}.size()}});")
+        else:
+            L.append(f"        m.set(k_{n}, {n});")
+    if not fields:
+        L.append("        (void)m;")
+    L.append("    }")
+    L.append("")
+
+    L.append("    // string 은 m 을 그대로 가리킴 (m 이 살아있는 동안 유효)")
+    L.append(f"    static {R} fromMessage(const message::Message& m) {{")
+    L.append(f"        {struct_name} v;")
+    for n, t in fields:
+        if t == "bytes":
+            L.append(f'        auto {n} = m.get<message::Bytes>("{n}");')
+            L.append(f'        if (!{n}) return {R}::Error(ResultCode::InvalidArgument, "Missing or invalid argument: {n}");')
+            L.append(f"        v.{n} = std::string_view(reinterpret_cast<const char*>({n}->data), {n}->size);")
+        else:
+            L.append(f'        auto {n} = m.get<{TYPES[t][0]}>("{n}");')
+            L.append(f'        if (!{n}) return {R}::Error(ResultCode::InvalidArgument, "Missing or invalid argument: {n}");')
+            L.append(f"        v.{n} = *{n};")
+    if not fields:
+        L.append("        (void)m;")
+    L.append(f"        return {R}::OK(v);")
+    L.append("    }")
+    L.append("};")
+    L.append("")
+    return "\n".join(L)
+
+
+def collect(manifest):
+    subsystem = manifest.get("subsystem", "default")
+
+    # events 섹션 (선택) : topic -> args
+    event_args = {}
+    for ev in manifest.get("events", []) or []:
+        topic = ev["topic"]
+        args = ev.get("args") or {}
+        event_args[topic] = [(n, normalize_type(t, topic)) for n, t in args.items()]
+
+    commands = []
+    events = []
+    seen_events = set()
+    for cmd in manifest.get("commands", []) or []:
+        name = cmd["name"]
+        args = cmd.get("args") or {}
+        fields = [(n, normalize_type(t, name)) for n, t in args.items()]
+        commands.append((name, fields, cmd.get("description", "")))
+
+        for topic in cmd.get("emit", []) or []:
+            if topic in seen_events:
+                continue
+            seen_events.add(topic)
+            events.append((topic, event_args.get(topic, [])))
+
+    # emit 에 없는 events 항목도 생성
+    for topic, fields in event_args.items():
+        if topic not in seen_events:
+            seen_events.add(topic)
+            events.append((topic, fields))
+
+    return subsystem, commands, events
+
+
+def generate(manifest, source_name: str, namespace: str) -> str:
+    subsystem, commands, events = collect(manifest)
+    ns = namespace or f"{to_snake_case(subsystem)}::msg"
+
+    out = []
+    out.append("// ------------------------------------------------------")
+    out.append(f"// generated by tools/generator/gen_command_types.py from {source_name}")
+    out.append("// DO NOT EDIT - manifest 를 수정하고 다시 생성")
+    out.append("// ------------------------------------------------------")
+    out.append("#pragma once")
+    out.append("#include <cstddef>")
+    out.append("#include <cstdint>")
+    out.append("#include <string>")
+    out.append("#include <string_view>")
+    out.append("")
+    out.append('#include "result.h"')
+    out.append('#include "message.hpp"')
+    out.append('#include "typed_codec.hpp"')
+    out.append("")
+    out.append(f"namespace {ns} {{")
+    out.append("")
+    out.append("// ========================= commands =========================")
+    out.append("")
+    for name, fields, desc in commands:
+        out.append(gen_struct(name, fields, desc, name, ""))
+    out.append("// ========================= events =========================")
+    out.append("")
+    for topic, fields in events:
+        out.append(gen_struct(event_struct_name(topic), fields, "", "", topic))
+    out.append(f"}} // namespace {ns}")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Generate typed C++ command / event structs from a command manifest.")
+    ap.add_argument("manifest", help="command manifest YAML (e.g., sample_command.yaml)")
+    ap.add_argument("-o", "--outdir", default=".", help="Output directory (default: .)")
+    ap.add_argument("--name", default="", help="Output file name without extension (default: <subsystem>_messages)")
+    ap.add_argument("--namespace", default="", help="C++ namespace (default: <subsystem>::msg)")
+    args = ap.parse_args()
+
+    manifest_path = Path(args.manifest)
+    manifest = yaml.safe_load(manifest_path.read_text(encoding="utf-8")) or {}
+
+    subsystem = manifest.get("subsystem", "default")
+    name = args.name or f"{to_snake_case(subsystem)}_messages"
+
+    code = generate(manifest, manifest_path.name, args.namespace)
+
+    out_path = Path(args.outdir) / f"{name}.hpp"
+    out_path.parent.mkdir(parents=True, exist_ok=True)
+    out_path.write_text(code, encoding="utf-8")
+    print(f"[OK] typed messages written: {out_path.resolve()}")
+
+
+if __name__ == "__main__":
+    main()
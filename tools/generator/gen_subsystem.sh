@@ -31,6 +31,16 @@ ${SCRIPT_PATH}/gen_subsystem_abi.py $subsystem \
   --outdir ${SUBSYSTEM_PATH}
 
 
+# Generating typed command / event structs (manifest 가 있을 때)
+command_manifest="$SUBSYSTEM_PATH/${subsystem_dirname}_command.yaml"
+if [ -f "$command_manifest" ]; then
+  echo "Generating Subsystem($subsystem) typed messages from: $command_manifest"
+
+  ${SCRIPT_PATH}/gen_command_types.py "$command_manifest" \
+    --outdir ${SUBSYSTEM_PATH}
+fi
+
+
 # Generating Service class
 service_class=${subsystem}Service
 
@@ -8,6 +8,7 @@ from pathlib import Path
 
 TEMPLATE = r'''#include "common_type.h"
 #include "subsystem_abi.h"
+#include "zmq_context.hpp"
 #include <string>
 #include <vector>
 #include <new>
@@ -94,6 +95,13 @@ static int {name}_create(const SubsystemParams *params, SubsystemHandle **out)
             obj->manifest_type = params->manifest_type;
         if (params->manifest_path)
             obj->manifest_path = params->manifest_path;
+        // host 와 같은 zmq context 사용 (inproc / Direct 연결)
+        if (params->bus_context &&
+            !ZmqContext::adopt(static_cast<ZmqContext *>(params->bus_context)))
+        {{
+            delete obj;
+            return SUBSYS_ERR;
+        }}
     }}
 
     *out = obj;
@@ -151,8 +159,8 @@ def main():
                     help="Output directory (default: .)")
     ap.add_argument("--version", default="1.0.0", 
                     help="version string (default: 1.0.0)")
-    ap.add_argument("--abi-version", type=int, default=1, 
-                    help="ABI version integer (default: 1)")
+    ap.add_argument("--abi-version", default="SUBSYS_ABI_VERSION", 
+                    help="ABI version (default: SUBSYS_ABI_VERSION from subsystem_abi.h)")
     ap.add_argument("--filename-style", choices=["snake", "pascal"], default="snake", 
                     help="Filename style (default: snake)")
     ap.add_argument("--force", action="store_true", 